@@ -14,6 +14,7 @@
 #define __NANOS6__
 
 
+#include "nanos6/affinity.h"
 #include "nanos6/blocking.h"
 #include "nanos6/cluster.h"
 #include "nanos6/config.h"
@@ -31,6 +32,7 @@
 #include "nanos6/polling.h"
 #include "nanos6/task-info-registration.h"
 #include "nanos6/task-instantiation.h"
+#include "nanos6/taskgraph.h"
 #include "nanos6/taskwait.h"
 #include "nanos6/user-mutex.h"
 #include "nanos6/reductions.h"
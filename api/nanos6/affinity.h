@@ -0,0 +1,85 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef NANOS6_AFFINITY_H
+#define NANOS6_AFFINITY_H
+
+#include <stddef.h>
+
+#include "major.h"
+
+
+#pragma GCC visibility push(default)
+
+
+// NOTE: The full version depends also on nanos6_major_api
+//       That is:   nanos6_major_api . nanos6_affinity_api
+enum nanos6_affinity_api_t { nanos6_affinity_api = 1 };
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+typedef enum {
+	//! The task can run anywhere
+	nanos6_affinity_none = 0,
+	//! The task runs in the CPUs of a NUMA node
+	nanos6_affinity_numa_node,
+	//! The task runs in a CPU
+	nanos6_affinity_cpu,
+	//! The task runs in the CPUs of the NUMA node that holds an address
+	nanos6_affinity_address
+} nanos6_affinity_target_t;
+
+typedef enum {
+	//! The task runs in another place if its target does not run it
+	//! before the scheduler.affinity_spill_time
+	nanos6_affinity_preferred = 0,
+	//! The task only runs in its target
+	nanos6_affinity_strict
+} nanos6_affinity_mode_t;
+
+//! \brief Affinity hint of a task
+typedef struct {
+	//! The kind of target
+	nanos6_affinity_target_t target;
+	//! Whether the task can run in another place
+	nanos6_affinity_mode_t mode;
+	//! The NUMA node or the system CPU identifier, depending on the target
+	size_t index;
+	//! The address whose NUMA node is the target
+	void const *address;
+} nanos6_affinity_t;
+
+
+//! \brief Set the place where a task should run
+//!
+//! This function must be called after nanos6_create_task and before
+//! nanos6_submit_task. Tasks with an affinity hint never become the
+//! immediate successor of another task. The hint is ignored by the
+//! taskfors and the tasks of other devices
+//!
+//! Note that a strict task whose target has no owned and enabled CPU
+//! when the task becomes ready loses its hint, and runs in any CPU
+//!
+//! \param[in] task the task returned by nanos6_create_task
+//! \param[in] affinity the affinity hint, or NULL to remove it
+//!
+//! \returns 1 if the hint has been applied, or 0 if its target is
+//! unknown or not available to the runtime, and thus it has been ignored
+int nanos6_set_task_affinity(void *task, nanos6_affinity_t const *affinity);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#pragma GCC visibility pop
+
+
+#endif /* NANOS6_AFFINITY_H */
@@ -11,6 +11,7 @@
 #include "config.h"
 #endif
 
+#include "affinity.h"
 #include "blocking.h"
 #include "bootstrap.h"
 #include "cluster.h"
@@ -24,6 +25,7 @@
 #include "reductions.h"
 #include "task-info-registration.h"
 #include "task-instantiation.h"
+#include "taskgraph.h"
 #include "taskwait.h"
 #include "user-mutex.h"
 
@@ -42,7 +44,7 @@ enum nanos6_openacc_device_api_t { nanos6_openacc_device_api = 1 };
 
 #pragma GCC visibility push(default)
 
-enum nanos6_api_check_api_t { nanos6_api_check_api = 7 };
+enum nanos6_api_check_api_t { nanos6_api_check_api = 9 };
 
 
 #ifdef __cplusplus
@@ -55,6 +57,7 @@ typedef struct {
 	enum nanos6_api_check_api_t api_check_api_version;
 	enum nanos6_major_api_t major_api_version;
 
+	enum nanos6_affinity_api_t affinity_api_version;
 	enum nanos6_blocking_api_t blocking_api_version;
 	enum nanos6_bootstrap_api_t bootstrap_api_version;
 	enum nanos6_cluster_api_t cluster_api_version;
@@ -73,6 +76,7 @@ typedef struct {
 	enum nanos6_task_execution_api_t task_execution_api_version;
 	enum nanos6_task_info_registration_api_t task_info_registration_api_version;
 	enum nanos6_loop_api_t loop_api_version;
+	enum nanos6_taskgraph_api_t taskgraph_api_version;
 	enum nanos6_taskwait_api_t taskwait_api_version;
 } nanos6_api_versions_t;
 
@@ -67,6 +67,55 @@ void nanos6_runtime_info_get(void *runtimeInfoIterator, nanos6_runtime_info_entr
 int nanos6_snprint_runtime_info_entry_value(char *str, size_t size, nanos6_runtime_info_entry_t const *entry);
 
 
+//! \brief number of buckets of the histogram of tasks served per server turn
+#define NANOS6_SCHEDULER_STATS_HISTOGRAM_SIZE 8
+
+//! \brief statistics of the scheduler accumulated since the runtime started
+typedef struct {
+	//! \brief number of times that a compute place asked the scheduler lock for a task
+	unsigned long lock_requests;
+
+	//! \brief total time spent waiting for the scheduler lock, either to acquire it or to be served, in ns.
+	//! Zero unless scheduler.stats_lock_times is enabled
+	unsigned long lock_wait_time;
+
+	//! \brief number of times that a compute place acquired the scheduler lock to serve tasks
+	unsigned long server_turns;
+
+	//! \brief total time that the scheduler lock has been held by servers, in ns. Zero unless
+	//! scheduler.stats_lock_times is enabled
+	unsigned long lock_hold_time;
+
+	//! \brief number of server turns by number of tasks served in the turn. The first bucket
+	//! counts the turns that served no task, and the bucket i > 0 the turns that served
+	//! between 2^(i-1) and 2^i - 1 tasks. The last bucket also counts the larger turns
+	unsigned long served_tasks_histogram[NANOS6_SCHEDULER_STATS_HISTOGRAM_SIZE];
+
+	//! \brief number of calls that found an add queue full and had to wait for a server to push their tasks
+	unsigned long add_queue_overflows;
+
+	//! \brief number of samples of the ready queue depth, one per server turn
+	unsigned long ready_queue_samples;
+
+	//! \brief sum and maximum of the sampled ready queue depths
+	unsigned long ready_queue_depth_sum;
+	unsigned long ready_queue_depth_max;
+
+	//! \brief number of tasks obtained from the scheduler by compute places
+	unsigned long scheduled_tasks;
+
+	//! \brief number of those tasks that were the immediate successor of the compute place
+	unsigned long immediate_successor_hits;
+} nanos6_scheduler_stats_t;
+
+
+//! \brief obtain the statistics of the scheduler
+//!
+//! The statistics are gathered in per-CPU counters, and this function adds them up.
+//! Thus, the result may not be consistent while the scheduler is being used
+void nanos6_get_scheduler_stats(nanos6_scheduler_stats_t *stats);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,79 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef NANOS6_TASKGRAPH_H
+#define NANOS6_TASKGRAPH_H
+
+#include "major.h"
+
+
+#pragma GCC visibility push(default)
+
+
+// NOTE: The full version depends also on nanos6_major_api
+//       That is:   nanos6_major_api . nanos6_taskgraph_api
+enum nanos6_taskgraph_api_t { nanos6_taskgraph_api = 1 };
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+//! \brief Opaque handle of a task graph
+typedef void *nanos6_taskgraph_t;
+
+
+//! \brief Create an empty task graph
+//!
+//! A task graph records the child tasks that a task creates between
+//! nanos6_taskgraph_begin and nanos6_taskgraph_end, together with their
+//! accesses and the dependencies between them. The following executions
+//! of the same region replay the recorded dependencies instead of
+//! registering the accesses in the dependency system
+//!
+//! \returns the task graph
+nanos6_taskgraph_t nanos6_taskgraph_create(void);
+
+//! \brief Destroy a task graph that is not in use
+void nanos6_taskgraph_destroy(nanos6_taskgraph_t graph);
+
+//! \brief Begin a region of task creation recorded in a task graph
+//!
+//! This call waits for the previous child tasks of the current task. The
+//! first time, the region is recorded while its tasks run as usual. Later,
+//! the tasks are replayed if the graph could be replayed. Each replayed task
+//! must have the same task info, flags, args block size and accesses as the
+//! recorded one in the same position. Otherwise, the region waits for the
+//! replayed tasks and registers the rest of tasks as usual, and the graph is
+//! recorded again in its next execution.
+//!
+//! Graphs are not replayed if their tasks have weak, commutative or
+//! reduction accesses, or are if0 tasks or taskloops. They are not replayed
+//! in cluster mode either. A replayed task that creates child tasks releases
+//! its successors once its children finish, as with a wait clause
+//!
+//! \param[in] graph the task graph
+//!
+//! \returns 1 if the tasks of the region are replayed, or 0 otherwise
+int nanos6_taskgraph_begin(nanos6_taskgraph_t graph);
+
+//! \brief End the region of a task graph
+//!
+//! This call waits for the child tasks of the current task
+//!
+//! \param[in] graph the task graph passed to nanos6_taskgraph_begin
+void nanos6_taskgraph_end(nanos6_taskgraph_t graph);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#pragma GCC visibility pop
+
+
+#endif /* NANOS6_TASKGRAPH_H */
@@ -13,6 +13,7 @@ nanos6_api_versions_t const __user_code_expected_nanos6_api_versions = {
 	.api_check_api_version = nanos6_api_check_api,
 	.major_api_version = nanos6_major_api,
 
+	.affinity_api_version = nanos6_affinity_api,
 	.blocking_api_version = nanos6_blocking_api,
 	.bootstrap_api_version = nanos6_bootstrap_api,
 	.cluster_api_version = nanos6_cluster_api,
@@ -31,6 +32,7 @@ nanos6_api_versions_t const __user_code_expected_nanos6_api_versions = {
 	.task_execution_api_version = nanos6_task_execution_api,
 	.task_info_registration_api_version = nanos6_task_info_registration_api,
 	.loop_api_version = nanos6_loop_api,
+	.taskgraph_api_version = nanos6_taskgraph_api,
 	.taskwait_api_version = nanos6_taskwait_api,
 };
 
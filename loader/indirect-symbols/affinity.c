@@ -0,0 +1,24 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include "resolve.h"
+
+
+#pragma GCC visibility push(default)
+
+int nanos6_set_task_affinity(void *task, nanos6_affinity_t const *affinity)
+{
+	typedef int nanos6_set_task_affinity_t(void *, nanos6_affinity_t const *);
+
+	static nanos6_set_task_affinity_t *symbol = NULL;
+	if (__builtin_expect(symbol == NULL, 0)) {
+		symbol = (nanos6_set_task_affinity_t *) _nanos6_resolve_symbol("nanos6_set_task_affinity", "task affinity", NULL);
+	}
+
+	return (*symbol)(task, affinity);
+}
+
+#pragma GCC visibility pop
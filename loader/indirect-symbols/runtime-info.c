@@ -74,5 +74,18 @@ int nanos6_snprint_runtime_info_entry_value(char *str, size_t size, nanos6_runti
 	return (*symbol)(str, size, entry);
 }
 
+
+void nanos6_get_scheduler_stats(nanos6_scheduler_stats_t *stats)
+{
+	typedef void nanos6_get_scheduler_stats_t(nanos6_scheduler_stats_t *stats);
+
+	static nanos6_get_scheduler_stats_t *symbol = NULL;
+	if (__builtin_expect(symbol == NULL, 0)) {
+		symbol = (nanos6_get_scheduler_stats_t *) _nanos6_resolve_symbol("nanos6_get_scheduler_stats", "runtime info", NULL);
+	}
+
+	(*symbol)(stats);
+}
+
 #pragma GCC visibility pop
 
@@ -0,0 +1,60 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include "resolve.h"
+
+
+#pragma GCC visibility push(default)
+
+nanos6_taskgraph_t nanos6_taskgraph_create(void)
+{
+	typedef nanos6_taskgraph_t nanos6_taskgraph_create_t(void);
+
+	static nanos6_taskgraph_create_t *symbol = NULL;
+	if (__builtin_expect(symbol == NULL, 0)) {
+		symbol = (nanos6_taskgraph_create_t *) _nanos6_resolve_symbol("nanos6_taskgraph_create", "task graph", NULL);
+	}
+
+	return (*symbol)();
+}
+
+void nanos6_taskgraph_destroy(nanos6_taskgraph_t graph)
+{
+	typedef void nanos6_taskgraph_destroy_t(nanos6_taskgraph_t);
+
+	static nanos6_taskgraph_destroy_t *symbol = NULL;
+	if (__builtin_expect(symbol == NULL, 0)) {
+		symbol = (nanos6_taskgraph_destroy_t *) _nanos6_resolve_symbol("nanos6_taskgraph_destroy", "task graph", NULL);
+	}
+
+	(*symbol)(graph);
+}
+
+int nanos6_taskgraph_begin(nanos6_taskgraph_t graph)
+{
+	typedef int nanos6_taskgraph_begin_t(nanos6_taskgraph_t);
+
+	static nanos6_taskgraph_begin_t *symbol = NULL;
+	if (__builtin_expect(symbol == NULL, 0)) {
+		symbol = (nanos6_taskgraph_begin_t *) _nanos6_resolve_symbol("nanos6_taskgraph_begin", "task graph", NULL);
+	}
+
+	return (*symbol)(graph);
+}
+
+void nanos6_taskgraph_end(nanos6_taskgraph_t graph)
+{
+	typedef void nanos6_taskgraph_end_t(nanos6_taskgraph_t);
+
+	static nanos6_taskgraph_end_t *symbol = NULL;
+	if (__builtin_expect(symbol == NULL, 0)) {
+		symbol = (nanos6_taskgraph_end_t *) _nanos6_resolve_symbol("nanos6_taskgraph_end", "task graph", NULL);
+	}
+
+	(*symbol)(graph);
+}
+
+#pragma GCC visibility pop
@@ -0,0 +1,10 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include "resolve.h"
+
+
+RESOLVE_API_FUNCTION(nanos6_set_task_affinity, "task affinity", NULL);
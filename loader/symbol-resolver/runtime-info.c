@@ -12,3 +12,4 @@ RESOLVE_API_FUNCTION(nanos6_runtime_info_end, "runtime info", NULL);
 RESOLVE_API_FUNCTION(nanos6_runtime_info_advance, "runtime info", NULL);
 RESOLVE_API_FUNCTION(nanos6_runtime_info_get, "runtime info", NULL);
 RESOLVE_API_FUNCTION(nanos6_snprint_runtime_info_entry_value, "runtime info", NULL);
+RESOLVE_API_FUNCTION(nanos6_get_scheduler_stats, "runtime info", NULL);
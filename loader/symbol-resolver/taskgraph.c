@@ -0,0 +1,13 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include "resolve.h"
+
+
+RESOLVE_API_FUNCTION(nanos6_taskgraph_create, "task graph", NULL);
+RESOLVE_API_FUNCTION(nanos6_taskgraph_destroy, "task graph", NULL);
+RESOLVE_API_FUNCTION(nanos6_taskgraph_begin, "task graph", NULL);
+RESOLVE_API_FUNCTION(nanos6_taskgraph_end, "task graph", NULL);
@@ -4,7 +4,12 @@
 	Copyright (C) 2018-2020 Barcelona Supercomputing Center (BSC)
 */
 
+#include <algorithm>
+#include <fstream>
+
 #include "ClusterManager.hpp"
+#include "hardware/HardwareInfo.hpp"
+#include "lowlevel/FatalErrorHandler.hpp"
 #include "messages/MessageSysFinish.hpp"
 #include "messenger/Messenger.hpp"
 #include "polling-services/ClusterServicesPolling.hpp"
@@ -13,20 +18,25 @@
 
 #include <RemoteTasksInfoMap.hpp>
 #include <ClusterNode.hpp>
+#include <MemoryAllocator.hpp>
 #include <NodeNamespace.hpp>
 #include "WriteID.hpp"
 
 TaskOffloading::RemoteTasksInfoMap *TaskOffloading::RemoteTasksInfoMap::_singleton = nullptr;
 ClusterManager *ClusterManager::_singleton = nullptr;
 
+const size_t ClusterManager::LOCAL_DISTANCE;
+const size_t ClusterManager::INTRA_HOST_DISTANCE;
+const size_t ClusterManager::INTER_HOST_DISTANCE;
+
 std::atomic<size_t> ClusterServicesPolling::_activeClusterPollingServices;
 std::atomic<size_t> ClusterServicesTask::_activeClusterTaskServices;
 
 ClusterManager::ClusterManager()
 	: _clusterNodes(1),
-	_thisNode(new ClusterNode(0, 0)),
+	_thisNode(new ClusterNode(0, 0, 0)),
 	_masterNode(_thisNode),
-	_msn(nullptr), _callback(nullptr)
+	_msn(nullptr), _distances(1, LOCAL_DISTANCE), _memoryLimit(0), _callback(nullptr)
 {
 	_clusterNodes[0] = _thisNode;
 }
@@ -49,17 +59,27 @@ ClusterManager::ClusterManager(std::string const &commType)
 	_clusterNodes.resize(clusterSize);
 
 	for (size_t i = 0; i < clusterSize; ++i) {
-		_clusterNodes[i] = new ClusterNode(i, i);
+		_clusterNodes[i] = new ClusterNode(i, i, _msn->getHostIndex(i));
 	}
 
 	_thisNode = _clusterNodes[nodeIndex];
 	_masterNode = _clusterNodes[masterIndex];
 
+	initializeDistances();
+
 	_msn->synchronizeAll();
 	_callback.store(nullptr);
 
 	ConfigVariable<bool> inTask("cluster.services_in_task");
 	_taskInPoolins = inTask;
+
+	// Same limit as the Throttle: half of the physical memory by default
+	ConfigVariable<StringifiedMemorySize> maxMemory("throttle.max_memory");
+	_memoryLimit = maxMemory.getValue();
+	if (_memoryLimit == 0) {
+		_memoryLimit = HardwareInfo::getPhysicalMemorySize() / 2;
+	}
+	assert(_memoryLimit > 0);
 }
 
 ClusterManager::~ClusterManager()
@@ -73,6 +93,65 @@ ClusterManager::~ClusterManager()
 	delete _callback;
 }
 
+void ClusterManager::initializeDistances()
+{
+	const size_t clusterSize = _clusterNodes.size();
+	_distances.resize(clusterSize * clusterSize);
+
+	ConfigVariable<std::string> matrixFile("cluster.distance_matrix");
+	std::string const &fileName = matrixFile.getValue();
+
+	if (fileName.empty()) {
+		for (size_t i = 0; i < clusterSize; ++i) {
+			for (size_t j = 0; j < clusterSize; ++j) {
+				size_t distance = INTER_HOST_DISTANCE;
+				if (i == j) {
+					distance = LOCAL_DISTANCE;
+				} else if (_clusterNodes[i]->sharesHostWith(_clusterNodes[j])) {
+					distance = INTRA_HOST_DISTANCE;
+				}
+
+				_distances[i * clusterSize + j] = distance;
+			}
+		}
+	} else {
+		//! The file contains clusterSize rows of clusterSize distances
+		//! separated by whitespace, indexed by the rank of the nodes
+		std::ifstream file(fileName);
+		FatalErrorHandler::failIf(!file.is_open(),
+			"Could not open the cluster distance matrix file ", fileName);
+
+		for (size_t i = 0; i < clusterSize * clusterSize; ++i) {
+			// Read a signed value, since negative entries would wrap around
+			long distance;
+			file >> distance;
+			FatalErrorHandler::failIf(file.fail() || distance < 0,
+				"The cluster distance matrix in ", fileName,
+				" must contain ", clusterSize, "x", clusterSize, " non-negative integers");
+
+			_distances[i] = (size_t) distance;
+		}
+	}
+
+	size_t numHosts = 0;
+	for (ClusterNode *node : _clusterNodes) {
+		numHosts = std::max(numHosts, (size_t) node->getHostIndex() + 1);
+	}
+	RuntimeInfo::addEntry("cluster_hosts", "Number of Cluster Hosts", numHosts);
+}
+
+size_t ClusterManager::getLocalMemoryPressure()
+{
+	assert(_singleton != nullptr);
+
+	if (!MemoryAllocator::hasUsageStatistics() || _singleton->_memoryLimit == 0) {
+		return 0;
+	}
+
+	const size_t memoryUsage = MemoryAllocator::getMemoryUsage();
+	return std::min((memoryUsage * 100) / _singleton->_memoryLimit, (size_t) 100);
+}
+
 // Cluster is initialized before the memory allocator.
 void ClusterManager::initialize()
 {
@@ -7,6 +7,7 @@
 #ifndef CLUSTER_MANAGER_HPP
 #define CLUSTER_MANAGER_HPP
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <string>
@@ -40,6 +41,13 @@ private:
 	//! Messenger object for cluster communication.
 	Messenger * _msn;
 
+	//! Distance between every pair of cluster nodes, stored row-major.
+	//! Lower distances mean cheaper data transfers
+	std::vector<size_t> _distances;
+
+	//! Memory usage that corresponds to a 100% memory pressure
+	size_t _memoryLimit;
+
 	//! The pooling services are in tasks or in pooling
 	bool _taskInPoolins;
 
@@ -58,6 +66,13 @@ private:
 
 	~ClusterManager();
 
+	//! \brief Build the distance matrix of the cluster nodes
+	//!
+	//! By default, the distance between two nodes depends on whether
+	//! they run on the same host. The user can provide the full matrix
+	//! through the file set in the cluster.distance_matrix option
+	void initializeDistances();
+
 public:
 	//! \brief Initialize the ClusterManager
 	//! This is called before initializing the memory allocator because it collects some
@@ -154,6 +169,60 @@ public:
 		return _singleton->_clusterNodes.size();
 	}
 
+	//! Distance from a node to itself
+	static const size_t LOCAL_DISTANCE = 0;
+
+	//! Default distance between two nodes on the same host
+	static const size_t INTRA_HOST_DISTANCE = 1;
+
+	//! Default distance between two nodes on different hosts
+	static const size_t INTER_HOST_DISTANCE = 2;
+
+	//! \brief Get the distance between two cluster nodes
+	//!
+	//! \param[in] from is the index of the first ClusterNode
+	//! \param[in] to is the index of the second ClusterNode
+	//!
+	//! \returns the cost of moving data between the two nodes
+	static inline size_t getDistance(size_t from, size_t to)
+	{
+		const size_t size = _singleton->_clusterNodes.size();
+		assert(from < size);
+		assert(to < size);
+		assert(_singleton->_distances.size() == size * size);
+
+		return _singleton->_distances[from * size + to];
+	}
+
+	//! \brief Get the memory pressure of the current node
+	//!
+	//! The pressure is the memory used by the runtime allocator,
+	//! including nanos6_lmalloc allocations and buffers of the fetched
+	//! data, relative to throttle.max_memory
+	//!
+	//! \returns the memory pressure from 0 to 100%, or 0 if the memory
+	//!		allocator does not provide usage statistics
+	static size_t getLocalMemoryPressure();
+
+	//! \brief Get the memory pressure of the least loaded remote node
+	//!
+	//! This is based on the last memory pressure reported by every remote
+	//! node. When all the remote nodes are under pressure, offloading work
+	//! cannot relieve the current node
+	//!
+	//! \returns the lowest memory pressure of the remote nodes (0-100%)
+	static inline size_t getRemoteMemoryPressure()
+	{
+		size_t pressure = 100;
+		for (ClusterNode *node : _singleton->_clusterNodes) {
+			if (node != _singleton->_thisNode) {
+				pressure = std::min(pressure, node->getMemoryPressure());
+			}
+		}
+
+		return (_singleton->_clusterNodes.size() > 1) ? pressure : 0;
+	}
+
 	//! \brief Check if we run in cluster mode
 	//!
 	//! We run in cluster mode, if we have compiled with cluster support,
@@ -8,15 +8,21 @@
 #include "tasks/Task.hpp"
 
 MessageTaskFinished::MessageTaskFinished(const ClusterNode *from,
-		void *offloadedTaskId)
+		void *offloadedTaskId, size_t memoryPressure, size_t numRemoteTasks)
 	: Message(TASK_FINISHED, sizeof(TaskFinishedMessageContent), from)
 {
 	_content = reinterpret_cast<TaskFinishedMessageContent *>(_deliverable->payload);
 	_content->_offloadedTaskId = offloadedTaskId;
+	_content->_memoryPressure = memoryPressure;
+	_content->_numRemoteTasks = numRemoteTasks;
 }
 
 bool MessageTaskFinished::handleMessage()
 {
+	ClusterNode *remoteNode = ClusterManager::getClusterNode(getSenderId());
+	remoteNode->updateLoad(_content->_memoryPressure, _content->_numRemoteTasks);
+	remoteNode->offloadedTaskFinished();
+
 	Task *task = (Task *)_content->_offloadedTaskId;
 	ExecutionWorkflow::Step *step = task->getExecutionStep();
 	assert(step != nullptr);
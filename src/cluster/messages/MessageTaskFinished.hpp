@@ -16,13 +16,25 @@ class MessageTaskFinished : public Message {
 		//! An opaque id that that will uniquely identifies the
 		//! offloaded task
 		void *_offloadedTaskId;
+
+		//! Memory pressure of the sender node (0-100%), piggy-backed
+		//! so that the offloader avoids saturated nodes
+		size_t _memoryPressure;
+
+		//! Number of offloaded tasks pending on the sender node
+		size_t _numRemoteTasks;
 	};
 	
 	//! pointer to message payload
 	TaskFinishedMessageContent *_content;
 	
 public:
-	MessageTaskFinished(const ClusterNode *from, void *offloadedTaskId);
+	MessageTaskFinished(
+		const ClusterNode *from,
+		void *offloadedTaskId,
+		size_t memoryPressure,
+		size_t numRemoteTasks
+	);
 	
 	MessageTaskFinished(Deliverable *dlv)
 		: Message(dlv)
@@ -35,7 +47,9 @@ public:
 	inline std::string toString() const
 	{
 		std::stringstream ss;
-		ss << "[offloadedTaskId:" << _content->_offloadedTaskId << "]";
+		ss << "[offloadedTaskId:" << _content->_offloadedTaskId
+			<< " memoryPressure:" << _content->_memoryPressure
+			<< " numRemoteTasks:" << _content->_numRemoteTasks << "]";
 		
 		return ss.str();
 	}
@@ -0,0 +1,197 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "DataCompression.hpp"
+
+namespace DataCompression {
+
+	//! Control bytes below this value introduce a literal sequence
+	static const size_t LITERAL_LIMIT = 128;
+
+	//! Shortest repetition that is encoded as a run
+	static const size_t MIN_RUN = 3;
+
+	//! Longest repetition that fits in a single control byte
+	static const size_t MAX_RUN = MIN_RUN + 127;
+
+	static inline void shuffle(
+		unsigned char const *source,
+		size_t size,
+		size_t elementSize,
+		unsigned char *destination
+	) {
+		const size_t numElements = size / elementSize;
+
+		for (size_t byte = 0; byte < elementSize; ++byte) {
+			unsigned char *plane = destination + byte * numElements;
+			for (size_t element = 0; element < numElements; ++element) {
+				plane[element] = source[element * elementSize + byte];
+			}
+		}
+
+		// The trailing bytes that do not form a whole element are kept as is
+		const size_t shuffled = numElements * elementSize;
+		memcpy(destination + shuffled, source + shuffled, size - shuffled);
+	}
+
+	static inline void unshuffle(
+		unsigned char const *source,
+		size_t size,
+		size_t elementSize,
+		unsigned char *destination
+	) {
+		const size_t numElements = size / elementSize;
+
+		for (size_t byte = 0; byte < elementSize; ++byte) {
+			unsigned char const *plane = source + byte * numElements;
+			for (size_t element = 0; element < numElements; ++element) {
+				destination[element * elementSize + byte] = plane[element];
+			}
+		}
+
+		const size_t shuffled = numElements * elementSize;
+		memcpy(destination + shuffled, source + shuffled, size - shuffled);
+	}
+
+	//! \brief Run-length encode a buffer
+	//!
+	//! \returns the number of encoded bytes, or 0 if the encoded buffer
+	//! would not be smaller than the original one
+	static size_t encode(unsigned char const *source, size_t size, unsigned char *destination)
+	{
+		size_t in = 0, out = 0, literalStart = 0;
+
+		auto flushLiterals = [&](size_t end) -> bool {
+			while (literalStart < end) {
+				const size_t count = std::min(end - literalStart, LITERAL_LIMIT);
+				if (out + 1 + count >= size) {
+					return false;
+				}
+
+				destination[out++] = (unsigned char) (count - 1);
+				memcpy(destination + out, source + literalStart, count);
+				out += count;
+				literalStart += count;
+			}
+			return true;
+		};
+
+		while (in < size) {
+			size_t run = 1;
+			while (in + run < size && run < MAX_RUN && source[in + run] == source[in]) {
+				++run;
+			}
+
+			if (run >= MIN_RUN) {
+				if (!flushLiterals(in) || out + 2 >= size) {
+					return 0;
+				}
+
+				destination[out++] = (unsigned char) (LITERAL_LIMIT + run - MIN_RUN);
+				destination[out++] = source[in];
+				literalStart = in + run;
+			}
+			in += run;
+		}
+
+		if (!flushLiterals(size)) {
+			return 0;
+		}
+
+		return out;
+	}
+
+	static void decode(unsigned char const *source, size_t size, unsigned char *destination)
+	{
+		size_t in = 0, out = 0;
+
+		while (out < size) {
+			const size_t control = source[in++];
+			if (control < LITERAL_LIMIT) {
+				const size_t count = control + 1;
+				assert(out + count <= size);
+				memcpy(destination + out, source + in, count);
+				in += count;
+				out += count;
+			} else {
+				const size_t count = control - LITERAL_LIMIT + MIN_RUN;
+				assert(out + count <= size);
+				memset(destination + out, source[in++], count);
+				out += count;
+			}
+		}
+
+		assert(out == size);
+	}
+
+	size_t compressChunk(
+		void const *source,
+		size_t size,
+		size_t elementSize,
+		void *scratch,
+		void *destination
+	) {
+		assert(source != nullptr);
+		assert(destination != nullptr);
+		assert(size > 0);
+
+		ChunkHeader *header = (ChunkHeader *) destination;
+		unsigned char *payload = (unsigned char *) destination + sizeof(ChunkHeader);
+		unsigned char const *input = (unsigned char const *) source;
+
+		if (elementSize > 1) {
+			assert(scratch != nullptr);
+			shuffle(input, size, elementSize, (unsigned char *) scratch);
+			input = (unsigned char const *) scratch;
+		}
+
+		size_t payloadSize = encode(input, size, payload);
+		if (payloadSize == 0) {
+			// Not worth it, send the original data
+			memcpy(payload, source, size);
+			header->_method = STORED_CHUNK;
+			payloadSize = size;
+		} else {
+			header->_method = SHUFFLE_RLE_CHUNK;
+		}
+		header->_payloadSize = (uint32_t) payloadSize;
+
+		return sizeof(ChunkHeader) + payloadSize;
+	}
+
+	void decompressChunk(
+		void const *source,
+		size_t size,
+		size_t elementSize,
+		void *scratch,
+		void *destination
+	) {
+		assert(source != nullptr);
+		assert(destination != nullptr);
+
+		ChunkHeader const *header = (ChunkHeader const *) source;
+		unsigned char const *payload = (unsigned char const *) source + sizeof(ChunkHeader);
+
+		if (header->_method == STORED_CHUNK) {
+			assert(header->_payloadSize == size);
+			memcpy(destination, payload, size);
+			return;
+		}
+
+		assert(header->_method == SHUFFLE_RLE_CHUNK);
+		if (elementSize > 1) {
+			assert(scratch != nullptr);
+			decode(payload, size, (unsigned char *) scratch);
+			unshuffle((unsigned char const *) scratch, size, elementSize, (unsigned char *) destination);
+		} else {
+			decode(payload, size, (unsigned char *) destination);
+		}
+	}
+}
@@ -0,0 +1,78 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef DATA_COMPRESSION_HPP
+#define DATA_COMPRESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+//! \brief Lightweight codec used to compress large cluster data transfers
+//!
+//! Every chunk is first byte-shuffled (the i-th byte of all the elements is
+//! stored contiguously) and then run-length encoded. Numerical arrays tend to
+//! have long runs of equal high-order bytes after shuffling, which makes a
+//! simple RLE pass effective at a very low cost. Chunks that do not shrink
+//! are stored verbatim, so the compressed size of a chunk never exceeds
+//! getChunkBound(size)
+namespace DataCompression {
+
+	enum chunk_method_t : uint32_t {
+		STORED_CHUNK = 0,
+		SHUFFLE_RLE_CHUNK
+	};
+
+	//! Header prepended to every chunk sent through the network
+	struct ChunkHeader {
+		//! The codec used for the payload
+		uint32_t _method;
+
+		//! The number of payload bytes that follow the header
+		uint32_t _payloadSize;
+	};
+
+	//! \brief Maximum number of bytes needed to hold a compressed chunk
+	//!
+	//! \param[in] size is the size of the uncompressed chunk
+	inline size_t getChunkBound(size_t size)
+	{
+		return sizeof(ChunkHeader) + size;
+	}
+
+	//! \brief Compress a chunk of data
+	//!
+	//! \param[in] source is the uncompressed data
+	//! \param[in] size is the size of the uncompressed data
+	//! \param[in] elementSize is the byte width used to shuffle the data
+	//! \param[out] scratch is a buffer of at least size bytes
+	//! \param[out] destination is a buffer of at least getChunkBound(size) bytes
+	//!
+	//! \returns the total number of bytes written to destination
+	size_t compressChunk(
+		void const *source,
+		size_t size,
+		size_t elementSize,
+		void *scratch,
+		void *destination
+	);
+
+	//! \brief Decompress a chunk produced by compressChunk
+	//!
+	//! \param[in] source is the compressed chunk, including its header
+	//! \param[in] size is the size of the uncompressed data
+	//! \param[in] elementSize is the byte width used to shuffle the data
+	//! \param[out] scratch is a buffer of at least size bytes
+	//! \param[out] destination is the buffer where the data is restored
+	void decompressChunk(
+		void const *source,
+		size_t size,
+		size_t elementSize,
+		void *scratch,
+		void *destination
+	);
+}
+
+#endif /* DATA_COMPRESSION_HPP */
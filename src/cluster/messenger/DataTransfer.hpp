@@ -7,7 +7,9 @@
 #ifndef DATA_TRANSFER_HPP
 #define DATA_TRANSFER_HPP
 
+#include <cassert>
 #include <functional>
+#include <vector>
 
 #include "hardware/places/MemoryPlace.hpp"
 
@@ -28,10 +30,18 @@ public:
 
 private:
 	typedef std::function<void ()> data_transfer_callback_t;
+	typedef std::function<void (DataAccessRegion const &)> data_transfer_partial_callback_t;
 
 	//! The callback that we will invoke when the DataTransfer completes
 	std::vector<data_transfer_callback_t> _callbacks;
 
+	//! The callbacks that we will invoke every time a part of the
+	//! DataTransfer completes
+	std::vector<data_transfer_partial_callback_t> _partialCallbacks;
+
+	//! The parts of the region that have already been transferred
+	std::vector<DataAccessRegion> _completedRegions;
+
 	//! Flag indicating DataTransfer completion
 	bool _completed;
 
@@ -45,7 +55,8 @@ public:
 		MemoryPlace const *target,
 		void *messengerData
 	) : _region(region), _source(source), _target(target),
-		_callbacks(), _completed(false), _messengerData(messengerData)
+		_callbacks(), _partialCallbacks(), _completedRegions(),
+		_completed(false), _messengerData(messengerData)
 	{
 	}
 
@@ -76,12 +87,48 @@ public:
 		_callbacks.push_back(callback);
 	}
 
+	//! \brief Add a callback for every part of the DataTransfer that completes
+	//!
+	//! The callback receives the subregion that has been transferred. The
+	//! parts that completed before adding the callback are notified
+	//! immediately, so the callback sees the whole region in any case
+	//!
+	//! \param[in] callback is the partial completion callback
+	inline void addPartialCompletionCallback(data_transfer_partial_callback_t callback)
+	{
+		for (DataAccessRegion const &region : _completedRegions) {
+			callback(region);
+		}
+
+		_partialCallbacks.push_back(callback);
+	}
+
+	//! \brief Mark a part of the DataTransfer as completed
+	//!
+	//! \param[in] region is the subregion that has been transferred
+	inline void markAsPartiallyCompleted(DataAccessRegion const &region)
+	{
+		assert(region.fullyContainedIn(_region));
+		assert(!_completed);
+
+		_completedRegions.push_back(region);
+
+		for (data_transfer_partial_callback_t callback : _partialCallbacks) {
+			callback(region);
+		}
+	}
+
 	//! \brief Mark the DataTransfer as completed
 	//!
 	//! If there is a valid callback assigned to the DataTransfer it will
 	//! be invoked
 	inline void markAsCompleted()
 	{
+		// Transfers that are not split notify the whole region at once
+		if (_completedRegions.empty()) {
+			markAsPartiallyCompleted(_region);
+		}
+
 		for(data_transfer_callback_t callback : _callbacks) {
 			callback();
 		}
@@ -101,6 +101,12 @@ public:
 	//! Returns true if this is the master node
 	virtual bool isMasterNode() const = 0;
 
+	//! \brief Get the index of the physical host of a node
+	//!
+	//! Nodes running on the same host, i.e., that can share memory,
+	//! have the same host index. Host indices are dense and start at 0
+	virtual int getHostIndex(int nodeIndex) const = 0;
+
 	//! \brief Test if sending Messages has completed
 	//!
 	//! This tests whether messages stored in the 'messages'
@@ -0,0 +1,178 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <cstdlib>
+
+#include "InstrumentCluster.hpp"
+#include "MPIChunkedDataTransfer.hpp"
+#include "cluster/messenger/DataCompression.hpp"
+#include "lowlevel/FatalErrorHandler.hpp"
+#include "lowlevel/mpi/MPIErrorHandler.hpp"
+
+MPIChunkedDataTransfer::MPIChunkedDataTransfer(
+	DataAccessRegion const &region,
+	MemoryPlace const *source,
+	MemoryPlace const *target,
+	bool isSend,
+	int peer,
+	int tag,
+	MPI_Comm comm,
+	size_t chunkSize,
+	size_t maxInFlight,
+	size_t elementSize,
+	bool instrument
+) : MPIDataTransfer(region, source, target, nullptr, isSend, peer, instrument),
+	_tag(tag), _comm(comm),
+	_chunkSize(chunkSize),
+	_compress(elementSize > 0),
+	_elementSize(elementSize),
+	_numChunks((region.getSize() + chunkSize - 1) / chunkSize),
+	_nextChunk(0),
+	_completedChunks(0),
+	_requests(std::min(maxInFlight, _numChunks), MPI_REQUEST_NULL),
+	_slotChunks(_requests.size()),
+	_finished(_requests.size()),
+	_buffers(_requests.size(), nullptr),
+	_scratch(nullptr),
+	_wireSize(0),
+	_codecTime(0)
+{
+	assert(chunkSize > 0);
+	assert(maxInFlight > 0);
+	assert(_numChunks > 0);
+
+	if (_compress) {
+		// The staging buffers are reused by all the chunks that go through a slot
+		const size_t bound = DataCompression::getChunkBound(_chunkSize);
+
+		_scratch = (char *) malloc(_chunkSize);
+		FatalErrorHandler::failIf(_scratch == nullptr, "Could not allocate memory for compression buffer");
+
+		for (char *&buffer : _buffers) {
+			buffer = (char *) malloc(bound);
+			FatalErrorHandler::failIf(buffer == nullptr, "Could not allocate memory for compression buffer");
+		}
+	}
+
+	for (size_t slot = 0; slot < _requests.size(); ++slot) {
+		postChunk(slot);
+	}
+}
+
+MPIChunkedDataTransfer::~MPIChunkedDataTransfer()
+{
+	assert(_completedChunks == _numChunks);
+
+	for (char *buffer : _buffers) {
+		free(buffer);
+	}
+
+	free(_scratch);
+}
+
+void MPIChunkedDataTransfer::postChunk(size_t slot)
+{
+	assert(slot < _requests.size());
+	assert(_requests[slot] == MPI_REQUEST_NULL);
+	assert(_nextChunk < _numChunks);
+
+	const size_t chunk = _nextChunk++;
+	const DataAccessRegion chunkRegion = getChunkRegion(chunk);
+	_slotChunks[slot] = chunk;
+
+	void *buffer = chunkRegion.getStartAddress();
+	size_t count = chunkRegion.getSize();
+
+	if (_compress) {
+		buffer = _buffers[slot];
+
+		if (_isSend) {
+			const size_t start = Chrono::now<size_t, std::nano>();
+			count = DataCompression::compressChunk(
+				chunkRegion.getStartAddress(), chunkRegion.getSize(),
+				_elementSize, _scratch, buffer);
+			_codecTime += Chrono::now<size_t, std::nano>() - start;
+
+			_wireSize += count;
+		} else {
+			count = DataCompression::getChunkBound(chunkRegion.getSize());
+		}
+	}
+
+	int ret;
+	if (_isSend) {
+		ret = MPI_Isend(buffer, count, MPI_BYTE, _peer, _tag, _comm, &_requests[slot]);
+	} else {
+		ret = MPI_Irecv(buffer, count, MPI_BYTE, _peer, _tag, _comm, &_requests[slot]);
+	}
+	MPIErrorHandler::handle(ret, _comm);
+}
+
+void MPIChunkedDataTransfer::completeChunk(size_t slot)
+{
+	assert(slot < _requests.size());
+
+	const DataAccessRegion chunkRegion = getChunkRegion(_slotChunks[slot]);
+
+	if (_compress && !_isSend) {
+		DataCompression::ChunkHeader const *header =
+			(DataCompression::ChunkHeader const *) _buffers[slot];
+
+		_wireSize += sizeof(DataCompression::ChunkHeader) + header->_payloadSize;
+
+		const size_t start = Chrono::now<size_t, std::nano>();
+		DataCompression::decompressChunk(
+			_buffers[slot], chunkRegion.getSize(),
+			_elementSize, _scratch, chunkRegion.getStartAddress());
+		_codecTime += Chrono::now<size_t, std::nano>() - start;
+	}
+
+	++_completedChunks;
+	markAsPartiallyCompleted(chunkRegion);
+}
+
+bool MPIChunkedDataTransfer::progress()
+{
+	if (_completedChunks == _numChunks) {
+		return true;
+	}
+
+	int completedCount;
+	int ret = MPI_Testsome(_requests.size(), _requests.data(), &completedCount,
+		_finished.data(), MPI_STATUSES_IGNORE);
+	MPIErrorHandler::handle(ret, _comm);
+
+	if (completedCount == MPI_UNDEFINED || completedCount == 0) {
+		return false;
+	}
+
+	for (int i = 0; i < completedCount; ++i) {
+		const size_t slot = _finished[i];
+
+		completeChunk(slot);
+
+		// Keep the pipeline full with the remaining chunks
+		if (_nextChunk < _numChunks) {
+			postChunk(slot);
+		}
+	}
+
+	assert(_completedChunks <= _numChunks);
+	if (_completedChunks < _numChunks) {
+		return false;
+	}
+
+	markAsCompleted();
+
+	if (_instrument && _compress) {
+		Instrument::clusterDataCompressed(
+			_region.getStartAddress(), _region.getSize(),
+			_wireSize, _codecTime, _peer, _isSend);
+	}
+	instrumentCompletion();
+
+	return true;
+}
@@ -0,0 +1,142 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef MPI_CHUNKED_DATA_TRANSFER_HPP
+#define MPI_CHUNKED_DATA_TRANSFER_HPP
+
+#include <algorithm>
+#include <vector>
+
+#pragma GCC visibility push(default)
+#include <mpi.h>
+#pragma GCC visibility pop
+
+#include "MPIDataTransfer.hpp"
+#include "support/chronometers/std/Chrono.hpp"
+
+//! \brief A DataTransfer that moves a region as a sequence of chunks
+//!
+//! At most a bounded number of chunks are in flight at the same time. Every
+//! time a chunk completes its part of the region is notified as partially
+//! completed and the next chunk is posted in the freed slot, so the transfer
+//! streams through the network and regions larger than what fits in the int
+//! count of MPI can be transferred.
+//!
+//! Optionally, chunks are compressed. In that case, the sender compresses a
+//! chunk right before posting its MPI_Isend, so compressing a chunk overlaps
+//! with the network transfer of the previous ones, and the receiver
+//! decompresses every chunk as soon as it arrives.
+//!
+//! All the chunks use the same tag, so MPI's non-overtaking rule guarantees
+//! that they are matched in order.
+class MPIChunkedDataTransfer : public MPIDataTransfer {
+private:
+	//! Tag shared by all the chunks of the transfer
+	int _tag;
+
+	//! Communicator used for the transfer
+	MPI_Comm _comm;
+
+	//! Size of each chunk, except possibly the last one
+	size_t _chunkSize;
+
+	//! Whether the chunks are compressed
+	bool _compress;
+
+	//! Byte width used to shuffle the data before compressing it
+	size_t _elementSize;
+
+	//! Number of chunks in which the region is split
+	size_t _numChunks;
+
+	//! Index of the next chunk to post
+	size_t _nextChunk;
+
+	//! Number of chunks whose request has already completed
+	size_t _completedChunks;
+
+	//! Pending request of each in-flight slot
+	std::vector<MPI_Request> _requests;
+
+	//! Chunk assigned to each in-flight slot
+	std::vector<size_t> _slotChunks;
+
+	//! Indices of the slots completed by the last test
+	std::vector<int> _finished;
+
+	//! Staging buffer of each slot holding a compressed chunk
+	std::vector<char *> _buffers;
+
+	//! Auxiliary buffer used to shuffle the data of a chunk
+	char *_scratch;
+
+	//! Number of bytes that went through the network
+	size_t _wireSize;
+
+	//! Time spent compressing or decompressing, in nanoseconds, since the
+	//! codec of a small chunk takes less than a microsecond
+	size_t _codecTime;
+
+	inline size_t getChunkOffset(size_t chunk) const
+	{
+		return chunk * _chunkSize;
+	}
+
+	inline size_t getChunkLength(size_t chunk) const
+	{
+		const size_t offset = getChunkOffset(chunk);
+		return std::min(_chunkSize, _region.getSize() - offset);
+	}
+
+	inline DataAccessRegion getChunkRegion(size_t chunk) const
+	{
+		char *address = (char *) _region.getStartAddress() + getChunkOffset(chunk);
+		return DataAccessRegion(address, getChunkLength(chunk));
+	}
+
+	//! Post the next pending chunk in a free slot
+	void postChunk(size_t slot);
+
+	//! Handle a chunk whose request has completed
+	void completeChunk(size_t slot);
+
+public:
+	//! \brief Create the transfer and post the first chunks
+	//!
+	//! \param[in] maxInFlight is the maximum number of chunks in flight
+	//! \param[in] elementSize is the byte width used to shuffle the data
+	//!		before compressing it, or zero to send the chunks uncompressed
+	MPIChunkedDataTransfer(
+		DataAccessRegion const &region,
+		MemoryPlace const *source,
+		MemoryPlace const *target,
+		bool isSend,
+		int peer,
+		int tag,
+		MPI_Comm comm,
+		size_t chunkSize,
+		size_t maxInFlight,
+		size_t elementSize,
+		bool instrument
+	);
+
+	~MPIChunkedDataTransfer();
+
+	inline bool isChunked() const
+	{
+		return true;
+	}
+
+	//! \brief Check the chunks in flight and handle the completed ones
+	//!
+	//! When the last chunk completes, the transfer is marked as completed
+	//! and its callbacks are invoked.
+	//!
+	//! \returns true if the whole transfer has completed
+	bool progress();
+};
+
+#endif /* MPI_CHUNKED_DATA_TRANSFER_HPP */
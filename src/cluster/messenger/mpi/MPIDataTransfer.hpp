@@ -12,21 +12,61 @@
 #pragma GCC visibility pop
 
 #include "../DataTransfer.hpp"
+#include "InstrumentCluster.hpp"
+#include "support/chronometers/std/Chrono.hpp"
 
 class MPIDataTransfer : public DataTransfer {
+protected:
+	//! True if this node is the sender of the transfer
+	bool _isSend;
+
+	//! Remote rank in the communicator
+	int _peer;
+
+	//! Whether the transfer has to be reported to the instrumentation
+	bool _instrument;
+
+	//! Time elapsed since the transfer was posted
+	Chrono _elapsed;
 
 public:
 	MPIDataTransfer(
 		DataAccessRegion const &region,
 		MemoryPlace const *source,
 		MemoryPlace const *target,
-		MPI_Request *request
-	) : DataTransfer(region, source, target, request)
+		MPI_Request *request,
+		bool isSend,
+		int peer,
+		bool instrument
+	) : DataTransfer(region, source, target, request),
+		_isSend(isSend), _peer(peer), _instrument(instrument), _elapsed()
+	{
+		_elapsed.start();
+	}
+
+	virtual ~MPIDataTransfer()
 	{
 	}
 
-	~MPIDataTransfer()
+	//! \brief Check whether the transfer is split in several MPI requests
+	//!
+	//! Plain transfers keep their single MPI_Request as messenger data
+	virtual bool isChunked() const
 	{
+		return false;
+	}
+
+	//! \brief Report the effective bandwidth of a completed transfer
+	inline void instrumentCompletion()
+	{
+		assert(isCompleted());
+
+		if (_instrument) {
+			_elapsed.stop();
+			Instrument::clusterDataTransferCompleted(
+				_region.getStartAddress(), _region.getSize(),
+				_elapsed.getAccumulated(), _peer, _isSend);
+		}
 	}
 };
 
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "InstrumentCluster.hpp"
+#include "MPIChunkedDataTransfer.hpp"
 #include "MPIDataTransfer.hpp"
 #include "MPIMessenger.hpp"
 #include "cluster/messages/Message.hpp"
@@ -15,6 +16,7 @@
 #include "cluster/polling-services/ClusterServicesTask.hpp"
 #include "lowlevel/FatalErrorHandler.hpp"
 #include "lowlevel/mpi/MPIErrorHandler.hpp"
+#include "support/config/ConfigVariable.hpp"
 
 #include <ClusterManager.hpp>
 #include <ClusterNode.hpp>
@@ -58,6 +60,42 @@ MPIMessenger::MPIMessenger()
 	ret = MPI_Comm_size(INTRA_COMM, &_wsize);
 	MPIErrorHandler::handle(ret, INTRA_COMM);
 	assert(_wsize > 0);
+
+	discoverHosts();
+
+	ConfigVariable<StringifiedMemorySize> transferChunkSize("cluster.transfer.chunk_size");
+	ConfigVariable<size_t> maxInFlightChunks("cluster.transfer.max_inflight_chunks");
+
+	_transferChunkSize = transferChunkSize.getValue();
+	_maxInFlightChunks = maxInFlightChunks.getValue();
+
+	// Every chunk must be addressable with the int count of MPI
+	FatalErrorHandler::failIf(
+		_transferChunkSize == 0 || _transferChunkSize > (1UL << 30),
+		"cluster.transfer.chunk_size must be between 1 byte and 1GB"
+	);
+	FatalErrorHandler::failIf(
+		_maxInFlightChunks == 0,
+		"cluster.transfer.max_inflight_chunks must be greater than zero"
+	);
+
+	ConfigVariable<bool> compressionEnabled("cluster.compression.enabled");
+	ConfigVariable<StringifiedMemorySize> compressionThreshold("cluster.compression.threshold");
+	ConfigVariable<StringifiedMemorySize> compressionChunkSize("cluster.compression.chunk_size");
+	ConfigVariable<size_t> compressionElementSize("cluster.compression.element_size");
+
+	_compressionThreshold = (compressionEnabled.getValue()) ? (size_t) compressionThreshold.getValue() : 0;
+	_compressionChunkSize = compressionChunkSize.getValue();
+	_compressionElementSize = compressionElementSize.getValue();
+
+	FatalErrorHandler::failIf(
+		_compressionChunkSize == 0 || _compressionChunkSize > (1UL << 30),
+		"cluster.compression.chunk_size must be between 1 byte and 1GB"
+	);
+	FatalErrorHandler::failIf(
+		_compressionElementSize == 0,
+		"cluster.compression.element_size must be greater than zero"
+	);
 }
 
 MPIMessenger::~MPIMessenger()
@@ -72,6 +110,43 @@ MPIMessenger::~MPIMessenger()
 	MPIErrorHandler::handle(ret, MPI_COMM_WORLD);
 }
 
+void MPIMessenger::discoverHosts()
+{
+	int ret;
+	MPI_Comm sharedComm;
+
+	//! Group the ranks that can create shared memory, i.e., that run on
+	//! the same host
+	ret = MPI_Comm_split_type(INTRA_COMM, MPI_COMM_TYPE_SHARED, _wrank, MPI_INFO_NULL, &sharedComm);
+	MPIErrorHandler::handle(ret, INTRA_COMM);
+
+	//! The lowest rank of every host identifies it
+	int leader;
+	ret = MPI_Allreduce(&_wrank, &leader, 1, MPI_INT, MPI_MIN, sharedComm);
+	MPIErrorHandler::handle(ret, sharedComm);
+
+	ret = MPI_Comm_free(&sharedComm);
+	MPIErrorHandler::handle(ret, INTRA_COMM);
+
+	std::vector<int> leaders(_wsize);
+	ret = MPI_Allgather(&leader, 1, MPI_INT, leaders.data(), 1, MPI_INT, INTRA_COMM);
+	MPIErrorHandler::handle(ret, INTRA_COMM);
+
+	//! Renumber the hosts densely in order of their leaders. A leader is
+	//! always the first rank of its host, so its host has already been
+	//! numbered when any other rank of the host is visited
+	_hostIndices.resize(_wsize);
+	int numHosts = 0;
+	for (int i = 0; i < _wsize; ++i) {
+		if (leaders[i] == i) {
+			_hostIndices[i] = numHosts++;
+		} else {
+			assert(leaders[i] < i);
+			_hostIndices[i] = _hostIndices[leaders[i]];
+		}
+	}
+}
+
 void MPIMessenger::sendMessage(Message *msg, ClusterNode const *toNode, bool block)
 {
 	int ret;
@@ -111,6 +186,35 @@ void MPIMessenger::sendMessage(Message *msg, ClusterNode const *toNode, bool blo
 	Instrument::clusterMessageCompleteSend(msg);
 }
 
+DataTransfer *MPIMessenger::postChunkedTransfer(
+	const DataAccessRegion &region,
+	MemoryPlace const *source,
+	MemoryPlace const *target,
+	bool isSend,
+	int peer,
+	int tag,
+	bool block,
+	bool instrument
+) {
+	const bool compress = mustCompress(region);
+	const size_t chunkSize = (compress) ? _compressionChunkSize : _transferChunkSize;
+	const size_t elementSize = (compress) ? _compressionElementSize : 0;
+
+	MPIChunkedDataTransfer *dt = new MPIChunkedDataTransfer(region,
+		source, target, isSend, peer, tag, INTRA_COMM,
+		chunkSize, _maxInFlightChunks, elementSize, instrument);
+
+	if (block) {
+		while (!dt->progress()) {
+		}
+		delete dt;
+
+		return nullptr;
+	}
+
+	return dt;
+}
+
 DataTransfer *MPIMessenger::sendData(
 	const DataAccessRegion &region,
 	const ClusterNode *to,
@@ -132,6 +236,11 @@ DataTransfer *MPIMessenger::sendData(
 
 	int tag = (messageId << 8) | DATA_RAW;
 
+	if (mustCompress(region) || mustSplit(region)) {
+		return postChunkedTransfer(region, ClusterManager::getCurrentMemoryNode(),
+			to->getMemoryNode(), /* isSend */ true, mpiDst, tag, block, instrument);
+	}
+
 	if (block) {
 		ret = MPI_Send(address, size, MPI_BYTE, mpiDst, tag, INTRA_COMM);
 		MPIErrorHandler::handle(ret, INTRA_COMM);
@@ -147,7 +256,7 @@ DataTransfer *MPIMessenger::sendData(
 	MPIErrorHandler::handle(ret, INTRA_COMM);
 
 	return new MPIDataTransfer(region, ClusterManager::getCurrentMemoryNode(),
-		to->getMemoryNode(), request);
+		to->getMemoryNode(), request, /* isSend */ true, mpiDst, instrument);
 }
 
 DataTransfer *MPIMessenger::fetchData(
@@ -166,6 +275,17 @@ DataTransfer *MPIMessenger::fetchData(
 
 	int tag = (messageId << 8) | DATA_RAW;
 
+	if (mustCompress(region) || mustSplit(region)) {
+		DataTransfer *dt = postChunkedTransfer(region, from->getMemoryNode(),
+			ClusterManager::getCurrentMemoryNode(), /* isSend */ false, mpiSrc, tag, block, instrument);
+
+		if (block && instrument) {
+			Instrument::clusterDataReceived(address, size, mpiSrc);
+		}
+
+		return dt;
+	}
+
 	if (block) {
 		ret = MPI_Recv(address, size, MPI_BYTE, mpiSrc, tag, INTRA_COMM, MPI_STATUS_IGNORE);
 		MPIErrorHandler::handle(ret, INTRA_COMM);
@@ -185,7 +305,7 @@ DataTransfer *MPIMessenger::fetchData(
 	MPIErrorHandler::handle(ret, INTRA_COMM);
 
 	return new MPIDataTransfer(region, from->getMemoryNode(),
-		ClusterManager::getCurrentMemoryNode(), request);
+		ClusterManager::getCurrentMemoryNode(), request, /* isSend */ false, mpiSrc, instrument);
 }
 
 void MPIMessenger::synchronizeAll(void)
@@ -232,6 +352,35 @@ Message *MPIMessenger::checkMail(void)
 }
 
 
+void MPIMessenger::testCompletion(std::vector<DataTransfer *> &pendings)
+{
+	assert(!pendings.empty());
+
+	std::vector<DataTransfer *> plainTransfers;
+	plainTransfers.reserve(pendings.size());
+
+	for (DataTransfer *dt : pendings) {
+		MPIDataTransfer *mpiTransfer = static_cast<MPIDataTransfer *>(dt);
+		assert(mpiTransfer != nullptr);
+
+		if (mpiTransfer->isChunked()) {
+			static_cast<MPIChunkedDataTransfer *>(mpiTransfer)->progress();
+		} else {
+			plainTransfers.push_back(dt);
+		}
+	}
+
+	if (!plainTransfers.empty()) {
+		testCompletionInternal<DataTransfer>(plainTransfers);
+
+		for (DataTransfer *dt : plainTransfers) {
+			if (dt->isCompleted()) {
+				static_cast<MPIDataTransfer *>(dt)->instrumentCompletion();
+			}
+		}
+	}
+}
+
 template <typename T>
 void MPIMessenger::testCompletionInternal(std::vector<T *> &pendings)
 {
@@ -17,6 +17,7 @@
 #include "../Messenger.hpp"
 
 class ClusterPlace;
+class MemoryPlace;
 class DataTransfer;
 class Message;
 
@@ -26,8 +27,61 @@ private:
 	int _wrank = -1, _wsize = -1;
 	MPI_Comm INTRA_COMM, PARENT_COMM;
 
+	//! Host index of every rank of the intra-communicator
+	std::vector<int> _hostIndices;
+
+	//! Data transfers larger than this size are split in chunks
+	size_t _transferChunkSize;
+
+	//! Maximum number of chunks of a data transfer in flight
+	size_t _maxInFlightChunks;
+
+	//! Data transfers of at least this size are compressed. Zero disables
+	//! the compression of data transfers
+	size_t _compressionThreshold;
+
+	//! Size of the chunks in which compressed transfers are split
+	size_t _compressionChunkSize;
+
+	//! Byte width of the elements shuffled before compressing
+	size_t _compressionElementSize;
+
+	//! \brief Check whether a data transfer of a region has to be compressed
+	//!
+	//! Both sides of a transfer take the same decision, since it only
+	//! depends on the size of the region and the runtime configuration
+	inline bool mustCompress(const DataAccessRegion &region) const
+	{
+		return (_compressionThreshold > 0 && region.getSize() >= _compressionThreshold);
+	}
+
+	//! \brief Check whether a data transfer of a region has to be split in chunks
+	//!
+	//! Splitting also keeps every MPI call below the 2GB limit of its int count
+	inline bool mustSplit(const DataAccessRegion &region) const
+	{
+		return region.getSize() > _transferChunkSize;
+	}
+
+	//! \brief Post a data transfer split in chunks
+	//!
+	//! \returns the DataTransfer object in non-blocking mode, otherwise nullptr
+	DataTransfer *postChunkedTransfer(
+		const DataAccessRegion &region,
+		MemoryPlace const *source,
+		MemoryPlace const *target,
+		bool isSend,
+		int peer,
+		int tag,
+		bool block,
+		bool instrument
+	);
+
 	template<typename T>
 	void testCompletionInternal(std::vector<T *> &pending);
+
+	//! \brief Find out which ranks of the intra-communicator share a host
+	void discoverHosts();
 public:
 	MPIMessenger();
 	~MPIMessenger();
@@ -44,10 +98,7 @@ public:
 		testCompletionInternal<Message>(pending);
 	}
 
-	inline void testCompletion(std::vector<DataTransfer *> &pending)
-	{
-		testCompletionInternal<DataTransfer>(pending);
-	}
+	void testCompletion(std::vector<DataTransfer *> &pending);
 
 	inline int getNodeIndex() const
 	{
@@ -71,6 +122,13 @@ public:
 		assert(_wrank >= 0);
 		return _wrank == 0;
 	}
+
+	inline int getHostIndex(int nodeIndex) const
+	{
+		assert(nodeIndex >= 0 && nodeIndex < _wsize);
+		assert(_hostIndices.size() == (size_t) _wsize);
+		return _hostIndices[nodeIndex];
+	}
 };
 
 //! Register MPIMessenger with the object factory
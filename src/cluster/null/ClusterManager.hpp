@@ -75,6 +75,23 @@ public:
 		return false;
 	}
 
+	static inline size_t getLocalMemoryPressure()
+	{
+		return 0;
+	}
+
+	static inline size_t getRemoteMemoryPressure()
+	{
+		return 0;
+	}
+
+	static inline size_t getDistance(
+		__attribute__((unused)) size_t from,
+		__attribute__((unused)) size_t to
+	) {
+		return 0;
+	}
+
 	static inline Message *checkMail()
 	{
 		return nullptr;
@@ -4,6 +4,7 @@
 	Copyright (C) 2019-2020 Barcelona Supercomputing Center (BSC)
 */
 
+#include <atomic>
 #include <map>
 #include <utility>
 #include <vector>
@@ -30,6 +31,9 @@
 
 namespace TaskOffloading {
 
+	//! Number of offloaded tasks pending on the current node
+	static std::atomic<size_t> _numRemoteTasks(0);
+
 	void propagateSatisfiability(Task *localTask, SatisfiabilityInfo const &satInfo)
 	{
 		assert(localTask != nullptr);
@@ -104,6 +108,9 @@ namespace TaskOffloading {
 			(void *)task
 		);
 
+		// The counter is decreased when the MessageTaskFinished arrives
+		ClusterManager::getClusterNode(remoteNode->getIndex())->offloadedTaskStarted();
+
 		ClusterManager::sendMessage(msg, remoteNode);
 	}
 
@@ -118,9 +125,15 @@ namespace TaskOffloading {
 		clusterPrintf("Sending sendRemoteTaskFinished remote task %p %d\n",
 			offloadedTaskId, offloader->getIndex());
 
-		// The notify back sending message
-		MessageTaskFinished *msg =
-			new MessageTaskFinished(ClusterManager::getCurrentClusterNode(), offloadedTaskId);
+		assert(_numRemoteTasks > 0);
+		const size_t numRemoteTasks = --_numRemoteTasks;
+
+		// The notify back sending message. It also reports the load of
+		// this node to the offloader
+		MessageTaskFinished *msg = new MessageTaskFinished(
+			ClusterManager::getCurrentClusterNode(), offloadedTaskId,
+			ClusterManager::getLocalMemoryPressure(), numRemoteTasks
+		);
 
 		ClusterManager::sendMessage(msg, offloader);
 	}
@@ -256,6 +269,7 @@ namespace TaskOffloading {
 		}
 
 		task->markAsRemote();
+		++_numRemoteTasks;
 
 		ClusterTaskContext *clusterContext = new TaskOffloading::ClusterTaskContext(
 			remoteTaskIdentifier,
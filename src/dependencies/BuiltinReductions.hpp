@@ -0,0 +1,32 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef BUILTIN_REDUCTIONS_HPP
+#define BUILTIN_REDUCTIONS_HPP
+
+#include <cassert>
+
+#include <nanos6/reductions.h>
+
+#include "ReductionSpecific.hpp"
+
+
+//! \brief Check whether a reduction is one of the builtin type and operator
+//! combinations of nanos6/reductions.h, as opposed to a user-defined one
+//!
+//! The builtin reductions are applied element by element, so their storage
+//! can be combined by chunks, and the original storage can be used as one
+//! more private slot, since it is never read by their initializers
+static inline bool isBuiltinReduction(reduction_type_and_operator_index_t typeAndOperatorIndex)
+{
+	assert((typeAndOperatorIndex != 0) && "Unknown reduction type and operator");
+	return (typeAndOperatorIndex >= RED_TYPE_CHAR)
+		&& (typeAndOperatorIndex < NUM_RED_TYPES)
+		&& (typeAndOperatorIndex % 1000 < NUM_RED_OPS);
+}
+
+
+#endif // BUILTIN_REDUCTIONS_HPP
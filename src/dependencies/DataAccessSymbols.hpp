@@ -0,0 +1,189 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef DATA_ACCESS_SYMBOLS_HPP
+#define DATA_ACCESS_SYMBOLS_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+#include <MemoryAllocator.hpp>
+
+
+//! \brief Set of the "symbols" that a data access is related to
+//!
+//! The set takes a single word. Most tasks have a few symbols, so when the
+//! lowest bit of the word is clear, the other bits hold the first
+//! INLINE_SYMBOLS symbols. A task with more symbols moves the set to an
+//! out-of-line bitmap allocated from the memory pools, and the word holds its
+//! address with the lowest bit set. The first word of the bitmap is its number
+//! of words of symbols
+class DataAccessSymbols {
+	typedef uint64_t word_t;
+
+	static const int WORD_BITS = 64;
+	static const int INLINE_SYMBOLS = WORD_BITS - 1;
+	static const word_t OUT_OF_LINE_BIT = 1;
+
+	static_assert(sizeof(word_t *) <= sizeof(word_t), "The bitmap address does not fit in the word");
+
+	word_t _storage;
+
+	inline bool isInline() const
+	{
+		return !(_storage & OUT_OF_LINE_BIT);
+	}
+
+	inline word_t *getBitmap() const
+	{
+		assert(!isInline());
+		return (word_t *) (uintptr_t) (_storage & ~OUT_OF_LINE_BIT);
+	}
+
+	static inline word_t *allocateBitmap(size_t numWords)
+	{
+		word_t *bitmap = (word_t *) MemoryAllocator::alloc((numWords + 1) * sizeof(word_t));
+		assert(bitmap != nullptr);
+		assert(!((uintptr_t) bitmap & OUT_OF_LINE_BIT));
+
+		bitmap[0] = numWords;
+		std::fill(bitmap + 1, bitmap + 1 + numWords, 0);
+		return bitmap;
+	}
+
+	static inline void freeBitmap(word_t *bitmap)
+	{
+		MemoryAllocator::free(bitmap, (bitmap[0] + 1) * sizeof(word_t));
+	}
+
+	//! \brief Move the set to an out-of-line bitmap that can hold a symbol
+	void grow(int symbol)
+	{
+		assert(symbol >= 0);
+
+		const size_t numWords = (size_t) symbol / WORD_BITS + 1;
+		word_t *bitmap = allocateBitmap(numWords);
+
+		if (isInline()) {
+			bitmap[1] = _storage >> 1;
+		} else {
+			word_t *oldBitmap = getBitmap();
+			assert(oldBitmap[0] < numWords);
+
+			std::copy(oldBitmap + 1, oldBitmap + 1 + oldBitmap[0], bitmap + 1);
+			freeBitmap(oldBitmap);
+		}
+
+		_storage = (word_t) (uintptr_t) bitmap | OUT_OF_LINE_BIT;
+	}
+
+	inline size_t getCapacity() const
+	{
+		return isInline() ? INLINE_SYMBOLS : getBitmap()[0] * WORD_BITS;
+	}
+
+public:
+	inline DataAccessSymbols() :
+		_storage(0)
+	{
+	}
+
+	DataAccessSymbols(DataAccessSymbols const &other) :
+		_storage(other._storage)
+	{
+		if (!other.isInline()) {
+			word_t *otherBitmap = other.getBitmap();
+			word_t *bitmap = allocateBitmap(otherBitmap[0]);
+			std::copy(otherBitmap + 1, otherBitmap + 1 + otherBitmap[0], bitmap + 1);
+
+			_storage = (word_t) (uintptr_t) bitmap | OUT_OF_LINE_BIT;
+		}
+	}
+
+	inline DataAccessSymbols(DataAccessSymbols &&other) :
+		_storage(other._storage)
+	{
+		other._storage = 0;
+	}
+
+	inline ~DataAccessSymbols()
+	{
+		if (!isInline()) {
+			freeBitmap(getBitmap());
+		}
+	}
+
+	inline DataAccessSymbols &operator=(DataAccessSymbols other)
+	{
+		std::swap(_storage, other._storage);
+		return *this;
+	}
+
+	inline bool test(int symbol) const
+	{
+		if (symbol < 0 || (size_t) symbol >= getCapacity())
+			return false;
+
+		if (isInline())
+			return (_storage >> (symbol + 1)) & 1;
+
+		return (getBitmap()[1 + symbol / WORD_BITS] >> (symbol % WORD_BITS)) & 1;
+	}
+
+	inline void set(int symbol)
+	{
+		assert(symbol >= 0);
+
+		if ((size_t) symbol >= getCapacity()) {
+			grow(symbol);
+		}
+
+		if (isInline()) {
+			_storage |= ((word_t) 1) << (symbol + 1);
+		} else {
+			getBitmap()[1 + symbol / WORD_BITS] |= ((word_t) 1) << (symbol % WORD_BITS);
+		}
+	}
+
+	inline void reset(int symbol)
+	{
+		if (symbol < 0 || (size_t) symbol >= getCapacity())
+			return;
+
+		if (isInline()) {
+			_storage &= ~(((word_t) 1) << (symbol + 1));
+		} else {
+			getBitmap()[1 + symbol / WORD_BITS] &= ~(((word_t) 1) << (symbol % WORD_BITS));
+		}
+	}
+
+	DataAccessSymbols &operator|=(DataAccessSymbols const &other)
+	{
+		if (other.isInline()) {
+			if (isInline()) {
+				_storage |= other._storage;
+			} else {
+				getBitmap()[1] |= (other._storage >> 1);
+			}
+			return *this;
+		}
+
+		word_t *otherBitmap = other.getBitmap();
+		if (getCapacity() < other.getCapacity()) {
+			grow(other.getCapacity() - 1);
+		}
+
+		word_t *bitmap = getBitmap();
+		for (size_t w = 1; w <= otherBitmap[0]; ++w) {
+			bitmap[w] |= otherBitmap[w];
+		}
+		return *this;
+	}
+};
+
+
+#endif // DATA_ACCESS_SYMBOLS_HPP
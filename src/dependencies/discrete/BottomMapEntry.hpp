@@ -16,6 +16,12 @@ struct BottomMapEntry {
 	DataAccess * _access;
 	ReductionInfo *_reductionInfo;
 
+	BottomMapEntry() :
+		_access(nullptr),
+		_reductionInfo(nullptr)
+	{
+	}
+
 	BottomMapEntry(DataAccess *access) :
 		_access(access),
 		_reductionInfo(nullptr)
@@ -16,6 +16,7 @@
 #include <nanos6/task-instantiation.h>
 
 #include "DataAccessFlags.hpp"
+#include "DataAccessRegion.hpp"
 #include "support/Containers.hpp"
 
 class Task;
@@ -68,6 +69,7 @@ struct CPUDependencyData {
 	typedef SatisfiedOriginatorList satisfied_originator_list_t;
 	typedef Container::deque<Task *> commutative_satisfied_list_t;
 	typedef Container::deque<Task *> deletable_originator_list_t;
+	typedef Container::vector<DataAccessRegion> finished_task_regions_t;
 
 	//! Tasks whose accesses have been satisfied after ending a task
 	satisfied_originator_list_t _satisfiedOriginators[nanos6_device_t::nanos6_device_type_num];
@@ -77,6 +79,11 @@ struct CPUDependencyData {
 	commutative_satisfied_list_t _satisfiedCommutativeOriginators;
 	mailbox_t _mailBox;
 
+	//! Regions accessed by the task that has just finished, used to choose
+	//! the satisfied originator that reuses most of its data as the
+	//! immediate successor
+	finished_task_regions_t _finishedTaskRegions;
+
 #ifndef NDEBUG
 	std::atomic<bool> _inUse;
 #endif
@@ -86,7 +93,8 @@ struct CPUDependencyData {
 		_satisfiedOriginatorCount(0),
 		_deletableOriginators(),
 		_satisfiedCommutativeOriginators(),
-		_mailBox()
+		_mailBox(),
+		_finishedTaskRegions()
 #ifndef NDEBUG
 		, _inUse()
 #endif
@@ -104,7 +112,8 @@ struct CPUDependencyData {
 			if (list.size() > 0)
 				return false;
 
-		return _deletableOriginators.empty() && _mailBox.empty() && _satisfiedCommutativeOriginators.empty();
+		return _deletableOriginators.empty() && _mailBox.empty() && _satisfiedCommutativeOriginators.empty()
+			&& _finishedTaskRegions.empty();
 	}
 
 	inline void addSatisfiedOriginator(Task *task, int deviceType)
@@ -4,62 +4,132 @@
 	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
 */
 
+#include <algorithm>
+#include <cassert>
+
 #include "CommutativeSemaphore.hpp"
 #include "CPUDependencyData.hpp"
 #include "DataAccessRegistration.hpp"
 #include "TaskDataAccesses.hpp"
+#include "scheduling/SchedulerSupport.hpp"
 #include "tasks/Task.hpp"
 
-#include <mutex>
+CommutativeSemaphore::Shard CommutativeSemaphore::_shards[CommutativeSemaphore::max_shards];
+int CommutativeSemaphore::_numShards = CommutativeSemaphore::num_words;
+int CommutativeSemaphore::_shardBits = CommutativeSemaphore::word_bits;
+CommutativeSemaphore::shard_mask_t CommutativeSemaphore::_shardBitsMask = ~((CommutativeSemaphore::shard_mask_t) 0);
+
+void CommutativeSemaphore::initialize(size_t numCPUs)
+{
+	// A shard is at most one word of the mask, and there are at most as many
+	// shards as bits in the set of shards
+	assert(SchedulerSupport::isPowOf2(numCPUs));
+	_numShards = (int) std::max((size_t) num_words, std::min((size_t) max_shards, numCPUs));
+	_shardBits = mask_bits / _numShards;
+	_shardBitsMask = ~((shard_mask_t) 0) >> (word_bits - _shardBits);
 
-CommutativeSemaphore::lock_t CommutativeSemaphore::_lock;
-CommutativeSemaphore::waiting_tasks_t CommutativeSemaphore::_waitingTasks;
-CommutativeSemaphore::commutative_mask_t CommutativeSemaphore::_mask;
+	assert(_shardBits > 0 && _shardBits <= word_bits);
+	assert(word_bits % _shardBits == 0);
+}
 
 bool CommutativeSemaphore::registerTask(Task *task)
 {
 	TaskDataAccesses &accessStruct = task->getDataAccesses();
 	const commutative_mask_t &mask = accessStruct._commutativeMask;
-	assert(mask.any());
+	const shard_set_t shardSet = mask.getShardSet();
+	assert(shardSet != 0);
 
-	std::lock_guard<lock_t> guard(_lock);
-	if (maskIsCompatible(mask)) {
+	lockShards(shardSet);
+
+	const bool compatible = maskIsCompatible(mask);
+	if (compatible) {
 		maskRegister(mask);
-		return true;
+	} else {
+		// Wait in all the shards, since any of them may unblock the task
+		for (int s = 0; s < _numShards; ++s) {
+			if (shardSet & (((shard_set_t) 1) << s))
+				_shards[s]._waitingTasks.push_back(task);
+		}
 	}
 
-	_waitingTasks.emplace_back(std::forward<Task *>(task));
-	return false;
+	unlockShards(shardSet);
+
+	return compatible;
 }
 
 void CommutativeSemaphore::releaseTask(Task *task, CPUDependencyData &hpDependencyData)
 {
 	TaskDataAccesses &accessStruct = task->getDataAccesses();
 	const commutative_mask_t &mask = accessStruct._commutativeMask;
-	assert(mask.any());
+	shard_set_t lockedShards = mask.getShardSet();
+	assert(lockedShards != 0);
+
+	// The bits of the released mask that have been taken again
 	commutative_mask_t released;
+	bool allReleased = false;
 
-	std::lock_guard<lock_t> guard(_lock);
+	lockShards(lockedShards);
 	maskRelease(mask);
 
-	waiting_tasks_t::iterator it = _waitingTasks.begin();
+	while (!allReleased) {
+		shard_set_t neededShards = lockedShards;
 
-	while (it != _waitingTasks.end()) {
-		Task *candidate = *it;
-		TaskDataAccesses &candidateStruct = candidate->getDataAccesses();
-		const commutative_mask_t &candidateMask = candidateStruct._commutativeMask;
+		for (int s = 0; s < _numShards && !allReleased; ++s) {
+			if (!(lockedShards & (((shard_set_t) 1) << s)))
+				continue;
 
-		if (maskIsCompatible(candidateMask)) {
-			maskRegister(candidateMask);
-			hpDependencyData._satisfiedCommutativeOriginators.push_back(candidate);
-			it = _waitingTasks.erase(it);
+			waiting_tasks_t &waitingTasks = _shards[s]._waitingTasks;
+			waiting_tasks_t::iterator it = waitingTasks.begin();
 
-			// Keep track and cut off if we won't be releasing anything else.
-			released |= (mask & candidateMask);
-			if (released == mask)
-				break;
-		} else {
-			++it;
+			while (it != waitingTasks.end()) {
+				Task *candidate = *it;
+				TaskDataAccesses &candidateStruct = candidate->getDataAccesses();
+				const commutative_mask_t &candidateMask = candidateStruct._commutativeMask;
+				const shard_set_t candidateShards = candidateMask.getShardSet();
+
+				if (candidateShards & ~lockedShards) {
+					// The candidate is checked again after locking its shards
+					neededShards |= candidateShards;
+					++it;
+				} else if (maskIsCompatible(candidateMask)) {
+					maskRegister(candidateMask);
+					hpDependencyData._satisfiedCommutativeOriginators.push_back(candidate);
+					it = waitingTasks.erase(it);
+
+					// Remove it from the rest of its shards
+					for (int other = 0; other < _numShards; ++other) {
+						if (other != s && (candidateShards & (((shard_set_t) 1) << other))) {
+							waiting_tasks_t &otherTasks = _shards[other]._waitingTasks;
+							waiting_tasks_t::iterator found = std::find(otherTasks.begin(), otherTasks.end(), candidate);
+							assert(found != otherTasks.end());
+							otherTasks.erase(found);
+						}
+					}
+
+					// Keep track and cut off if we won't be releasing anything else.
+					allReleased = true;
+					for (int w = 0; w < num_words; ++w) {
+						released._words[w] |= (mask._words[w] & candidateMask._words[w]);
+						if (released._words[w] != mask._words[w])
+							allReleased = false;
+					}
+					if (allReleased)
+						break;
+				} else {
+					++it;
+				}
+			}
 		}
+
+		if (allReleased || neededShards == lockedShards)
+			break;
+
+		// Lock the shards of the candidates in order. Their tasks may be
+		// released meanwhile, so the lists are checked again
+		unlockShards(lockedShards);
+		lockedShards = neededShards;
+		lockShards(lockedShards);
 	}
-}
\ No newline at end of file
+
+	unlockShards(lockedShards);
+}
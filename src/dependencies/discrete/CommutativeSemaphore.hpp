@@ -7,7 +7,6 @@
 #ifndef COMMUTATIVE_SEMAPHORE_HPP
 #define COMMUTATIVE_SEMAPHORE_HPP
 
-#include <bitset>
 #include <cstdint>
 
 #include "lowlevel/PaddedTicketSpinLock.hpp"
@@ -17,41 +16,154 @@ class Task;
 class ComputePlace;
 struct CPUDependencyData;
 
+//! \brief Arbitration of the tasks with commutative accesses
+//!
+//! The addresses of the commutative accesses of a task are hashed into a mask
+//! of bits. The mask is split in shards, and each shard has its own lock, its
+//! own taken bits and its own list of waiting tasks, so that the tasks whose
+//! accesses fall in different shards do not contend. A task locks all the
+//! shards of its mask in increasing order, and it waits in the lists of all of
+//! them. When a task is released, it only checks the waiting tasks of its
+//! shards, which are the only ones that its bits may unblock
+//!
+//! The number of shards is chosen at initialization from the number of CPUs,
+//! between one shard per word of the mask and one shard per bit of the set of
+//! shards. The size of the mask does not change, so the more CPUs, the fewer
+//! bits per shard
 class CommutativeSemaphore {
-	static constexpr int commutative_mask_bits = CACHELINE_SIZE * 8;
-
 public:
-	typedef std::bitset<commutative_mask_bits> commutative_mask_t;
+	typedef uint64_t shard_mask_t;
+
+	static constexpr int mask_bits = CACHELINE_SIZE * 8;
+	static constexpr int word_bits = 64;
+	static constexpr int num_words = mask_bits / word_bits;
+
+	//! The set of shards of a mask
+	typedef uint32_t shard_set_t;
+
+	static constexpr int max_shards = sizeof(shard_set_t) * 8;
+
+	static_assert(num_words > 0 && num_words <= max_shards, "Invalid number of commutative mask words");
+	static_assert(mask_bits % max_shards == 0, "Invalid number of commutative shards");
+
+	struct commutative_mask_t {
+		shard_mask_t _words[num_words];
+
+		inline commutative_mask_t()
+		{
+			for (int w = 0; w < num_words; ++w) {
+				_words[w] = 0;
+			}
+		}
+
+		inline bool any() const
+		{
+			for (int w = 0; w < num_words; ++w) {
+				if (_words[w] != 0)
+					return true;
+			}
+			return false;
+		}
+
+		inline void set(size_t bit)
+		{
+			_words[bit / word_bits] |= ((shard_mask_t) 1) << (bit % word_bits);
+		}
+
+		//! \brief Get the bits of a shard, shifted to the lowest ones
+		inline shard_mask_t getShard(int shard) const
+		{
+			const int bit = shard * _shardBits;
+			return (_words[bit / word_bits] >> (bit % word_bits)) & _shardBitsMask;
+		}
+
+		inline shard_set_t getShardSet() const
+		{
+			shard_set_t shardSet = 0;
+			for (int s = 0; s < _numShards; ++s) {
+				if (getShard(s) != 0)
+					shardSet |= ((shard_set_t) 1) << s;
+			}
+			return shardSet;
+		}
+	};
+
+	//! \brief Choose the number of shards from the number of CPUs
+	//!
+	//! \param[in] numCPUs The total number of CPUs
+	static void initialize(size_t numCPUs);
 
 	static bool registerTask(Task *task);
 	static void releaseTask(Task *task, CPUDependencyData &hpDependencyData);
 
 	static inline void combineMaskAndAddress(commutative_mask_t &mask, void *address)
 	{
-		mask.set(addressHash(address) % commutative_mask_bits);
+		mask.set(addressHash(address) % mask_bits);
 	}
 
 private:
 	typedef PaddedTicketSpinLock<> lock_t;
 	typedef Container::deque<Task *> waiting_tasks_t;
 
-	static lock_t _lock;
-	static commutative_mask_t _mask;
-	static waiting_tasks_t _waitingTasks;
+	struct Shard {
+		//! The lock is padded, so the rest of the shard is in another line
+		lock_t _lock;
+		shard_mask_t _mask;
+		waiting_tasks_t _waitingTasks;
+
+		Shard() :
+			_lock(),
+			_mask(0),
+			_waitingTasks()
+		{
+		}
+	};
+
+	static Shard _shards[max_shards];
+
+	//! The number of shards in use, and their size in bits
+	static int _numShards;
+	static int _shardBits;
+	static shard_mask_t _shardBitsMask;
+
+	static inline void lockShards(shard_set_t shardSet)
+	{
+		for (int s = 0; s < _numShards; ++s) {
+			if (shardSet & (((shard_set_t) 1) << s))
+				_shards[s]._lock.lock();
+		}
+	}
+
+	static inline void unlockShards(shard_set_t shardSet)
+	{
+		for (int s = 0; s < _numShards; ++s) {
+			if (shardSet & (((shard_set_t) 1) << s))
+				_shards[s]._lock.unlock();
+		}
+	}
 
-	static inline bool maskIsCompatible(const commutative_mask_t candidate)
+	//! The shards of the masks must be locked in the following functions
+	static inline bool maskIsCompatible(const commutative_mask_t &candidate)
 	{
-		return ((_mask & candidate) == 0);
+		for (int s = 0; s < _numShards; ++s) {
+			if (_shards[s]._mask & candidate.getShard(s))
+				return false;
+		}
+		return true;
 	}
 
-	static inline void maskRegister(const commutative_mask_t mask)
+	static inline void maskRegister(const commutative_mask_t &mask)
 	{
-		_mask |= mask;
+		for (int s = 0; s < _numShards; ++s) {
+			_shards[s]._mask |= mask.getShard(s);
+		}
 	}
 
-	static inline void maskRelease(const commutative_mask_t mask)
+	static inline void maskRelease(const commutative_mask_t &mask)
 	{
-		_mask &= ~mask;
+		for (int s = 0; s < _numShards; ++s) {
+			_shards[s]._mask &= ~mask.getShard(s);
+		}
 	}
 
 	//! Single-qword round of MurmurHash3
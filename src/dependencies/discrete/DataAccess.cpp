@@ -553,6 +553,36 @@ bool DataAccess::apply(DataAccessMessage &message, mailbox_t &mailBox)
 	return calculateDisposing(message.flagsForNext, oldFlags, isReduction);
 }
 
+bool DataAccess::applyWeakRelease(access_flags_t flags, DataAccessMessage &next)
+{
+	assert(flags != ACCESS_NONE);
+
+	DataAccessType type = getType();
+	assert(type != REDUCTION_ACCESS_TYPE);
+
+	access_flags_t oldFlags = _accessFlags.fetch_add(flags, std::memory_order_acq_rel);
+	Instrument::automataMessage(getInstrumentationId(), getInstrumentationId(), flags, oldFlags);
+	// No references to the access from here, as it could be deleted by another thread.
+	assert((oldFlags & flags) == ACCESS_NONE);
+	assert(oldFlags & ACCESS_IS_WEAK);
+	assert(!(oldFlags & ACCESS_HASCHILD));
+
+	// Only the sub-automatas towards the successor can generate messages
+	if (type == READ_ACCESS_TYPE) {
+		next = inAutomata(flags, oldFlags, true, true);
+	} else if (type == CONCURRENT_ACCESS_TYPE) {
+		next = concurrentAutomata(flags, oldFlags, true, true);
+	} else if (type == COMMUTATIVE_ACCESS_TYPE) {
+		next = commutativeAutomata(flags, oldFlags, true, true);
+	} else {
+		outAutomata(flags, oldFlags, next, true);
+	}
+
+	assert(!next.schedule);
+
+	return calculateDisposing(flags, oldFlags);
+}
+
 DataAccessMessage DataAccess::applySingle(access_flags_t flags, mailbox_t &mailBox)
 {
 	assert(mailBox.empty());
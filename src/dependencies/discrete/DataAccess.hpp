@@ -16,6 +16,7 @@
 #include "DataAccessFlags.hpp"
 #include "ReductionInfo.hpp"
 #include "ReductionSpecific.hpp"
+#include "dependencies/DataAccessSymbols.hpp"
 #include "dependencies/DataAccessType.hpp"
 
 #include <InstrumentDataAccessId.hpp>
@@ -29,8 +30,7 @@ class Task;
 //! There might me thousands of allocations of this struct, and size will have a noticeable effect on performance.
 struct DataAccess {
 public:
-	static const size_t MAX_SYMBOLS = 64; // TODO: Temporary solution to use a fixed bitset size
-	typedef std::bitset<MAX_SYMBOLS> symbols_t;
+	typedef DataAccessSymbols symbols_t;
 
 private:
 	//! 16-byte fields
@@ -41,7 +41,7 @@ private:
 	//! The originator of the access
 	Task *_originator;
 
-	//! A bitmap of the "symbols" this access is related to
+	//! The "symbols" this access is related to
 	symbols_t _symbols;
 
 	//! C++ allows anonymous unions to save space when two fields of a struct are not used at once.
@@ -118,6 +118,17 @@ public:
 
 	bool applyPropagated(DataAccessMessage &message);
 
+	//! \brief Apply the unregistration flags of a weak access without children
+	//!
+	//! Such an access can only generate a message for its successor, which is
+	//! returned instead of going through a mailbox
+	//!
+	//! \param[in] flags the unregistration flags
+	//! \param[out] next the message for the successor, if any
+	//!
+	//! \returns whether the access can be disposed
+	bool applyWeakRelease(access_flags_t flags, DataAccessMessage &next);
+
 	inline void setType(DataAccessType type)
 	{
 		_type = type;
@@ -249,7 +260,7 @@ public:
 
 	bool isInSymbol(int symbol) const
 	{
-		return _symbols[symbol];
+		return _symbols.test(symbol);
 	}
 
 	void addToSymbol(int symbol)
@@ -257,7 +268,12 @@ public:
 		_symbols.set(symbol);
 	}
 
-	symbols_t getSymbols() const
+	void addToSymbols(const symbols_t &symbols)
+	{
+		_symbols |= symbols;
+	}
+
+	symbols_t const &getSymbols() const
 	{
 		return _symbols;
 	}
@@ -8,6 +8,7 @@
 #include <config.h>
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <deque>
 #include <mutex>
@@ -25,6 +26,8 @@
 #include "scheduling/Scheduler.hpp"
 #include "TaskDataAccesses.hpp"
 #include "tasks/Task.hpp"
+#include "tasks/TaskGraph.hpp"
+#include "tasks/TasktypeData.hpp"
 
 #include <InstrumentDependenciesByAccessLinks.hpp>
 #include <InstrumentDependencySubsystemEntryPoints.hpp>
@@ -50,12 +53,76 @@ namespace DataAccessRegistration {
 	static inline void decreaseDeletableCountOrDelete(Task *originator,
 		CPUDependencyData::deletable_originator_list_t &deletableOriginators);
 
+	//! \brief Get the number of bytes that a task accesses from the regions of the finished task
+	static inline size_t getReusedBytes(
+		Task *task,
+		CPUDependencyData::finished_task_regions_t const &finishedTaskRegions)
+	{
+		TaskDataAccesses &accessStruct = task->getDataAccesses();
+		assert(!accessStruct.hasBeenDeleted());
+
+		// The task is ready and not running yet, so its accesses do not change
+		size_t reusedBytes = 0;
+		accessStruct.forAll([&](void *, DataAccess *access) -> bool {
+			if (!access->isWeak()) {
+				DataAccessRegion const &region = access->getAccessRegion();
+				for (DataAccessRegion const &finishedRegion : finishedTaskRegions) {
+					reusedBytes += region.intersect(finishedRegion).getSize();
+				}
+			}
+			return true;
+		});
+
+		return reusedBytes;
+	}
+
+	//! \brief Move the satisfied host originator that reuses most of the data
+	//! of the finished task to the end of the list
+	//!
+	//! The scheduler keeps the last sibling that it receives as the immediate
+	//! successor, and the rest of them are queued with the CPU that released
+	//! them as a hint, so they stay in its NUMA node
+	static inline void selectLocalityImmediateSuccessor(CPUDependencyData &hpDependencyData)
+	{
+		CPUDependencyData::satisfied_originator_list_t &list = hpDependencyData.getSatisfiedOriginators(nanos6_host_device);
+		if (list.size() < 2) {
+			return;
+		}
+
+		Task **originators = list.getArray();
+		Task **best = nullptr;
+		size_t bestBytes = 0;
+
+		for (size_t i = 0; i < list.size(); ++i) {
+			assert(originators[i] != nullptr);
+
+			// Taskfors do not become immediate successors
+			if (originators[i]->isTaskfor()) {
+				continue;
+			}
+
+			const size_t reusedBytes = getReusedBytes(originators[i], hpDependencyData._finishedTaskRegions);
+			if (reusedBytes > bestBytes) {
+				bestBytes = reusedBytes;
+				best = &originators[i];
+			}
+		}
+
+		if (best != nullptr) {
+			std::rotate(best, best + 1, originators + list.size());
+		}
+	}
+
 	//! Process all the originators that have become ready
 	static inline void processSatisfiedOriginators(
 		CPUDependencyData &hpDependencyData,
 		ComputePlace *computePlace,
 		bool fromBusyThread)
 	{
+		if (!hpDependencyData._finishedTaskRegions.empty()) {
+			selectLocalityImmediateSuccessor(hpDependencyData);
+		}
+
 		for (int i = 0; i < nanos6_device_t::nanos6_device_type_num; ++i) {
 			ComputePlace *computePlaceHint = nullptr;
 			if (computePlace != nullptr && computePlace->getType() == i)
@@ -148,6 +215,62 @@ namespace DataAccessRegistration {
 			access->setWeak(false);
 	}
 
+	//! \brief Check whether the accesses appended to the array of a task
+	//! have distinct addresses
+	static inline bool appendedAccessesAreDistinct(TaskDataAccesses &accessStruct)
+	{
+		const size_t numAccesses = accessStruct.getRealAccessNumber();
+		assert(numAccesses <= ACCESS_LINEAR_CUTOFF);
+
+		void *addresses[ACCESS_LINEAR_CUTOFF];
+		std::copy(accessStruct._addressArray, accessStruct._addressArray + numAccesses, addresses);
+		std::sort(addresses, addresses + numAccesses);
+
+		return (std::adjacent_find(addresses, addresses + numAccesses) == addresses + numAccesses);
+	}
+
+	//! \brief Merge the appended accesses of a task to the same address, as
+	//! if they had been registered searching the duplicated ones
+	static inline void mergeAppendedAccesses(TaskDataAccesses &accessStruct)
+	{
+		DataAccess *accesses = accessStruct._accessArray;
+		void **addresses = accessStruct._addressArray;
+		const size_t numAccesses = accessStruct.getRealAccessNumber();
+		size_t kept = 0;
+
+		for (size_t i = 0; i < numAccesses; ++i) {
+			DataAccess *access = &accesses[i];
+
+			DataAccess *existing = nullptr;
+			for (size_t j = 0; j < kept; ++j) {
+				if (addresses[j] == addresses[i]) {
+					existing = &accesses[j];
+					break;
+				}
+			}
+
+			if (existing != nullptr) {
+				upgradeAccess(existing, access->getType(), access->isWeak());
+				existing->addToSymbols(access->getSymbols());
+				access->~DataAccess();
+			} else if (kept != i) {
+				// The copy constructor does not copy the reduction indices
+				// nor the symbols, which are set before the insertion
+				DataAccess *moved = new (&accesses[kept]) DataAccess(*access);
+				moved->setReductionOperator(access->getReductionOperator());
+				moved->setReductionIndex(access->getReductionIndex());
+				moved->addToSymbols(access->getSymbols());
+				access->~DataAccess();
+
+				addresses[kept++] = addresses[i];
+			} else {
+				kept++;
+			}
+		}
+
+		accessStruct._currentIndex = kept;
+	}
+
 	void registerTaskDataAccess(
 		Task *task, DataAccessType accessType, bool weak, void *address, size_t length,
 		reduction_type_and_operator_index_t reductionTypeAndOperatorIndex,
@@ -178,7 +301,8 @@ namespace DataAccessRegistration {
 			upgradeAccess(access, accessType, weak);
 		}
 
-		access->addToSymbol(symbolIndex);
+		if (symbolIndex >= 0)
+			access->addToSymbol(symbolIndex);
 
 		// Tuning the number of deps of child taskloops
 		task->increaseMaxChildDependencies();
@@ -242,6 +366,53 @@ namespace DataAccessRegistration {
 		}
 	}
 
+	//! A weak access without children only forwards the satisfiability that it
+	//! receives, so its unregistration generates at most one message, which is
+	//! for its successor. That message is delivered directly, and only the ones
+	//! generated by the successor go through the mailbox
+	static inline void finalizeWeakAccessWithoutChildren(
+		Task *task,
+		DataAccess *access,
+		access_flags_t flagsToSet,
+		CPUDependencyData &hpDependencyData,
+		ComputePlace *computePlace,
+		bool fromBusyThread)
+	{
+		mailbox_t &mailBox = hpDependencyData._mailBox;
+		assert(mailBox.empty());
+
+		DataAccessMessage next;
+		bool dispose = access->applyWeakRelease(flagsToSet, next);
+
+		// The message is applied with the same guards as in propagateMessages
+		if (next.to != nullptr && next.flagsForNext) {
+			assert(!dispose);
+			assert(next.to != access);
+
+			if (next.to->apply(next, mailBox)) {
+				Task *successorTask = next.to->getOriginator();
+				assert(!successorTask->getDataAccesses().hasBeenDeleted());
+				decreaseDeletableCountOrDelete(successorTask, hpDependencyData._deletableOriginators);
+			}
+		}
+
+		if (next.flagsAfterPropagation) {
+			assert(!dispose);
+			dispose = access->applyPropagated(next);
+		}
+
+		if (!mailBox.empty()) {
+			propagateMessages(hpDependencyData, mailBox, nullptr, computePlace, fromBusyThread);
+		}
+
+		// Count the release before the access may be disposed along with its task
+		Instrument::weakAccessFastRelease();
+
+		if (dispose) {
+			decreaseDeletableCountOrDelete(task, hpDependencyData._deletableOriginators);
+		}
+	}
+
 	void finalizeDataAccess(
 		Task *task,
 		DataAccess *access,
@@ -262,6 +433,11 @@ namespace DataAccessRegistration {
 
 		if (childAccess == nullptr) {
 			flagsToSet |= (ACCESS_CHILD_WRITE_DONE | ACCESS_CHILD_READ_DONE | ACCESS_CHILD_CONCURRENT_DONE | ACCESS_CHILD_COMMUTATIVE_DONE);
+
+			if (access->isWeak() && originalAccessType != REDUCTION_ACCESS_TYPE) {
+				finalizeWeakAccessWithoutChildren(task, access, flagsToSet, hpDependencyData, computePlace, fromBusyThread);
+				return;
+			}
 		} else {
 			// Place ourselves as successors of the last access.
 			DataAccess *lastChild = nullptr;
@@ -325,10 +501,33 @@ namespace DataAccessRegistration {
 
 		task->increasePredecessors(2);
 
+		TaskDataAccesses &accessStructures = task->getDataAccesses();
+		TasktypeData *tasktypeData = task->getTasktypeData();
+
+		// The tasks with many accesses append them to their array without
+		// searching the duplicated ones, unless some task of their type had
+		// duplicated accesses. The duplicates are merged afterwards
+		if (tasktypeData != nullptr && accessStructures._accessMap == nullptr
+			&& accessStructures._maxDeps >= ACCESS_APPEND_CUTOFF
+			&& tasktypeData->getAccessShape() != TasktypeData::DUPLICATED_ACCESS_SHAPE
+		) {
+			accessStructures._appendAccesses = true;
+		}
+
 		// This part creates the DataAccesses and inserts it to dependency system
 		task->registerDependencies(/* discrete */ true);
 
-		TaskDataAccesses &accessStructures = task->getDataAccesses();
+		if (accessStructures._appendAccesses) {
+			accessStructures._appendAccesses = false;
+
+			if (appendedAccessesAreDistinct(accessStructures)) {
+				if (tasktypeData->getAccessShape() == TasktypeData::UNKNOWN_ACCESS_SHAPE)
+					tasktypeData->setAccessShape(TasktypeData::DISTINCT_ACCESS_SHAPE);
+			} else {
+				tasktypeData->setAccessShape(TasktypeData::DUPLICATED_ACCESS_SHAPE);
+				mergeAppendedAccesses(accessStructures);
+			}
+		}
 
 		insertAccesses(task, hpDependencyData);
 
@@ -363,6 +562,13 @@ namespace DataAccessRegistration {
 	{
 		assert(task != nullptr);
 
+		// The replayed tasks only release their recorded successors
+		TaskGraph *taskGraph = task->getTaskGraph();
+		if (taskGraph != nullptr && taskGraph->hasReplayedTasks()) {
+			taskGraph->unregisterReplayedTask(task, computePlace, fromBusyThread);
+			return;
+		}
+
 		Instrument::enterUnregisterTaskDataAcesses();
 
 		TaskDataAccesses &accessStruct = task->getDataAccesses();
@@ -376,6 +582,20 @@ namespace DataAccessRegistration {
 		}
 #endif
 
+		// Remember the regions of the task to choose the successor that reuses
+		// most of its data. Only when the successor may run in this CPU
+		const bool keepRegions = Scheduler::isLocalityImmediateSuccessorEnabled()
+			&& !fromBusyThread && computePlace != nullptr
+			&& computePlace->getType() == nanos6_host_device;
+
+		if (keepRegions && accessStruct.hasDataAccesses()) {
+			accessStruct.forAll([&](void *, DataAccess *access) -> bool {
+				if (!access->isWeak())
+					hpDependencyData._finishedTaskRegions.push_back(access->getAccessRegion());
+				return true;
+			});
+		}
+
 		if (accessStruct.hasDataAccesses()) {
 			// Release dependencies of all my accesses
 			accessStruct.forAll([&](void *address, DataAccess *access) -> bool {
@@ -429,6 +649,7 @@ namespace DataAccessRegistration {
 		}
 
 		processSatisfiedOriginators(hpDependencyData, computePlace, fromBusyThread);
+		hpDependencyData._finishedTaskRegions.clear();
 		processDeletableOriginators(hpDependencyData);
 
 #ifndef NDEBUG
@@ -509,9 +730,7 @@ namespace DataAccessRegistration {
 
 			bottom_map_t &addresses = parentAccessStruct._subaccessBottomMap;
 			// Determine our predecessor safely, and maybe insert ourselves to the map.
-			std::pair<bottom_map_t::iterator, bool> result = addresses.emplace(std::piecewise_construct,
-				std::forward_as_tuple(address),
-				std::forward_as_tuple(access));
+			std::pair<bottom_map_t::iterator, bool> result = addresses.emplace(address, access);
 
 			itMap = result.first;
 
@@ -596,6 +815,10 @@ namespace DataAccessRegistration {
 						mailBox);
 				}
 			} else {
+				if (Scheduler::isCriticalPathPriorityEnabled()) {
+					predecessor->getOriginator()->addSuccessorCost(task->getPredictedCost());
+				}
+
 				predecessor->setSuccessor(access);
 				DataAccessMessage message = predecessor->applySingle(ACCESS_HASNEXT, mailBox);
 				fromCurrent = access->applySingle(message.flagsForNext, mailBox);
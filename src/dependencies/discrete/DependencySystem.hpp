@@ -7,7 +7,9 @@
 #ifndef DEPENDENCY_SYSTEM_HPP
 #define DEPENDENCY_SYSTEM_HPP
 
+#include "CommutativeSemaphore.hpp"
 #include "CPUDependencyData.hpp"
+#include "DataAccess.hpp"
 #include "scheduling/SchedulerSupport.hpp"
 #include "system/RuntimeInfo.hpp"
 
@@ -16,10 +18,13 @@ public:
 	static void initialize()
 	{
 		RuntimeInfo::addEntry("dependency_implementation", "Dependency Implementation", "discrete");
+		RuntimeInfo::addEntry("data_access_size", "Data Access Size", sizeof(DataAccess), "bytes");
 
 		size_t pow2CPUs = SchedulerSupport::roundToNextPowOf2(CPUManager::getTotalCPUs());
 		SatisfiedOriginatorList::_actualChunkSize = std::min(SatisfiedOriginatorList::getMaxChunkSize(), pow2CPUs * 2);
 		assert(SchedulerSupport::isPowOf2(SatisfiedOriginatorList::_actualChunkSize));
+
+		CommutativeSemaphore::initialize(pow2CPUs);
 	}
 };
 
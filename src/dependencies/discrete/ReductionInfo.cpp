@@ -13,6 +13,7 @@
 
 #include "DeviceReductionStorage.hpp"
 #include "ReductionInfo.hpp"
+#include "dependencies/BuiltinReductions.hpp"
 #include "devices/HostReductionStorage.hpp"
 #include "executors/threads/WorkerThread.hpp"
 #include "hardware/HardwareInfo.hpp"
@@ -78,7 +79,7 @@ DeviceReductionStorage *ReductionInfo::allocateDeviceStorage(nanos6_device_t dev
 	switch (deviceType) {
 		case nanos6_host_device:
 			storage = new HostReductionStorage(_address, _length, _paddedLength,
-				_initializationFunction, _combinationFunction);
+				_initializationFunction, _combinationFunction, isBuiltinReduction(_typeAndOperatorIndex));
 			break;
 #if USE_CUDA
 		case nanos6_cuda_device:
@@ -15,6 +15,7 @@
 #include "dependencies/DataAccessType.hpp"
 #include "executors/threads/WorkerThread.hpp"
 #include "tasks/Task.hpp"
+#include "tasks/TaskGraph.hpp"
 #include "tasks/TaskImplementation.hpp"
 
 #include <InstrumentDependenciesByAccess.hpp>
@@ -36,6 +37,13 @@ void register_access(void *handler, void *start, size_t length, int symbolIndex,
 	}
 
 	bool weak = (WEAK && !task->isFinal() && !task->isTaskfor()) || task->isTaskloopSource();
+
+	// The accesses of the tasks replayed from a task graph are only checked
+	TaskGraph *taskGraph = task->getTaskGraph();
+	if (taskGraph != nullptr && taskGraph->registerAccess(task, ACCESS_TYPE, weak, start, length)) {
+		return;
+	}
+
 	Instrument::registerTaskAccess(task->getInstrumentationTaskId(), ACCESS_TYPE, weak, start, length);
 
 	DataAccessRegistration::registerTaskDataAccess(task, ACCESS_TYPE, weak, start, length, reductionTypeAndOperatorIndex, reductionIndex, symbolIndex);
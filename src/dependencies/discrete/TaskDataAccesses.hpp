@@ -17,6 +17,7 @@
 #include "TaskDataAccessesInfo.hpp"
 #include "lowlevel/TicketSpinLock.hpp"
 #include "support/Containers.hpp"
+#include "support/FlatPointerMap.hpp"
 
 #include <DependencySystem.hpp>
 #include <MemoryAllocator.hpp>
@@ -24,7 +25,7 @@
 struct DataAccess;
 
 struct TaskDataAccesses {
-	typedef Container::unordered_map<void *, BottomMapEntry> bottom_map_t;
+	typedef FlatPointerMap<BottomMapEntry> bottom_map_t;
 	typedef Container::unordered_map<void *, DataAccess> access_map_t;
 
 #ifndef NDEBUG
@@ -58,15 +59,20 @@ struct TaskDataAccesses {
 	std::atomic<int> _deletableCount;
 	access_map_t *_accessMap;
 
+	//! Whether the accesses are appended to the array without searching
+	//! the duplicated ones
+	bool _appendAccesses;
+
 	TaskDataAccesses() :
 		_subaccessBottomMap(),
 		_accessArray(nullptr),
 		_addressArray(nullptr),
 		_maxDeps(0),
 		_currentIndex(0),
-		_commutativeMask(0),
+		_commutativeMask(),
 		_deletableCount(0),
-		_accessMap(nullptr)
+		_accessMap(nullptr),
+		_appendAccesses(false)
 	{
 	}
 
@@ -77,10 +83,9 @@ struct TaskDataAccesses {
 		_maxDeps(taskAccessInfo.getNumDeps()),
 		_currentIndex(0),
 		_deletableCount(0),
-		_accessMap(nullptr)
+		_accessMap(nullptr),
+		_appendAccesses(false)
 	{
-		// Theoretically, 0.75 is a great load factor to prevent frequent rehashes
-		_subaccessBottomMap.max_load_factor(0.75);
 		if (_maxDeps > ACCESS_LINEAR_CUTOFF) {
 			_accessMap = MemoryAllocator::newObject<access_map_t>();
 			assert(_accessMap != nullptr);
@@ -97,6 +102,12 @@ struct TaskDataAccesses {
 
 		if (_accessMap != nullptr) {
 			MemoryAllocator::deleteObject(_accessMap);
+		} else {
+			// The accesses of the array were constructed in place, and their
+			// symbols may hold memory
+			for (size_t i = 0; i < _currentIndex; ++i) {
+				_accessArray[i].~DataAccess();
+			}
 		}
 
 #ifndef NDEBUG
@@ -163,7 +174,7 @@ struct TaskDataAccesses {
 				_currentIndex++;
 			return &emplaced.first->second;
 		} else {
-			DataAccess *ret = findAccess(address);
+			DataAccess *ret = (_appendAccesses) ? nullptr : findAccess(address);
 			existing = (ret != nullptr);
 			assert(_currentIndex < _maxDeps);
 
@@ -14,6 +14,10 @@
 
 #define ACCESS_LINEAR_CUTOFF 256
 
+// Minimum number of accesses of a task to append them without searching
+// the duplicated ones, which are merged after the registration
+#define ACCESS_APPEND_CUTOFF 16
+
 class TaskDataAccessesInfo {
 private:
 	static constexpr size_t _alignSize = CACHELINE_SIZE - 1;
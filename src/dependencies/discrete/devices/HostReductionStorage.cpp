@@ -4,16 +4,119 @@
 	Copyright (C) 2019-2020 Barcelona Supercomputing Center (BSC)
 */
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 
 #include "HostReductionStorage.hpp"
 #include "MemoryAllocator.hpp"
+#include "executors/threads/CPU.hpp"
+#include "lowlevel/SpinWait.hpp"
+#include "support/Containers.hpp"
+#include "support/MathSupport.hpp"
+#include "system/ompss/SpawnFunction.hpp"
+
+
+constexpr size_t HostReductionStorage::combination_chunk_size;
+
+//! The shared state of a parallel combination. The chunks are claimed from a
+//! counter by the thread that combines the storage and by the helpers. Only
+//! one helper is spawned by the combining thread, and each helper spawns the
+//! next one while there are chunks left, so the release path that combines
+//! the storage does not pay for spawning all of them. The helpers may start
+//! after all the chunks have been claimed, so the state is freed by the last
+//! of them or the combining thread
+struct HostReductionStorage::ParallelCombination {
+	char *_destination;
+	Container::vector<char *> _sources;
+	size_t _length;
+	size_t _numChunks;
+	size_t _maxHelpers;
+	const std::function<void(void *, void *, size_t)> &_combinationFunction;
+
+	std::atomic<size_t> _nextChunk;
+	std::atomic<size_t> _combinedChunks;
+	std::atomic<size_t> _spawnedHelpers;
+	std::atomic<size_t> _references;
+
+	ParallelCombination(char *destination, size_t length, size_t numChunks, size_t maxHelpers,
+		const std::function<void(void *, void *, size_t)> &combinationFunction) :
+		_destination(destination),
+		_sources(),
+		_length(length),
+		_numChunks(numChunks),
+		_maxHelpers(maxHelpers),
+		_combinationFunction(combinationFunction),
+		_nextChunk(0),
+		_combinedChunks(0),
+		_spawnedHelpers(0),
+		_references(1)
+	{
+	}
+
+	//! Spawn another helper if there are chunks left to claim and the limit
+	//! of helpers has not been reached. The caller must hold a reference
+	void spawnHelper()
+	{
+		if (_nextChunk.load(std::memory_order_relaxed) >= _numChunks)
+			return;
+
+		if (_spawnedHelpers.fetch_add(1, std::memory_order_relaxed) >= _maxHelpers)
+			return;
+
+		_references.fetch_add(1, std::memory_order_relaxed);
+		SpawnFunction::spawnFunction(combinationHelperBody, this,
+			nullptr, nullptr, "Reduction combination");
+	}
+
+	//! Combine all the slots into the destination chunk by chunk, so each
+	//! chunk of the destination stays in cache while the slots are folded
+	void combineChunks()
+	{
+		size_t chunk = _nextChunk.fetch_add(1, std::memory_order_relaxed);
+		while (chunk < _numChunks) {
+			const size_t offset = chunk * combination_chunk_size;
+			const size_t length = std::min(combination_chunk_size, _length - offset);
+
+			for (char *source : _sources) {
+				_combinationFunction(_destination + offset, source + offset, length);
+			}
+
+			_combinedChunks.fetch_add(1, std::memory_order_release);
+			chunk = _nextChunk.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	//! Wait for the chunks that other threads have claimed but not combined
+	//! yet. All the chunks must have been claimed
+	void waitChunksInFlight()
+	{
+		assert(_nextChunk.load(std::memory_order_relaxed) >= _numChunks);
+
+		while (_combinedChunks.load(std::memory_order_acquire) < _numChunks) {
+			do {
+				spinWait();
+			} while (_combinedChunks.load(std::memory_order_relaxed) < _numChunks);
+
+			spinWaitRelease();
+		}
+	}
+
+	void unreference()
+	{
+		if (_references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			MemoryAllocator::deleteObject(this);
+		}
+	}
+};
 
 
 HostReductionStorage::HostReductionStorage(void *address, size_t length, size_t paddedLength,
 	std::function<void(void *, void *, size_t)> initializationFunction,
-	std::function<void(void *, void *, size_t)> combinationFunction) :
+	std::function<void(void *, void *, size_t)> combinationFunction,
+	bool divisible) :
 	DeviceReductionStorage(address, length, paddedLength, initializationFunction, combinationFunction),
+	_divisible(divisible),
 	_freeSlotIndices(CPUManager::getTotalCPUs())
 {
 	const long nCpus = CPUManager::getTotalCPUs();
@@ -25,7 +128,7 @@ HostReductionStorage::HostReductionStorage(void *address, size_t length, size_t
 }
 
 void *HostReductionStorage::getFreeSlotStorage(__attribute__((unused)) Task *task, size_t slotIndex,
-	__attribute__((unused)) ComputePlace *destinationComputePlace)
+	ComputePlace *destinationComputePlace)
 {
 	assert(task != nullptr);
 	assert(destinationComputePlace != nullptr);
@@ -35,8 +138,13 @@ void *HostReductionStorage::getFreeSlotStorage(__attribute__((unused)) Task *tas
 	assert(slot.initialized || slot.storage == nullptr);
 
 	if (!slot.initialized) {
-		// Allocate new storage
-		slot.storage = MemoryAllocator::alloc(_paddedLength);
+		// Allocate new storage from the NUMA node of the CPU that initializes
+		// and updates it. The slot is initialized by its first user, so only
+		// the slots that are used cost anything. The storage is freed by the
+		// CPU that combines the reduction, so the node is kept in the slot
+		// to return the storage to the pool it came from
+		slot.numaNodeId = ((CPU *) destinationComputePlace)->getNumaNodeId();
+		slot.storage = MemoryAllocator::allocNUMA(_paddedLength, slot.numaNodeId);
 		_initializationFunction(slot.storage, _address, _length);
 		slot.initialized = true;
 	}
@@ -50,22 +158,75 @@ void HostReductionStorage::combineInStorage(void *combineDestination)
 
 	// Ensure we see writes from other threads that affected the slots
 	std::atomic_thread_fence(std::memory_order_acquire);
+
+	size_t initializedSlots = 0;
 	for (size_t i = 0; i < _slots.size(); ++i) {
-		slot_t &slot = _slots[i];
+		if (_slots[i].initialized) {
+			assert(_slots[i].storage != nullptr);
+			assert(_slots[i].storage != combineDestination);
+			initializedSlots++;
+		}
+	}
 
-		if (slot.initialized) {
-			assert(slot.storage != nullptr);
-			assert(slot.storage != combineDestination);
+	// Spawning the helpers only pays off for storages of several chunks
+	if (_divisible && initializedSlots > 0 && _length >= 2 * combination_chunk_size
+		&& CPUManager::getAvailableCPUs() > 1
+	) {
+		combineInParallel(combineDestination, initializedSlots);
+	} else {
+		for (size_t i = 0; i < _slots.size(); ++i) {
+			if (_slots[i].initialized) {
+				_combinationFunction(combineDestination, _slots[i].storage, _length);
+			}
+		}
+	}
 
-			_combinationFunction(combineDestination, slot.storage, _length);
+	for (size_t i = 0; i < _slots.size(); ++i) {
+		slot_t &slot = _slots[i];
 
-			MemoryAllocator::free(slot.storage, _paddedLength);
+		if (slot.initialized) {
+			MemoryAllocator::freeNUMA(slot.storage, _paddedLength, slot.numaNodeId);
 			slot.storage = nullptr;
 			slot.initialized = false;
 		}
 	}
 }
 
+void HostReductionStorage::combineInParallel(void *combineDestination, size_t initializedSlots)
+{
+	const size_t numChunks = MathSupport::ceil(_length, combination_chunk_size);
+	const size_t maxHelpers = std::min((size_t) CPUManager::getAvailableCPUs(), numChunks) - 1;
+
+	ParallelCombination *combination = MemoryAllocator::newObject<ParallelCombination>(
+		(char *) combineDestination, _length, numChunks, maxHelpers, _combinationFunction);
+	assert(combination != nullptr);
+
+	combination->_sources.reserve(initializedSlots);
+	for (size_t i = 0; i < _slots.size(); ++i) {
+		if (_slots[i].initialized) {
+			combination->_sources.push_back((char *) _slots[i].storage);
+		}
+	}
+
+	// This thread takes chunks from the same counter as the helpers, so it
+	// only waits for the chunks that they have already claimed
+	combination->spawnHelper();
+	combination->combineChunks();
+	combination->waitChunksInFlight();
+
+	combination->unreference();
+}
+
+void HostReductionStorage::combinationHelperBody(void *args)
+{
+	ParallelCombination *combination = (ParallelCombination *) args;
+	assert(combination != nullptr);
+
+	combination->spawnHelper();
+	combination->combineChunks();
+	combination->unreference();
+}
+
 size_t HostReductionStorage::getFreeSlotIndex(__attribute__((unused)) Task *task, ComputePlace *destinationComputePlace)
 {
 	assert(destinationComputePlace->getType() == nanos6_host_device);
@@ -85,9 +246,14 @@ size_t HostReductionStorage::getFreeSlotIndex(__attribute__((unused)) Task *task
 		return currentSlotIndex;
 	}
 
-	int freeSlotIndex = _freeSlotIndices.setFirst();
-	while (freeSlotIndex == -1)
+	// Each CPU takes the slot with its own index when it is free, so that the
+	// slots are reused by the CPUs that allocated and initialized them
+	int freeSlotIndex = cpuId;
+	if (!_freeSlotIndices.trySet(cpuId)) {
 		freeSlotIndex = _freeSlotIndices.setFirst();
+		while (freeSlotIndex == -1)
+			freeSlotIndex = _freeSlotIndices.setFirst();
+	}
 
 	_currentCpuSlotIndices[cpuId] = freeSlotIndex;
 
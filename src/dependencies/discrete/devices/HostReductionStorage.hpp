@@ -15,13 +15,23 @@ public:
 	struct ReductionSlot {
 		void *storage = nullptr;
 		bool initialized = false;
+		//! NUMA node whose pool the storage was allocated from
+		size_t numaNodeId = 0;
 	};
 
 	typedef ReductionSlot slot_t;
 
+	//! Size of the chunks in which the storage is split to combine it in
+	//! parallel. It is a multiple of the size of any builtin reduction type
+	static constexpr size_t combination_chunk_size = 128 * 1024;
+
+	//! \param[in] divisible whether the combination function can be applied
+	//! to any chunk of the storage aligned to combination_chunk_size, which is
+	//! only known for the builtin reductions
 	HostReductionStorage(void *address, size_t length, size_t paddedLength,
 		std::function<void(void *, void *, size_t)> initializationFunction,
-		std::function<void(void *, void *, size_t)> combinationFunction);
+		std::function<void(void *, void *, size_t)> combinationFunction,
+		bool divisible);
 
 	void *getFreeSlotStorage(Task *task, size_t slotIndex, ComputePlace *destinationComputePlace);
 
@@ -34,9 +44,18 @@ public:
 	~HostReductionStorage(){};
 
 private:
+	struct ParallelCombination;
+
+	bool _divisible;
 	std::vector<slot_t> _slots;
 	std::vector<long int> _currentCpuSlotIndices;
 	AtomicBitset<> _freeSlotIndices;
+
+	//! Combine the initialized slots chunk by chunk with the help of spawned
+	//! functions, returning when all the chunks have been combined
+	void combineInParallel(void *combineDestination, size_t initializedSlots);
+
+	static void combinationHelperBody(void *args);
 };
 
 #endif // HOST_REDUCTION_STORAGE_HPP
\ No newline at end of file
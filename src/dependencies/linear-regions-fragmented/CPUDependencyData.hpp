@@ -139,6 +139,10 @@ struct CPUDependencyData {
 	typedef Container::deque<CommutativeScoreboard::entry_t *> acquired_commutative_scoreboard_entries_t;
 	typedef Container::deque<TaskAndRegion> released_commutative_regions_t;
 	typedef Container::deque<DataAccess *> satisfied_taskwait_accesses_t;
+	typedef Container::vector<DataAccessRegion> finished_task_regions_t;
+
+	//! Maximum number of satisfied originators added at once to the scheduler
+	static const size_t _schedulerChunkSize = 256;
 
 	//! Tasks whose accesses have been satisfied after ending a task
 	satisfied_originator_list_t _satisfiedOriginators;
@@ -149,6 +153,11 @@ struct CPUDependencyData {
 	released_commutative_regions_t _releasedCommutativeRegions;
 	satisfied_taskwait_accesses_t _completedTaskwaits;
 
+	//! Regions accessed by the task that has just finished, used to choose
+	//! the satisfied originator that reuses most of its data as the
+	//! immediate successor
+	finished_task_regions_t _finishedTaskRegions;
+
 #ifndef NDEBUG
 	std::atomic<bool> _inUse;
 #endif
@@ -157,7 +166,7 @@ struct CPUDependencyData {
 		: _satisfiedOriginators(), _satisfiedCommutativeOriginators(),
 		_delayedOperations(), _removableTasks(),
 		_acquiredCommutativeScoreboardEntries(), _releasedCommutativeRegions(),
-		_completedTaskwaits()
+		_completedTaskwaits(), _finishedTaskRegions()
 #ifndef NDEBUG
 		, _inUse(false)
 #endif
@@ -174,7 +183,8 @@ struct CPUDependencyData {
 		return _satisfiedOriginators.empty() && _satisfiedCommutativeOriginators.empty()
 			&& _delayedOperations.empty() && _removableTasks.empty()
 			&& _acquiredCommutativeScoreboardEntries.empty()
-			&& _completedTaskwaits.empty();
+			&& _completedTaskwaits.empty()
+			&& _finishedTaskRegions.empty();
 	}
 };
 
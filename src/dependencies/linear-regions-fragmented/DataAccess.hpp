@@ -7,9 +7,6 @@
 #ifndef DATA_ACCESS_HPP
 #define DATA_ACCESS_HPP
 
-
-#define MAX_SYMBOLS 64 // TODO: Temporary solution to use a fixed bitset size
-
 #include <atomic>
 #include <bitset>
 #include <cassert>
@@ -25,6 +22,7 @@
 #include "ReductionInfo.hpp"
 #include "ReductionSpecific.hpp"
 #include "dependencies/DataAccessBase.hpp"
+#include "dependencies/DataAccessSymbols.hpp"
 #include "executors/threads/CPUManager.hpp"
 #include "lowlevel/SpinLock.hpp"
 
@@ -76,7 +74,7 @@ private:
 
 public:
 	typedef std::bitset<TOTAL_STATUS_BITS> status_t;
-	typedef std::bitset<MAX_SYMBOLS> symbols_t;
+	typedef DataAccessSymbols symbols_t;
 
 private:
 	DataAccessObjectType _objectType;
@@ -93,12 +91,12 @@ private:
 	//! Direct next access
 	DataAccessLink _next;
 
+	//! The "symbols" this access is related to
+	symbols_t _symbols;
+
 	//! An index that determines the data type and the operation of the reduction (if applicable)
 	reduction_type_and_operator_index_t _reductionTypeAndOperatorIndex;
 
-	//! A bitmap of the "symbols" this access is related to
-	symbols_t _symbols;
-
 	//! An index that identifies the reduction within the task (if applicable)
 	reduction_index_t _reductionIndex;
 
@@ -749,7 +747,7 @@ public:
 
 	bool isInSymbol(int symbol) const
 	{
-		return _symbols[symbol];
+		return _symbols.test(symbol);
 	}
 	void addToSymbol(int symbol)
 	{
@@ -763,7 +761,7 @@ public:
 	{
 		_symbols |= symbols;
 	}
-	symbols_t getSymbols() const
+	symbols_t const &getSymbols() const
 	{
 		return _symbols;
 	}
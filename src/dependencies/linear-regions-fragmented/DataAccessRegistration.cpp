@@ -11,6 +11,7 @@
 #include <cassert>
 #include <deque>
 #include <iostream>
+#include <iterator>
 #include <mutex>
 
 #include "BottomMapEntry.hpp"
@@ -28,6 +29,7 @@
 #include "scheduling/Scheduler.hpp"
 #include "support/Containers.hpp"
 #include "tasks/Task.hpp"
+#include "tasks/TaskGraph.hpp"
 
 #include <ClusterManager.hpp>
 #include <ExecutionWorkflow.hpp>
@@ -1433,6 +1435,101 @@ namespace DataAccessRegistration {
 	}
 
 
+	//! Add a batch of ready originators of the same device type to the scheduler
+	static inline void addSatisfiedOriginators(
+		Task *tasks[],
+		size_t numTasks,
+		nanos6_device_t type,
+		ComputePlace *computePlace,
+		bool fromBusyThread)
+	{
+		ComputePlace *computePlaceHint = nullptr;
+		if (computePlace != nullptr) {
+			if (computePlace->getType() == type) {
+				computePlaceHint = computePlace;
+			}
+		}
+
+		ReadyTaskHint schedulingHint = SIBLING_TASK_HINT;
+		if (fromBusyThread || !computePlaceHint || !computePlaceHint->isOwned()) {
+			schedulingHint = BUSY_COMPUTE_PLACE_TASK_HINT;
+		}
+
+		if (numTasks == 1) {
+			Scheduler::addReadyTask(tasks[0], computePlaceHint, schedulingHint);
+		} else {
+			Scheduler::addReadyTasks(type, tasks, numTasks, computePlaceHint, schedulingHint);
+		}
+	}
+
+	//! \brief Get the number of bytes that a task accesses from the regions of the finished task
+	static inline size_t getReusedBytes(
+		Task *task,
+		CPUDependencyData::finished_task_regions_t const &finishedTaskRegions)
+	{
+		TaskDataAccesses &accessStructures = task->getDataAccesses();
+		assert(!accessStructures.hasBeenDeleted());
+
+		size_t reusedBytes = 0;
+
+		std::lock_guard<TaskDataAccesses::spinlock_t> guard(accessStructures._lock);
+		accessStructures._accesses.processAll(
+			[&](TaskDataAccesses::accesses_t::iterator position) -> bool {
+				DataAccess *dataAccess = &(*position);
+				assert(dataAccess != nullptr);
+
+				if (!dataAccess->isWeak()) {
+					DataAccessRegion const &region = dataAccess->getAccessRegion();
+					for (DataAccessRegion const &finishedRegion : finishedTaskRegions) {
+						reusedBytes += region.intersect(finishedRegion).getSize();
+					}
+				}
+				return true;
+			});
+
+		return reusedBytes;
+	}
+
+	//! \brief Move the satisfied originator that reuses most of the data of
+	//! the finished task to the end of the list
+	//!
+	//! The scheduler keeps the last sibling that it receives as the immediate
+	//! successor, and the rest of them are queued with the CPU that released
+	//! them as a hint, so they stay in its NUMA node
+	static inline void selectLocalityImmediateSuccessor(
+		/* INOUT */ CPUDependencyData &hpDependencyData)
+	{
+		CPUDependencyData::satisfied_originator_list_t &satisfiedOriginators = hpDependencyData._satisfiedOriginators;
+		if (satisfiedOriginators.size() < 2) {
+			return;
+		}
+
+		CPUDependencyData::satisfied_originator_list_t::iterator best = satisfiedOriginators.end();
+		size_t bestBytes = 0;
+
+		for (auto it = satisfiedOriginators.begin(); it != satisfiedOriginators.end(); ++it) {
+			Task *satisfiedOriginator = *it;
+			assert(satisfiedOriginator != nullptr);
+
+			// Only host tasks that are not taskfors become immediate successors
+			if (satisfiedOriginator->getDeviceType() != nanos6_host_device || satisfiedOriginator->isTaskfor()) {
+				continue;
+			}
+
+			const size_t reusedBytes = getReusedBytes(satisfiedOriginator, hpDependencyData._finishedTaskRegions);
+			if (reusedBytes > bestBytes) {
+				bestBytes = reusedBytes;
+				best = it;
+			}
+		}
+
+		if (best != satisfiedOriginators.end() && best != std::prev(satisfiedOriginators.end())) {
+			Task *bestOriginator = *best;
+			satisfiedOriginators.erase(best);
+			satisfiedOriginators.push_back(bestOriginator);
+		}
+	}
+
 	//! Process all the originators that have become ready
 	static inline void processSatisfiedOriginators(
 		/* INOUT */ CPUDependencyData &hpDependencyData,
@@ -1441,23 +1538,32 @@ namespace DataAccessRegistration {
 	{
 		processSatisfiedCommutativeOriginators(hpDependencyData);
 
-		// NOTE: This is done without the lock held and may be slow since it can enter the scheduler
+		if (!hpDependencyData._finishedTaskRegions.empty()) {
+			selectLocalityImmediateSuccessor(hpDependencyData);
+			hpDependencyData._finishedTaskRegions.clear();
+		}
+
+		// NOTE: This is done without the lock held and may be slow since it can enter the scheduler.
+		// Consecutive originators of the same device type are added to the scheduler in batches
+		Task *batch[CPUDependencyData::_schedulerChunkSize];
+		size_t numTasks = 0;
+		nanos6_device_t batchType = nanos6_host_device;
+
 		for (Task *satisfiedOriginator : hpDependencyData._satisfiedOriginators) {
 			assert(satisfiedOriginator != 0);
 
-			ComputePlace *computePlaceHint = nullptr;
-			if (computePlace != nullptr) {
-				if (computePlace->getType() == satisfiedOriginator->getDeviceType()) {
-					computePlaceHint = computePlace;
-				}
+			nanos6_device_t type = (nanos6_device_t) satisfiedOriginator->getDeviceType();
+			if (numTasks > 0 && (type != batchType || numTasks == CPUDependencyData::_schedulerChunkSize)) {
+				addSatisfiedOriginators(batch, numTasks, batchType, computePlace, fromBusyThread);
+				numTasks = 0;
 			}
 
-			ReadyTaskHint schedulingHint = SIBLING_TASK_HINT;
-			if (fromBusyThread || !computePlaceHint || !computePlaceHint->isOwned()) {
-				schedulingHint = BUSY_COMPUTE_PLACE_TASK_HINT;
-			}
+			batchType = type;
+			batch[numTasks++] = satisfiedOriginator;
+		}
 
-			Scheduler::addReadyTask(satisfiedOriginator, computePlaceHint, schedulingHint);
+		if (numTasks > 0) {
+			addSatisfiedOriginators(batch, numTasks, batchType, computePlace, fromBusyThread);
 		}
 
 		hpDependencyData._satisfiedOriginators.clear();
@@ -2364,6 +2470,11 @@ namespace DataAccessRegistration {
 				previous->setNext(next);
 				previous->unsetInBottomMap();  /* only unsets the status bit, doesn't actually remove it */
 
+				// The new task is a successor of the previous sibling
+				if (Scheduler::isCriticalPathPriorityEnabled() && previous->getObjectType() == access_type) {
+					previousTask->addSuccessorCost(next._task->getPredictedCost());
+				}
+
 				DataAccessStatusEffects updatedStatus(previous);
 
 				/*
@@ -3557,6 +3668,13 @@ namespace DataAccessRegistration {
 	{
 		assert(task != nullptr);
 
+		// The replayed tasks only release their recorded successors
+		TaskGraph *taskGraph = task->getTaskGraph();
+		if (taskGraph != nullptr && taskGraph->hasReplayedTasks()) {
+			taskGraph->unregisterReplayedTask(task, computePlace, fromBusyThread);
+			return;
+		}
+
 		Instrument::enterUnregisterTaskDataAcesses();
 
 		TaskDataAccesses &accessStructures = task->getDataAccesses();
@@ -3577,6 +3695,12 @@ namespace DataAccessRegistration {
 		}
 #endif
 
+		// Remember the regions of the task to choose the successor that reuses
+		// most of its data. Only when the successor may run in this CPU
+		const bool keepRegions = Scheduler::isLocalityImmediateSuccessorEnabled()
+			&& !fromBusyThread && computePlace != nullptr
+			&& computePlace->getType() == nanos6_host_device;
+
 		{
 			std::lock_guard<TaskDataAccesses::spinlock_t> guard(accessStructures._lock);
 
@@ -3587,6 +3711,10 @@ namespace DataAccessRegistration {
 					DataAccess *dataAccess = &(*position);
 					assert(dataAccess != nullptr);
 
+					if (keepRegions && !dataAccess->isWeak()) {
+						hpDependencyData._finishedTaskRegions.push_back(dataAccess->getAccessRegion());
+					}
+
 					MemoryPlace *accessLocation = (dataAccess->isWeak()) ? nullptr : location;
 
 					finalizeAccess(task, dataAccess, dataAccess->getAccessRegion(), 0, accessLocation, /* OUT */ hpDependencyData);
@@ -3843,7 +3971,7 @@ namespace DataAccessRegistration {
 					void *address = dataAccess->getAccessRegion().getStartAddress();
 					void *translation = nullptr;
 					const DataAccessRegion &originalFullRegion = reductionInfo->getOriginalRegion();
-					translation = ((char *)reductionInfo->getFreeSlotStorage(slotIndex).getStartAddress()) + ((char *)address - (char *)originalFullRegion.getStartAddress());
+					translation = ((char *)reductionInfo->getFreeSlotStorage(slotIndex, ((CPU *) computePlace)->getNumaNodeId()).getStartAddress()) + ((char *)address - (char *)originalFullRegion.getStartAddress());
 
 					// As we're iterating accesses that might have been split by sibling tasks, it is
 					// possible that we translate the same symbol twice. However, this is not an issue
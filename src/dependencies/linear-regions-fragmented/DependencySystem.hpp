@@ -1,12 +1,13 @@
 /*
 	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
 
-	Copyright (C) 2015-2017 Barcelona Supercomputing Center (BSC)
+	Copyright (C) 2015-2020 Barcelona Supercomputing Center (BSC)
 */
 
 #ifndef DEPENDENCY_SYSTEM_HPP
 #define DEPENDENCY_SYSTEM_HPP
 
+#include "DataAccess.hpp"
 #include "system/RuntimeInfo.hpp"
 
 
@@ -15,6 +16,7 @@ public:
 	static void initialize()
 	{
 		RuntimeInfo::addEntry("dependency_implementation", "Dependency Implementation", "regions (linear-regions-fragmented)");
+		RuntimeInfo::addEntry("data_access_size", "Data Access Size", sizeof(DataAccess), "bytes");
 	}
 };
 
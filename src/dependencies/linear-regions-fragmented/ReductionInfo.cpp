@@ -5,6 +5,7 @@
 */
 
 
+#include <algorithm>
 #include <cassert>
 #include <sys/mman.h>
 
@@ -14,6 +15,7 @@
 
 #include <InstrumentReductions.hpp>
 #include <MemoryAllocator.hpp>
+#include <dependencies/BuiltinReductions.hpp>
 #include <executors/threads/WorkerThread.hpp>
 #include <hardware/HardwareInfo.hpp>
 
@@ -36,6 +38,7 @@ ReductionInfo::ReductionInfo(DataAccessRegion region, reduction_type_and_operato
 	_slots.reserve(maxSlots);
 	_freeSlotIndices.reserve(maxSlots);
 	_currentCpuSlotIndices.resize(nCpus, -1);
+	_cpuOwnSlotIndices.resize(nCpus, -1);
 	_isAggregatingSlotIndex.resize(maxSlots);
 }
 
@@ -54,7 +57,7 @@ ReductionInfo::~ReductionInfo()
 			
 			if (slot.storage != nullptr) {
 				assert(slot.initialized);
-				MemoryAllocator::free(slot.storage, _paddedRegionSize);
+				MemoryAllocator::freeNUMA(slot.storage, _paddedRegionSize, slot.numaNodeId);
 #ifndef NDEBUG
 				slot.storage = nullptr;
 				slot.initialized = false;
@@ -96,8 +99,19 @@ size_t ReductionInfo::getFreeSlotIndex(size_t virtualCpuId) {
 	_lock.lock();
 	size_t freeSlotIndex;
 	if (_freeSlotIndices.size() > 0) {
-		// Reuse free slot in pool
-		freeSlotIndex = _freeSlotIndices.back();
+		// Reuse free slot in pool, preferably the one that this CPU allocated
+		// and initialized, whose storage comes from the pool of this CPU
+		Container::vector<size_t>::iterator it = _freeSlotIndices.end() - 1;
+		long int ownSlotIndex = _cpuOwnSlotIndices[virtualCpuId];
+		if (ownSlotIndex != -1) {
+			Container::vector<size_t>::iterator own =
+				std::find(_freeSlotIndices.begin(), _freeSlotIndices.end(), (size_t) ownSlotIndex);
+			if (own != _freeSlotIndices.end())
+				it = own;
+		}
+		
+		freeSlotIndex = *it;
+		*it = _freeSlotIndices.back();
 		_freeSlotIndices.pop_back();
 	}
 	else {
@@ -105,6 +119,9 @@ size_t ReductionInfo::getFreeSlotIndex(size_t virtualCpuId) {
 				"Maximum number of private storage slots reached");
 		freeSlotIndex = _slots.size();
 		_slots.emplace_back();
+		
+		if (_cpuOwnSlotIndices[virtualCpuId] == -1)
+			_cpuOwnSlotIndices[virtualCpuId] = freeSlotIndex;
 	}
 	_lock.unlock();
 	
@@ -113,7 +130,7 @@ size_t ReductionInfo::getFreeSlotIndex(size_t virtualCpuId) {
 	return freeSlotIndex;
 }
 
-DataAccessRegion ReductionInfo::getFreeSlotStorage(size_t slotIndex) {
+DataAccessRegion ReductionInfo::getFreeSlotStorage(size_t slotIndex, size_t numaNodeId) {
 #ifndef NDEBUG
 	_lock.lock();
 	assert(slotIndex < _slots.size());
@@ -124,12 +141,15 @@ DataAccessRegion ReductionInfo::getFreeSlotStorage(size_t slotIndex) {
 	assert(slot.initialized || slot.storage == nullptr);
 	
 	if (!slot.initialized) {
-		// Allocate new storage
+		// Allocate new storage from the NUMA node of the CPU. The storage may
+		// be freed from another CPU, so it is returned to the pool of the
+		// node that is kept in the slot
 		Instrument::enterAllocatePrivateReductionStorage(
 			/* reductionInfo */ *this
 		);
 		
-		slot.storage = MemoryAllocator::alloc(_paddedRegionSize);
+		slot.numaNodeId = numaNodeId;
+		slot.storage = MemoryAllocator::allocNUMA(_paddedRegionSize, numaNodeId);
 		
 		Instrument::exitAllocatePrivateReductionStorage(
 			/* reductionInfo */ *this,
@@ -153,15 +173,6 @@ DataAccessRegion ReductionInfo::getFreeSlotStorage(size_t slotIndex) {
 	return DataAccessRegion(slot.storage, _region.getSize());
 }
 
-namespace {
-	bool isBuiltinReduction(reduction_type_and_operator_index_t typeAndOperatorIndex) {
-		assert((typeAndOperatorIndex != 0) && "Unknown reduction type and operator");
-		return (typeAndOperatorIndex >= RED_TYPE_CHAR)
-			&& (typeAndOperatorIndex < NUM_RED_TYPES)
-			&& (typeAndOperatorIndex%1000 < NUM_RED_OPS);
-	}
-};
-
 void ReductionInfo::makeOriginalStorageRegionAvailable(const DataAccessRegion &region) {
 	_originalStorageAvailabilityCounter -= region.getSize();
 	
@@ -279,7 +290,7 @@ bool ReductionInfo::combineRegion(const DataAccessRegion& subregion, reduction_s
 			else if (slot.storage != originalRegionAddress) {
 				// Non-aggregating private slots can be deallocated and disabled
 				assert(slot.storage != nullptr);
-				MemoryAllocator::free(slot.storage, _paddedRegionSize);
+				MemoryAllocator::freeNUMA(slot.storage, _paddedRegionSize, slot.numaNodeId);
 				
 				// Clear slot content so that we can later detect deallocation has been done
 				slot.storage = nullptr;
@@ -29,6 +29,8 @@ class ReductionInfo
 		struct ReductionSlot {
 			void *storage = nullptr;
 			bool initialized = false;
+			// NUMA node whose pool the storage was allocated from
+			size_t numaNodeId = 0;
 		};
 		
 		typedef boost::dynamic_bitset<> reduction_slot_set_t;
@@ -50,7 +52,7 @@ class ReductionInfo
 		
 		size_t getFreeSlotIndex(size_t virtualCpuId);
 		
-		DataAccessRegion getFreeSlotStorage(size_t slotIndex);
+		DataAccessRegion getFreeSlotStorage(size_t slotIndex, size_t numaNodeId);
 		
 		void makeOriginalStorageRegionAvailable(const DataAccessRegion &region);
 		
@@ -72,6 +74,10 @@ class ReductionInfo
 		Container::vector<ReductionSlot> _slots;
 		Container::vector<long int> _currentCpuSlotIndices;
 		Container::vector<size_t> _freeSlotIndices;
+		
+		// The first slot allocated by each CPU, which is the one that it
+		// takes when it is free
+		Container::vector<long int> _cpuOwnSlotIndices;
 
 		// Aggregating slots are private slots used to aggregate combinations
 		// when the original region is not available for combination
@@ -13,6 +13,7 @@
 #include "../DataAccessType.hpp"
 #include "executors/threads/WorkerThread.hpp"
 #include "tasks/Task.hpp"
+#include "tasks/TaskGraph.hpp"
 #include "tasks/TaskImplementation.hpp"
 
 
@@ -32,6 +33,13 @@ void register_access(void *handler, void *start, size_t length, int symbolIndex,
 	}
 	
 	bool weak = (WEAK && !task->isFinal() && !task->isTaskfor()) || task->isTaskloopSource();
+
+	// The accesses of the tasks replayed from a task graph are only checked
+	TaskGraph *taskGraph = task->getTaskGraph();
+	if (taskGraph != nullptr && taskGraph->registerAccess(task, ACCESS_TYPE, weak, start, length)) {
+		return;
+	}
+
 	Instrument::registerTaskAccess(task->getInstrumentationTaskId(), ACCESS_TYPE, weak, start, length);
 	
 	if (start == nullptr) {
@@ -45,6 +45,13 @@ struct TaskDataAccesses
 		boost::intrusive::function_hook< BottomMapEntryLinkingArtifacts >
 	> subaccess_bottom_map_t;
 
+	// Protects the accesses, fragments, taskwait fragments and bottom map,
+	// and the status of the DataAccess objects in them. The children link
+	// to and propagate into the fragments and bottom map of their parent
+	// under this lock, so siblings serialize on it even when their regions
+	// are disjoint. Locking ranges of the maps instead would also require
+	// splitting the delayed operations and the lock hand-offs of taskwaits
+	// and top-level sinks by region, which is not done yet
 	spinlock_t _lock;
 	accesses_t _accesses;
 	access_fragments_t _accessFragments;
@@ -9,6 +9,7 @@
 
 
 #include <cassert>
+#include <iterator>
 #include <mutex>
 
 #include "IntrusiveLinearRegionMap.hpp"
@@ -465,7 +466,16 @@ typename IntrusiveLinearRegionMap<ContentType, Hook>::iterator IntrusiveLinearRe
 			} else {
 				ContentType *newContents = duplicator(contents); // An error here indicates that the duplicator is missing the "ContentType *" return type
 				newContents->setAccessRegion(region);
-				BaseType::insert(*newContents);
+				if (removeIntersection) {
+					BaseType::insert(*newContents);
+				} else if (region.getStartAddress() < position->getAccessRegion().getStartAddress()) {
+					// The left fragment goes right before the intersection, so
+					// the hinted insertion does not need to descend the tree
+					BaseType::insert(position, *newContents);
+				} else {
+					// And the right fragment right after it
+					BaseType::insert(std::next(position), *newContents);
+				}
 				postprocessor(newContents, &(*position));
 				VERIFY_MAP();
 			}
@@ -113,9 +113,11 @@ public:
 	//! changes. Some common scenarios include:
 	//! - Requesting the resume of idle CPUs (hint = REQUEST_CPUS)
 	//! - Execution of a taskfor (hint = HANDLE_TASKFOR)
+	//! - Requesting the resume of a given CPU (hint = REQUEST_SPECIFIC_CPU)
 	//! - Running out of tasks to execute (hint = IDLE_CANDIDATE)
 	//!
-	//! \param[in] cpu The CPU that triggered the call, if any
+	//! \param[in] cpu The CPU that triggered the call, if any, or the CPU
+	//! to resume if hint == REQUEST_SPECIFIC_CPU
 	//! \param[in] hint A hint about what kind of change triggered this call
 	//! \param[in] numRequested If hint == REQUEST_CPUS, numRequested is the amount
 	//! of idle CPUs to resume
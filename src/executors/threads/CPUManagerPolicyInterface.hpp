@@ -13,7 +13,8 @@
 enum CPUManagerPolicyHint {
 	IDLE_CANDIDATE,
 	REQUEST_CPUS,
-	HANDLE_TASKFOR
+	HANDLE_TASKFOR,
+	REQUEST_SPECIFIC_CPU
 };
 
 
@@ -27,7 +28,8 @@ public:
 
 	//! \brief Execute the CPUManager's policy
 	//!
-	//! \param[in,out] cpu The CPU that triggered the call, if any
+	//! \param[in,out] cpu The CPU that triggered the call, if any, or the CPU
+	//! to resume if hint == REQUEST_SPECIFIC_CPU
 	//! \param[in] hint A hint about what kind of change triggered this call
 	//! \param[in] numRequested If hint == REQUEST_CPUS, numRequested is the amount
 	//! of idle CPUs to resume
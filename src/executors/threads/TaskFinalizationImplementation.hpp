@@ -137,9 +137,12 @@ void TaskFinalization::disposeTask(Task *task)
 			void *disposableBlock;
 			size_t disposableBlockSize;
 
+			// The look-ahead rank is right before the task, if any
+			const size_t lookAheadRankSize = task->hasLookAheadRank() ? sizeof(Task::LookAheadRank) : 0;
+
 			if (task->hasPreallocatedArgsBlock()) {
-				disposableBlock = task;
-				disposableBlockSize = 0;
+				disposableBlock = (char *) task - lookAheadRankSize;
+				disposableBlockSize = lookAheadRankSize;
 			} else {
 				disposableBlock = task->getArgsBlock();
 				assert(disposableBlock != nullptr);
@@ -151,10 +151,10 @@ void WorkerThread::handleTask(CPU *cpu)
 		assert(!_task->isRunnable());
 
 		// We have already set the chunk of the preallocatedTaskfor in the scheduler.
-		if (cpu->getPreallocatedTaskfor()->getMyChunk() >= 0) {
+		if (cpu->getPreallocatedTaskfor()->hasChunk()) {
 			Taskfor *collaborator = LoopGenerator::createCollaborator((Taskfor *)_task, cpu);
 			assert(collaborator->isRunnable());
-			assert(collaborator->getMyChunk() >= 0);
+			assert(collaborator->hasChunk());
 
 			_task = collaborator;
 			ExecutionWorkflow::executeTask(_task, cpu, targetMemoryPlace);
@@ -306,6 +306,34 @@ size_t DefaultCPUManager::getIdleCPUs(
 	return numObtainedCPUs;
 }
 
+bool DefaultCPUManager::unidleCPU(CPU *cpu)
+{
+	assert(cpu != nullptr);
+
+	const size_t id = cpu->getIndex();
+
+	_idleCPUsLock.lock();
+
+	if (!_idleCPUs[id]) {
+		_idleCPUsLock.unlock();
+
+		return false;
+	}
+
+	// Mark the CPU as active
+	_idleCPUs[id] = false;
+	assert(_numIdleCPUs > 0);
+
+	--_numIdleCPUs;
+
+	_idleCPUsLock.unlock();
+
+	// Runtime Tracking Point - A cpu becomes active
+	TrackingPoints::cpuBecomesActive(cpu);
+
+	return true;
+}
+
 void DefaultCPUManager::getIdleCollaborators(
 	std::vector<CPU *> &idleCPUs,
 	ComputePlace *cpu
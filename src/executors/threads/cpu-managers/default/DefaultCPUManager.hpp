@@ -135,6 +135,13 @@ public:
 	//! \return The number of idle CPUs obtained/valid references in the vector
 	static size_t getIdleCPUs(size_t numCPUs, CPU *idleCPUs[]);
 
+	//! \brief Try to mark a specific CPU as active if it is idle
+	//!
+	//! \param[in] cpu The CPU to unidle
+	//!
+	//! \return Whether the CPU was idle and has been marked as active
+	static bool unidleCPU(CPU *cpu);
+
 	//! \brief Get all the idle CPUs that can collaborate in a taskfor
 	//!
 	//! \param[out] idleCPUs A vector where unidled collaborators are stored
@@ -22,8 +22,8 @@ public:
 	{
 		// NOTE: This policy works as follows:
 		// - If the hint is IDLE_CANDIDATE, the CPU remains active (no change)
-		// - If the hint is REQUEST_CPUS or HANDLE_TASKFOR, no CPUs are woken up as
-		//   all of them should be awake
+		// - If the hint is REQUEST_CPUS, HANDLE_TASKFOR or REQUEST_SPECIFIC_CPU, no
+		//   CPUs are woken up as all of them should be awake
 
 		if (hint == IDLE_CANDIDATE)
 			Instrument::workerThreadBusyWaits();
@@ -17,6 +17,8 @@ void IdlePolicy::execute(ComputePlace *cpu, CPUManagerPolicyHint hint, size_t nu
 	//   number of idle CPUs
 	// - If the hint is HANDLE_TASKFOR, we try to wake up all idle CPUs
 	//   that can collaborate executing it
+	// - If the hint is REQUEST_SPECIFIC_CPU, we try to wake up the given
+	//   CPU if it is idle
 	if (hint == IDLE_CANDIDATE) {
 		assert(cpu != nullptr);
 
@@ -49,6 +51,12 @@ void IdlePolicy::execute(ComputePlace *cpu, CPUManagerPolicyHint hint, size_t nu
 			assert(idleCPUs[i] != nullptr);
 			ThreadManager::resumeIdle(idleCPUs[i]);
 		}
+	} else if (hint == REQUEST_SPECIFIC_CPU) {
+		assert(cpu != nullptr);
+
+		if (DefaultCPUManager::unidleCPU((CPU *) cpu)) {
+			ThreadManager::resumeIdle((CPU *) cpu);
+		}
 	} else { // hint = HANDLE_TASKFOR
 		assert(cpu != nullptr);
 
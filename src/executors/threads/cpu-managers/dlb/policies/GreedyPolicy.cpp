@@ -18,6 +18,8 @@ void GreedyPolicy::execute(ComputePlace *cpu, CPUManagerPolicyHint hint, size_t
 	//   CPUs or acquire new ones
 	// - If the hint is HANDLE_TASKFOR, we try to reclaim all CPUs that can
 	//   collaborate in the taskfor
+	// - If the hint is REQUEST_SPECIFIC_CPU, we try to reclaim or acquire the
+	//   given CPU
 	CPU *currentCPU = (CPU *) cpu;
 	if (hint == IDLE_CANDIDATE) {
 		assert(currentCPU != nullptr);
@@ -31,6 +33,13 @@ void GreedyPolicy::execute(ComputePlace *cpu, CPUManagerPolicyHint hint, size_t
 		// Try to obtain the requested number of CPUs
 		size_t numToObtain = std::min(_numCPUs, numRequested);
 		DLBCPUActivation::acquireCPUs(numToObtain);
+	} else if (hint == REQUEST_SPECIFIC_CPU) {
+		assert(currentCPU != nullptr);
+
+		cpu_set_t cpuMask;
+		CPU_ZERO(&cpuMask);
+		CPU_SET(currentCPU->getSystemCPUId(), &cpuMask);
+		DLBCPUActivation::acquireCPUs(cpuMask);
 	} else { // hint = HANDLE_TASKFOR
 		assert(currentCPU != nullptr);
 
@@ -135,6 +135,15 @@ namespace ExecutionWorkflow {
 		}
 	}
 
+	bool ClusterDataCopyStep::partOfRegionArrived(DataAccessRegion const &part)
+	{
+		assert(part.fullyContainedIn(_region));
+		assert(_pendingBytes >= part.getSize());
+		_pendingBytes -= part.getSize();
+
+		return (_pendingBytes == 0);
+	}
+
 	void ClusterDataCopyStep::start()
 	{
 		assert(ClusterManager::getCurrentMemoryNode() == _targetMemoryPlace);
@@ -198,9 +207,19 @@ namespace ExecutionWorkflow {
 						(char *)pendingRegion.getStartAddress() + pendingRegion.getSize())) {
 
 					// Yes, the pending data transfer contains this region: so add a callback
-					// for this task
-					dtPending->addCompletionCallback(
-								[&]() {
+					// for this task. Large transfers complete in parts, so the task only
+					// waits until the parts that cover its own region have arrived
+					// The parts outside the region may arrive after the step
+					// has been deleted, so they are filtered with a copy of it
+					const DataAccessRegion region = _region;
+
+					dtPending->addPartialCompletionCallback(
+								[this, region](DataAccessRegion const &completed) {
+									const DataAccessRegion intersection = region.intersect(completed);
+									if (intersection.empty() || !this->partOfRegionArrived(intersection)) {
+										return;
+									}
+
 									//! If this data copy is performed for a taskwait we
 									//! don't need to update the location here.
 									DataAccessRegistration::updateTaskDataAccessLocation(
@@ -237,9 +256,16 @@ namespace ExecutionWorkflow {
 				_sourceMemoryPlace
 			);
 
-			/* Callback for this region, also instrument the data transfer */
-			dt->addCompletionCallback(
-					[&]() {
+			/* Callback for this region, also instrument the data transfer.
+			 * Large transfers complete in parts, so the successors are
+			 * released as soon as the last part arrives */
+			dt->addPartialCompletionCallback(
+					[this](DataAccessRegion const &completed) {
+						// The transfer is exactly this region
+						if (!this->partOfRegionArrived(completed)) {
+							return;
+						}
+
 						Instrument::clusterDataReceived(_region.getStartAddress(),
 														_region.getSize(),
 														_sourceMemoryPlace->getIndex());
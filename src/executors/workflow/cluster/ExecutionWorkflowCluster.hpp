@@ -98,6 +98,14 @@ namespace ExecutionWorkflow {
 		//! An actual data transfer is required
 		bool _needsTransfer;
 
+		//! The bytes of the region that have not arrived yet
+		size_t _pendingBytes;
+
+		//! Account for a part of the region that has arrived
+		//!
+		//! \returns true if the whole region has arrived with it
+		bool partOfRegionArrived(DataAccessRegion const &part);
+
 	public:
 		ClusterDataCopyStep(
 			MemoryPlace const *sourceMemoryPlace,
@@ -114,7 +122,8 @@ namespace ExecutionWorkflow {
 			_task(task),
 			_writeID(writeID),
 			_isTaskwait(isTaskwait),
-			_needsTransfer(needsTransfer)
+			_needsTransfer(needsTransfer),
+			_pendingBytes(region.getSize())
 		{
 		}
 
@@ -7,6 +7,8 @@
 #ifndef CLUSTER_NODE_HPP
 #define CLUSTER_NODE_HPP
 
+#include <atomic>
+
 #include "hardware/places/ComputePlace.hpp"
 
 #include <ClusterMemoryNode.hpp>
@@ -20,14 +22,34 @@ private:
 	//! communication layer
 	int _commIndex;
 
+	//! Index of the physical host where the node runs. Nodes
+	//! with the same host index can share memory
+	int _hostIndex;
+
+	//! Last memory pressure (0-100%) reported by the node
+	std::atomic<size_t> _memoryPressure;
+
+	//! Last number of offloaded tasks pending on the node, as
+	//! reported by the node
+	std::atomic<size_t> _numRemoteTasks;
+
+	//! Number of tasks that the current node has offloaded to this
+	//! node and have not finished yet
+	std::atomic<size_t> _numOffloadedTasks;
+
 public:
-	ClusterNode(int index, int commIndex)
+	ClusterNode(int index, int commIndex, int hostIndex)
 		: ComputePlace(index, nanos6_device_t::nanos6_cluster_device),
 		_memoryNode(new ClusterMemoryNode(index, commIndex)),
-		_commIndex(commIndex)
+		_commIndex(commIndex),
+		_hostIndex(hostIndex),
+		_memoryPressure(0),
+		_numRemoteTasks(0),
+		_numOffloadedTasks(0)
 	{
 		assert(_memoryNode != nullptr);
 		assert (_commIndex >= 0);
+		assert (_hostIndex >= 0);
 	}
 
 	~ClusterNode()
@@ -49,6 +71,63 @@ public:
 		assert (_commIndex >= 0);
 		return _commIndex;
 	}
+
+	//! \brief Get the index of the host of the ClusterNode
+	inline int getHostIndex() const
+	{
+		assert (_hostIndex >= 0);
+		return _hostIndex;
+	}
+
+	//! \brief Check whether two ClusterNodes run on the same host
+	inline bool sharesHostWith(ClusterNode const *other) const
+	{
+		assert(other != nullptr);
+		return _hostIndex == other->_hostIndex;
+	}
+
+	//! \brief Update the load reported by the node
+	//!
+	//! \param[in] memoryPressure is the memory pressure of the node (0-100%)
+	//! \param[in] numRemoteTasks is the number of offloaded tasks pending
+	//!		on the node, from any offloader
+	inline void updateLoad(size_t memoryPressure, size_t numRemoteTasks)
+	{
+		assert(memoryPressure <= 100);
+		_memoryPressure.store(memoryPressure, std::memory_order_relaxed);
+		_numRemoteTasks.store(numRemoteTasks, std::memory_order_relaxed);
+	}
+
+	//! \brief Get the last memory pressure reported by the node
+	inline size_t getMemoryPressure() const
+	{
+		return _memoryPressure.load(std::memory_order_relaxed);
+	}
+
+	//! \brief Get the last number of pending offloaded tasks reported by the node
+	inline size_t getNumRemoteTasks() const
+	{
+		return _numRemoteTasks.load(std::memory_order_relaxed);
+	}
+
+	//! \brief Account for a task offloaded to this node
+	inline void offloadedTaskStarted()
+	{
+		++_numOffloadedTasks;
+	}
+
+	//! \brief Account for a task offloaded to this node that has finished
+	inline void offloadedTaskFinished()
+	{
+		assert(_numOffloadedTasks > 0);
+		--_numOffloadedTasks;
+	}
+
+	//! \brief Get the number of tasks offloaded to this node that are pending
+	inline size_t getNumOffloadedTasks() const
+	{
+		return _numOffloadedTasks.load(std::memory_order_relaxed);
+	}
 };
 
 
@@ -13,7 +13,11 @@
 
 class ClusterNode : public ComputePlace {
 public:
-	ClusterNode(__attribute__((unused))int index = 0, __attribute__((unused))int commIndex = 0)
+	ClusterNode(
+		__attribute__((unused))int index = 0,
+		__attribute__((unused))int commIndex = 0,
+		__attribute__((unused))int hostIndex = 0
+	)
 		: ComputePlace(index, nanos6_device_t::nanos6_cluster_device)
 	{
 	}
@@ -37,6 +41,16 @@ public:
 	{
 		return 0;
 	}
+
+	inline int getHostIndex() const
+	{
+		return 0;
+	}
+
+	inline bool sharesHostWith(__attribute__((unused)) ClusterNode const *other) const
+	{
+		return true;
+	}
 };
 
 
@@ -71,6 +71,42 @@ namespace Instrument {
 				ThreadInstrumentationContext::getCurrent()
 	);
 
+	//! This function is called when a compressed data transfer completes
+	//!
+	//! \param[in] address is the start address of the transferred region
+	//! \param[in] size is the uncompressed size of the region
+	//! \param[in] compressedSize is the number of bytes sent through the network
+	//! \param[in] codecTime is the time in nanoseconds spent (de)compressing
+	//! \param[in] peer is the index of the remote node
+	//! \param[in] isSend is true on the sender side of the transfer
+	void clusterDataCompressed(
+		void *address,
+		size_t size,
+		size_t compressedSize,
+		size_t codecTime,
+		int peer,
+		bool isSend,
+		InstrumentationContext const &context =
+				ThreadInstrumentationContext::getCurrent()
+	);
+
+	//! This function is called when a non-blocking data transfer completes
+	//!
+	//! \param[in] address is the start address of the transferred region
+	//! \param[in] size is the size of the region
+	//! \param[in] elapsedTime is the time in microseconds since the transfer was posted
+	//! \param[in] peer is the index of the remote node
+	//! \param[in] isSend is true on the sender side of the transfer
+	void clusterDataTransferCompleted(
+		void *address,
+		size_t size,
+		size_t elapsedTime,
+		int peer,
+		bool isSend,
+		InstrumentationContext const &context =
+				ThreadInstrumentationContext::getCurrent()
+	);
+
 	//! \brief Indicates that the task has been offloaded to another node
 	//! \param[in] taskId the task identifier for the offloaded task
 	void taskIsOffloaded(
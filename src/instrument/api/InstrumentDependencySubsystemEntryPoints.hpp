@@ -22,6 +22,10 @@ namespace Instrument {
 	//! \brief Exit task unregistration
 	void exitUnregisterTaskDataAcesses();
 
+	//! \brief A weak access without children has satisfied its successor
+	//! directly during the task unregistration
+	void weakAccessFastRelease();
+
 }
 
 #endif //INSTRUMENT_DEPENDENCY_SUBSYTEM_ENTRY_POINTS_HPP
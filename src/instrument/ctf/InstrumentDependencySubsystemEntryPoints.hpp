@@ -33,6 +33,10 @@ namespace Instrument {
 		tp_dependency_unregister_exit();
 	}
 
+	inline void weakAccessFastRelease()
+	{
+	}
+
 }
 
 #endif //INSTRUMENT_CTF_DEPENDENCY_SUBSYTEM_ENTRY_POINTS_HPP
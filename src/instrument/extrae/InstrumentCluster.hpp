@@ -31,6 +31,14 @@ namespace Instrument {
 	inline void clusterDataReceived(void *, size_t, int, InstrumentationContext const &)
 	{
 	}
+
+	inline void clusterDataCompressed(void *, size_t, size_t, size_t, int, bool, InstrumentationContext const &)
+	{
+	}
+
+	inline void clusterDataTransferCompleted(void *, size_t, size_t, int, bool, InstrumentationContext const &)
+	{
+	}
 }
 
 #endif //! INSTRUMENT_EXTRAE_CLUSTER_HPP
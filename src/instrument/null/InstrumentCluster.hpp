@@ -36,6 +36,14 @@ namespace Instrument {
 	{
 	}
 
+	inline void clusterDataCompressed(void *, size_t, size_t, size_t, int, bool, InstrumentationContext const &)
+	{
+	}
+
+	inline void clusterDataTransferCompleted(void *, size_t, size_t, int, bool, InstrumentationContext const &)
+	{
+	}
+
 	inline void taskIsOffloaded(task_id_t, InstrumentationContext const &)
 	{
 	}
@@ -20,6 +20,8 @@ namespace Instrument {
 
 	inline void exitUnregisterTaskDataAcesses() {}
 
+	inline void weakAccessFastRelease() {}
+
 }
 
 #endif //INSTRUMENT_NULL_DEPENDENCY_SUBSYTEM_ENTRY_POINTS_HPP
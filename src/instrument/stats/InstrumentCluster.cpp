@@ -18,6 +18,17 @@ namespace Instrument {
 	std::atomic<size_t> bytesMessagesSent[TOTAL_MESSAGE_TYPES];
 	std::atomic<size_t> bytesMessagesReceived[TOTAL_MESSAGE_TYPES];
 
+	//! Compressed data transfers, indexed by direction (0 sent, 1 received)
+	std::atomic<size_t> countCompressedTransfers[2];
+	std::atomic<size_t> bytesUncompressed[2];
+	std::atomic<size_t> bytesCompressed[2];
+	std::atomic<size_t> timeCompression[2];
+
+	//! Completed non-blocking data transfers, indexed by direction
+	std::atomic<size_t> countTransfers[2];
+	std::atomic<size_t> bytesTransfers[2];
+	std::atomic<size_t> timeTransfers[2];
+
 	void initClusterCounters()
 	{
 		for(int j=0; j<TOTAL_MESSAGE_TYPES; j++) {
@@ -26,6 +37,16 @@ namespace Instrument {
 			bytesMessagesSent[j] = 0;
 			bytesMessagesReceived[j] = 0;
 		}
+
+		for (int j = 0; j < 2; j++) {
+			countCompressedTransfers[j] = 0;
+			bytesUncompressed[j] = 0;
+			bytesCompressed[j] = 0;
+			timeCompression[j] = 0;
+			countTransfers[j] = 0;
+			bytesTransfers[j] = 0;
+			timeTransfers[j] = 0;
+		}
 	}
 
 	void clusterMessageInitSend(Message const *message, int, InstrumentationContext const &)
@@ -56,6 +77,36 @@ namespace Instrument {
 		bytesMessagesReceived[DATA_RAW] += size;
 	}
 
+	void clusterDataCompressed(
+		void *,
+		size_t size,
+		size_t compressedSize,
+		size_t codecTime,
+		int,
+		bool isSend,
+		InstrumentationContext const &
+	) {
+		const int direction = (isSend) ? 0 : 1;
+		countCompressedTransfers[direction] ++;
+		bytesUncompressed[direction] += size;
+		bytesCompressed[direction] += compressedSize;
+		timeCompression[direction] += codecTime;
+	}
+
+	void clusterDataTransferCompleted(
+		void *,
+		size_t size,
+		size_t elapsedTime,
+		int,
+		bool isSend,
+		InstrumentationContext const &
+	) {
+		const int direction = (isSend) ? 0 : 1;
+		countTransfers[direction] ++;
+		bytesTransfers[direction] += size;
+		timeTransfers[direction] += elapsedTime;
+	}
+
 	void showClusterCounters(std::ofstream &output)
 	{
 		if (ClusterManager::inClusterMode()) {
@@ -68,6 +119,42 @@ namespace Instrument {
 				       << "\trcvd msgs:\t" << countMessagesReceived[type]
 				       << "\trcvd bytes:\t" << bytesMessagesReceived[type] << std::endl;
 			}
+
+			const char *directionStr[2] = {"compress", "decompress"};
+			for (int direction = 0; direction < 2; direction++) {
+				if (countCompressedTransfers[direction] == 0) {
+					continue;
+				}
+
+				const double ratio =
+					(double) bytesUncompressed[direction] / (double) bytesCompressed[direction];
+
+				output << "STATS\t"
+				       << std::left << std::setw(15) << directionStr[direction] << std::setw(0) << std::right
+				       << "\ttransfers:\t" << countCompressedTransfers[direction]
+				       << "\tbytes:\t" << bytesUncompressed[direction]
+				       << "\twire bytes:\t" << bytesCompressed[direction]
+				       << "\tratio:\t" << ratio
+				       << "\ttime (ns):\t" << timeCompression[direction] << std::endl;
+			}
+
+			const char *transferStr[2] = {"data sent", "data received"};
+			for (int direction = 0; direction < 2; direction++) {
+				if (countTransfers[direction] == 0) {
+					continue;
+				}
+
+				// Bytes per microsecond are equivalent to MB/s
+				const double bandwidth = (timeTransfers[direction] > 0) ?
+					(double) bytesTransfers[direction] / (double) timeTransfers[direction] : 0.0;
+
+				output << "STATS\t"
+				       << std::left << std::setw(15) << transferStr[direction] << std::setw(0) << std::right
+				       << "\ttransfers:\t" << countTransfers[direction]
+				       << "\tbytes:\t" << bytesTransfers[direction]
+				       << "\ttime (us):\t" << timeTransfers[direction]
+				       << "\tbandwidth (MB/s):\t" << bandwidth << std::endl;
+			}
 		}
 	}
 
@@ -0,0 +1,31 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef INSTRUMENT_STATS_DEPENDENCY_SUBSYTEM_ENTRY_POINTS_HPP
+#define INSTRUMENT_STATS_DEPENDENCY_SUBSYTEM_ENTRY_POINTS_HPP
+
+#include "InstrumentStats.hpp"
+#include "instrument/api/InstrumentDependencySubsystemEntryPoints.hpp"
+
+
+namespace Instrument {
+
+	inline void enterRegisterTaskDataAcesses() {}
+
+	inline void exitRegisterTaskDataAcesses() {}
+
+	inline void enterUnregisterTaskDataAcesses() {}
+
+	inline void exitUnregisterTaskDataAcesses() {}
+
+	inline void weakAccessFastRelease()
+	{
+		Stats::_weakAccessFastReleases.fetch_add(1, std::memory_order_relaxed);
+	}
+
+}
+
+#endif //INSTRUMENT_STATS_DEPENDENCY_SUBSYTEM_ENTRY_POINTS_HPP
@@ -119,6 +119,7 @@ namespace Instrument {
 		output << "STATS\t" << "Mean thread lifetime\t" << 100.0 * averageThreadTime / totalTime << "\t%" << std::endl;
 		output << "STATS\t" << "Mean thread running time\t" << 100.0 * totalRunningTime / totalThreadTime << "\t%" << std::endl;
 		output << "STATS\t" << "Mean effective parallelism\t" << (double) accumulatedTaskInfo._times._executionTime / (double) totalTime << std::endl;
+		output << "STATS\t" << "Weak accesses released without propagation\t" << _weakAccessFastReleases.load() << std::endl;
 
 		if (accumulatedTaskInfo._numInstances > 0) {
 			output << std::endl;
@@ -17,5 +17,7 @@ namespace Instrument {
 		std::list<ThreadInfo *> _threadInfoList;
 
 		Timer _totalTime(true);
+
+		std::atomic<size_t> _weakAccessFastReleases(0);
 	}
 }
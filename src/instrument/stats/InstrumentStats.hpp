@@ -7,6 +7,7 @@
 #ifndef INSTRUMENT_STATS_HPP
 #define INSTRUMENT_STATS_HPP
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <vector>
@@ -253,6 +254,9 @@ namespace Instrument {
 		extern SpinLock _threadInfoListSpinLock;
 		extern std::list<ThreadInfo *> _threadInfoList;
 		extern Timer _totalTime;
+
+		//! Weak accesses without children released through the fast path
+		extern std::atomic<size_t> _weakAccessFastReleases;
 	}
 }
 
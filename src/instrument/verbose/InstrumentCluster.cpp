@@ -95,6 +95,63 @@ namespace Instrument {
 	{
 	}
 
+	void clusterDataCompressed(
+		void *address,
+		size_t size,
+		size_t compressedSize,
+		size_t codecTime,
+		int peer,
+		bool isSend,
+		InstrumentationContext const &context
+	) {
+		if (!_verboseClusterMessages) {
+			return;
+		}
+
+		LogEntry *logEntry = getLogEntry(context);
+		assert(logEntry != nullptr);
+
+		logEntry->appendLocation(context);
+		logEntry->_contents << (isSend ? " <-> CompressedDataSend" : " <-> CompressedDataReceived")
+			<< " address:" << address
+			<< " size:" << size
+			<< " wireSize:" << compressedSize
+			<< " ratio:" << (double) size / (double) compressedSize
+			<< " codecTime:" << codecTime << "ns"
+			<< (isSend ? " targetNode:" : " sourceNode:") << peer;
+
+		addLogEntry(logEntry);
+	}
+
+	void clusterDataTransferCompleted(
+		void *address,
+		size_t size,
+		size_t elapsedTime,
+		int peer,
+		bool isSend,
+		InstrumentationContext const &context
+	) {
+		if (!_verboseClusterMessages) {
+			return;
+		}
+
+		LogEntry *logEntry = getLogEntry(context);
+		assert(logEntry != nullptr);
+
+		// Bytes per microsecond are equivalent to MB/s
+		const double bandwidth = (elapsedTime > 0) ? (double) size / (double) elapsedTime : 0.0;
+
+		logEntry->appendLocation(context);
+		logEntry->_contents << (isSend ? " <-> DataTransferSent" : " <-> DataTransferReceived")
+			<< " address:" << address
+			<< " size:" << size
+			<< " time:" << elapsedTime << "us"
+			<< " bandwidth:" << bandwidth << "MB/s"
+			<< (isSend ? " targetNode:" : " sourceNode:") << peer;
+
+		addLogEntry(logEntry);
+	}
+
 	void taskIsOffloaded(task_id_t, InstrumentationContext const &)
 	{
 	}
@@ -68,6 +68,17 @@ public:
 		nanos6_je_sdallocx(chunk, size, MALLOCX_NONE);
 	}
 
+	//! There are no NUMA pools, so numaNodeId is ignored
+	static inline void *allocNUMA(size_t size, __attribute__((unused)) size_t numaNodeId)
+	{
+		return alloc(size);
+	}
+
+	static inline void freeNUMA(void *chunk, size_t size, __attribute__((unused)) size_t numaNodeId)
+	{
+		free(chunk, size);
+	}
+
 	// Simplifications for using "new" and "delete" with the allocator
 	template <typename T, typename... Args>
 	static T *newObject(Args &&... args)
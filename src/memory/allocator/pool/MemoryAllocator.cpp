@@ -24,6 +24,7 @@ MemoryAllocator::MemoryAllocator(size_t numaNodeCount, size_t cpuCount) :
 	_globalMemoryPool(numaNodeCount),
 	_localMemoryPool(cpuCount),
 	_externalMemoryPool(),
+	_numaMemoryPool(numaNodeCount),
 	_cacheLineSize(HardwareInfo::getCacheLineSize())
 {
 	assert(cpuCount > 0);
@@ -45,11 +46,18 @@ MemoryAllocator::~MemoryAllocator()
 		}
 	}
 
+	for (auto &it : _numaMemoryPool) {
+		for (auto &it_i : it._pools) {
+			delete it_i.second;
+		}
+	}
+
 	for (auto &it : _globalMemoryPool) {
 		delete it;
 	}
 
 	_localMemoryPool.clear();
+	_numaMemoryPool.clear();
 	_globalMemoryPool.clear();
 }
 
@@ -108,6 +116,27 @@ bool MemoryAllocator::getPool(size_t size, bool useCPUPool, MemoryPool *&pool)
 	return isExternal;
 }
 
+MemoryPool *MemoryAllocator::getNUMAPool(size_t size, size_t numaNodeId)
+{
+	assert(numaNodeId < _numaMemoryPool.size());
+	assert(numaNodeId < _globalMemoryPool.size());
+
+	// Round to the nearest multiple of the cache line size
+	const size_t roundedSize = (size + _cacheLineSize - 1) & ~(_cacheLineSize - 1);
+	const size_t cacheLines = roundedSize / _cacheLineSize;
+	assert (roundedSize > 0);
+
+	size_to_pool_t &pools = _numaMemoryPool[numaNodeId]._pools;
+	auto it = pools.find(cacheLines);
+	if (it == pools.end()) {
+		MemoryPool *pool = new MemoryPool(_globalMemoryPool[numaNodeId], roundedSize);
+		pools[cacheLines] = pool;
+		return pool;
+	}
+
+	return it->second;
+}
+
 void MemoryAllocator::initialize()
 {
 	assert(init == false);
@@ -180,3 +209,29 @@ void MemoryAllocator::free(void *chunk, size_t size, bool useCPUPool)
 		pool->returnChunk(chunk);
 	}
 }
+
+void *MemoryAllocator::allocNUMA(size_t size, size_t numaNodeId)
+{
+	assert(init == true);
+	assert(_singleton != nullptr);
+	assert(numaNodeId < _singleton->_numaMemoryPool.size());
+
+	std::lock_guard<SpinLock> guard(_singleton->_numaMemoryPool[numaNodeId]._lock);
+	MemoryPool *pool = _singleton->getNUMAPool(size, numaNodeId);
+	assert(pool != nullptr);
+
+	return pool->getChunk();
+}
+
+void MemoryAllocator::freeNUMA(void *chunk, size_t size, size_t numaNodeId)
+{
+	assert(init == true);
+	assert(_singleton != nullptr);
+	assert(numaNodeId < _singleton->_numaMemoryPool.size());
+
+	std::lock_guard<SpinLock> guard(_singleton->_numaMemoryPool[numaNodeId]._lock);
+	MemoryPool *pool = _singleton->getNUMAPool(size, numaNodeId);
+	assert(pool != nullptr);
+
+	pool->returnChunk(chunk);
+}
@@ -35,8 +35,19 @@ private:
 	SpinLock _externalMemoryPoolLock;
 	size_to_pool_t _externalMemoryPool;
 
+	struct NUMAMemoryPool {
+		SpinLock _lock;
+		size_to_pool_t _pools;
+	};
+
+	// Pools shared by the CPUs of each NUMA node
+	std::vector<NUMAMemoryPool> _numaMemoryPool;
+
 	bool getPool(size_t size, bool useCPUPool, MemoryPool *&pool);
 
+	// Must be called with the lock of the NUMA pool held
+	MemoryPool *getNUMAPool(size_t size, size_t numaNodeId);
+
 	MemoryAllocator(size_t numaNodeCount, size_t cpuCount);
 	~MemoryAllocator();
 
@@ -55,6 +66,12 @@ public:
 	static void *alloc(size_t size, bool useCPUPool = false);
 	static void free(void *chunk, size_t size, bool useCPUPool = false);
 
+	// Allocate and free from the pool shared by the CPUs of a NUMA node. It
+	// takes a lock, but the chunk can be freed from any CPU as long as it is
+	// returned to the NUMA node it was allocated from
+	static void *allocNUMA(size_t size, size_t numaNodeId);
+	static void freeNUMA(void *chunk, size_t size, size_t numaNodeId);
+
 	static constexpr bool hasUsageStatistics()
 	{
 		return false;
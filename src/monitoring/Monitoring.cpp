@@ -252,6 +252,22 @@ double Monitoring::getPredictedElapsedTime()
 	return 0.0;
 }
 
+double Monitoring::getTaskTimePrediction(Task *task)
+{
+	if (_enabled) {
+		assert(task != nullptr);
+
+		TaskStatistics *taskStatistics = task->getTaskStatistics();
+		assert(taskStatistics != nullptr);
+
+		if (taskStatistics->hasTimePrediction()) {
+			return taskStatistics->getTimePrediction();
+		}
+	}
+
+	return PREDICTION_UNAVAILABLE;
+}
+
 
 //    PRIVATE METHODS    //
 
@@ -153,6 +153,13 @@ public:
 	//! \return An estimation of the time to completion in microseconds
 	static double getPredictedElapsedTime();
 
+	//! \brief Get the predicted elapsed time of a task
+	//!
+	//! \param[in] task The task
+	//!
+	//! \return The prediction in microseconds, or PREDICTION_UNAVAILABLE
+	static double getTaskTimePrediction(Task *task);
+
 };
 
 #endif // MONITORING_HPP
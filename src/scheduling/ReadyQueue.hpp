@@ -43,6 +43,20 @@ public:
 	//! \param[in] unblocked whether it is an unblocked task or not
 	virtual void addReadyTask(Task *task, bool unblocked) = 0;
 
+	//! \brief Add a batch of (ready) tasks that have been created or freed
+	//!
+	//! The result must be the same as adding the tasks one by one in order
+	//!
+	//! \param[in] tasks the tasks to be added
+	//! \param[in] numTasks the number of tasks
+	//! \param[in] unblocked whether they are unblocked tasks or not
+	virtual void addReadyTasks(Task *tasks[], const size_t numTasks, bool unblocked)
+	{
+		for (size_t t = 0; t < numTasks; ++t) {
+			addReadyTask(tasks[t], unblocked);
+		}
+	}
+
 	//! \brief Get a ready task for execution
 	//!
 	//! \returns a ready task or nullptr
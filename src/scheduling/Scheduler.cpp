@@ -4,7 +4,11 @@
 	Copyright (C) 2015-2019 Barcelona Supercomputing Center (BSC)
 */
 
+#include <iostream>
+
 #include "Scheduler.hpp"
+#include "SchedulerStats.hpp"
+#include "support/config/ConfigVariable.hpp"
 #include "system/RuntimeInfo.hpp"
 
 #ifdef USE_CLUSTER
@@ -17,9 +21,12 @@ typedef LocalScheduler instanceScheduler;
 
 
 SchedulerInterface *Scheduler::_instance;
+ConfigVariable<bool> Scheduler::_statsReport("scheduler.stats_report");
 
 void Scheduler::initialize()
 {
+	SchedulerStats::initialize();
+
 	_instance = new instanceScheduler();
 
 	assert(_instance != nullptr);
@@ -28,5 +35,11 @@ void Scheduler::initialize()
 
 void Scheduler::shutdown()
 {
+	if (_statsReport) {
+		SchedulerStats::report(std::cout);
+	}
+
 	delete _instance;
+
+	SchedulerStats::shutdown();
 }
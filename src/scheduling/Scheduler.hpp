@@ -8,6 +8,7 @@
 #define SCHEDULER_HPP
 
 #include "SchedulerInterface.hpp"
+#include "SchedulerStats.hpp"
 #include "system/TrackingPoints.hpp"
 
 #include <InstrumentScheduler.hpp>
@@ -16,6 +17,9 @@
 class Scheduler {
 	static SchedulerInterface *_instance;
 
+	//! Whether the statistics of the scheduler are printed at shutdown
+	static ConfigVariable<bool> _statsReport;
+
 public:
 	static void initialize();
 	static void shutdown();
@@ -32,6 +36,12 @@ public:
 		// Runtime Tracking Point - Tasks will be added to the scheduler and will be ready
 		TrackingPoints::enterAddReadyTasks(tasks, numTasks);
 
+		if (SchedulerInterface::isCriticalPathPriorityEnabled()) {
+			for (size_t t = 0; t < numTasks; ++t) {
+				tasks[t]->applyLookAheadPriority();
+			}
+		}
+
 		_instance->addReadyTasks(taskType, tasks, numTasks, computePlace, hint);
 
 		// Runtime Tracking Point - Exiting the addReadyTasks function
@@ -45,6 +55,10 @@ public:
 		// Runtime Tracking Point - A task will be added to the scheduler and will be readys
 		TrackingPoints::enterAddReadyTask(task);
 
+		if (SchedulerInterface::isCriticalPathPriorityEnabled()) {
+			task->applyLookAheadPriority();
+		}
+
 		_instance->addReadyTask(task, computePlace, hint);
 
 		// Runtime Tracking Point - Exiting the addReadyTasks function
@@ -59,6 +73,10 @@ public:
 		Task *task = _instance->getReadyTask(computePlace);
 		Instrument::exitGetReadyTask();
 
+		if (task != nullptr) {
+			SchedulerStats::taskScheduled(computePlace);
+		}
+
 		return task;
 	}
 
@@ -81,6 +99,18 @@ public:
 	{
 		return SchedulerInterface::isPriorityEnabled();
 	}
+
+	//! \brief Check whether the immediate successor is chosen by data reuse
+	static inline bool isLocalityImmediateSuccessorEnabled()
+	{
+		return SchedulerInterface::isLocalityImmediateSuccessorEnabled();
+	}
+
+	//! \brief Check whether the look-ahead rank of the tasks is used as priority
+	static inline bool isCriticalPathPriorityEnabled()
+	{
+		return SchedulerInterface::isCriticalPathPriorityEnabled();
+	}
 };
 
 #endif // SCHEDULER_HPP
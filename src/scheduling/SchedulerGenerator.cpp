@@ -7,15 +7,24 @@
 #include "SchedulerGenerator.hpp"
 #include "lowlevel/FatalErrorHandler.hpp"
 #include "scheduling/schedulers/HostScheduler.hpp"
+#include "scheduling/schedulers/WorkStealingHostScheduler.hpp"
 #include "scheduling/schedulers/device/DeviceScheduler.hpp"
 
 HostScheduler *SchedulerGenerator::createHostScheduler(
 	size_t totalComputePlaces,
 	SchedulingPolicy policy,
 	bool enablePriority,
-	bool enableImmediateSuccessor)
+	bool enableImmediateSuccessor,
+	bool enableNUMAQueues,
+	bool enableWorkStealing)
 {
-	return new HostScheduler(totalComputePlaces, policy, enablePriority, enableImmediateSuccessor);
+	if (enableWorkStealing) {
+		return new WorkStealingHostScheduler(totalComputePlaces, policy, enablePriority,
+			enableImmediateSuccessor, enableNUMAQueues);
+	}
+
+	return new HostScheduler(totalComputePlaces, policy, enablePriority,
+		enableImmediateSuccessor, enableNUMAQueues);
 }
 
 DeviceScheduler *SchedulerGenerator::createDeviceScheduler(
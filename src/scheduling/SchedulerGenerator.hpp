@@ -20,7 +20,9 @@ public:
 		size_t totalComputePlaces,
 		SchedulingPolicy policy,
 		bool enablePriority,
-		bool enableImmediateSuccessor);
+		bool enableImmediateSuccessor,
+		bool enableNUMAQueues,
+		bool enableWorkStealing);
 
 	static DeviceScheduler *createDeviceScheduler(
 		size_t totalComputePlaces,
@@ -18,14 +18,26 @@
 ConfigVariable<std::string> SchedulerInterface::_schedulingPolicy("scheduler.policy");
 ConfigVariable<bool> SchedulerInterface::_enableImmediateSuccessor("scheduler.immediate_successor");
 ConfigVariable<bool> SchedulerInterface::_enablePriority("scheduler.priority");
+ConfigVariable<bool> SchedulerInterface::_enableWorkStealing("scheduler.work_stealing");
+ConfigVariable<bool> SchedulerInterface::_enableLocalityImmediateSuccessor("scheduler.locality_immediate_successor");
+ConfigVariable<bool> SchedulerInterface::_enableCriticalPathPriority("scheduler.critical_path_priority");
 
 
 SchedulerInterface::SchedulerInterface()
 {
+	// The "numa-" variants keep a ready queue per NUMA node in the host
+	// scheduler. Devices always use a single ready queue
+	std::string policyName = _schedulingPolicy.getValue();
+	bool enableNUMAQueues = false;
+	if (policyName.compare(0, 5, "numa-") == 0) {
+		enableNUMAQueues = true;
+		policyName = policyName.substr(5);
+	}
+
 	SchedulingPolicy policy;
-	if (_schedulingPolicy.getValue() == "fifo") {
+	if (policyName == "fifo") {
 		policy = FIFO_POLICY;
-	} else if (_schedulingPolicy.getValue() == "lifo") {
+	} else if (policyName == "lifo") {
 		policy = LIFO_POLICY;
 	} else {
 		FatalErrorHandler::fail("Invalid scheduling policy ", _schedulingPolicy.getValue());
@@ -38,7 +50,7 @@ SchedulerInterface::SchedulerInterface()
 	computePlaceCount = CPUManager::getTotalCPUs();
 	_hostScheduler = SchedulerGenerator::createHostScheduler(
 		computePlaceCount, policy, _enablePriority,
-		_enableImmediateSuccessor);
+		_enableImmediateSuccessor, enableNUMAQueues, _enableWorkStealing);
 
 	const size_t totalDevices = (nanos6_device_t::nanos6_device_type_num);
 
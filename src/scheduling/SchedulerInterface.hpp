@@ -24,6 +24,9 @@ class SchedulerInterface {
 	static ConfigVariable<std::string> _schedulingPolicy;
 	static ConfigVariable<bool> _enableImmediateSuccessor;
 	static ConfigVariable<bool> _enablePriority;
+	static ConfigVariable<bool> _enableWorkStealing;
+	static ConfigVariable<bool> _enableLocalityImmediateSuccessor;
+	static ConfigVariable<bool> _enableCriticalPathPriority;
 
 #ifdef EXTRAE_ENABLED
 	std::atomic<Task *> _mainTask;
@@ -113,6 +116,18 @@ public:
 	{
 		return _enablePriority;
 	}
+
+	//! \brief Check whether the immediate successor is chosen by data reuse
+	static inline bool isLocalityImmediateSuccessorEnabled()
+	{
+		return _enableImmediateSuccessor && _enableLocalityImmediateSuccessor;
+	}
+
+	//! \brief Check whether the look-ahead rank of the tasks is used as priority
+	static inline bool isCriticalPathPriorityEnabled()
+	{
+		return _enablePriority && _enableCriticalPathPriority;
+	}
 };
 
 #endif // SCHEDULER_INTERFACE_HPP
@@ -0,0 +1,136 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <algorithm>
+#include <iomanip>
+
+#include "SchedulerStats.hpp"
+#include "executors/threads/CPUManager.hpp"
+#include "support/config/ConfigVariable.hpp"
+
+#include <MemoryAllocator.hpp>
+
+
+SchedulerStats::slot_t *SchedulerStats::_slots = nullptr;
+size_t SchedulerStats::_numSlots = 0;
+bool SchedulerStats::_lockTimes = false;
+
+
+SchedulerStats::Counters::Counters() :
+	_shared(false),
+	_lockRequests(0),
+	_lockWaitTime(0),
+	_serverTurns(0),
+	_lockHoldTime(0),
+	_addQueueOverflows(0),
+	_readyQueueSamples(0),
+	_readyQueueDepthSum(0),
+	_readyQueueDepthMax(0),
+	_scheduledTasks(0),
+	_immediateSuccessorHits(0)
+{
+	for (size_t i = 0; i < NANOS6_SCHEDULER_STATS_HISTOGRAM_SIZE; ++i) {
+		_servedTasks[i] = 0;
+	}
+}
+
+void SchedulerStats::initialize()
+{
+	assert(_slots == nullptr);
+
+	// A slot per CPU and the shared slot
+	_numSlots = CPUManager::getTotalCPUs() + 1;
+	_slots = (slot_t *) MemoryAllocator::alloc(_numSlots * sizeof(slot_t));
+	assert(_slots != nullptr);
+
+	for (size_t i = 0; i < _numSlots; ++i) {
+		new (&_slots[i]) slot_t();
+	}
+	_slots[_numSlots - 1]._shared = true;
+
+	ConfigVariable<bool> lockTimes("scheduler.stats_lock_times");
+	_lockTimes = lockTimes.getValue();
+}
+
+void SchedulerStats::shutdown()
+{
+	assert(_slots != nullptr);
+
+	for (size_t i = 0; i < _numSlots; ++i) {
+		_slots[i].~slot_t();
+	}
+	MemoryAllocator::free(_slots, _numSlots * sizeof(slot_t));
+	_slots = nullptr;
+	_numSlots = 0;
+}
+
+void SchedulerStats::getStats(nanos6_scheduler_stats_t &stats)
+{
+	stats = nanos6_scheduler_stats_t();
+	if (_slots == nullptr) {
+		return;
+	}
+
+	for (size_t i = 0; i < _numSlots; ++i) {
+		Counters const &slot = _slots[i];
+
+		stats.lock_requests += slot._lockRequests.load(std::memory_order_relaxed);
+		stats.lock_wait_time += slot._lockWaitTime.load(std::memory_order_relaxed);
+		stats.server_turns += slot._serverTurns.load(std::memory_order_relaxed);
+		stats.lock_hold_time += slot._lockHoldTime.load(std::memory_order_relaxed);
+		for (size_t b = 0; b < NANOS6_SCHEDULER_STATS_HISTOGRAM_SIZE; ++b) {
+			stats.served_tasks_histogram[b] += slot._servedTasks[b].load(std::memory_order_relaxed);
+		}
+		stats.add_queue_overflows += slot._addQueueOverflows.load(std::memory_order_relaxed);
+		stats.ready_queue_samples += slot._readyQueueSamples.load(std::memory_order_relaxed);
+		stats.ready_queue_depth_sum += slot._readyQueueDepthSum.load(std::memory_order_relaxed);
+		stats.ready_queue_depth_max = std::max(stats.ready_queue_depth_max,
+			(unsigned long) slot._readyQueueDepthMax.load(std::memory_order_relaxed));
+		stats.scheduled_tasks += slot._scheduledTasks.load(std::memory_order_relaxed);
+		stats.immediate_successor_hits += slot._immediateSuccessorHits.load(std::memory_order_relaxed);
+	}
+}
+
+void SchedulerStats::report(std::ostream &output)
+{
+	nanos6_scheduler_stats_t stats;
+	getStats(stats);
+
+	auto average = [](unsigned long total, unsigned long count) -> double {
+		return (count > 0) ? (double) total / count : 0.0;
+	};
+
+	output << std::fixed << std::setprecision(2);
+	output << "+-----------------------------+" << std::endl;
+	output << "|    SCHEDULER STATISTICS     |" << std::endl;
+	output << "+-----------------------------+" << std::endl;
+	output << "Lock requests: " << stats.lock_requests
+		<< ", average wait: " << average(stats.lock_wait_time, stats.lock_requests) / 1000.0 << " us" << std::endl;
+	output << "Server turns: " << stats.server_turns
+		<< ", average hold: " << average(stats.lock_hold_time, stats.server_turns) / 1000.0 << " us" << std::endl;
+
+	output << "Server turns by served tasks:";
+	for (size_t b = 0; b < NANOS6_SCHEDULER_STATS_HISTOGRAM_SIZE; ++b) {
+		const size_t low = (b == 0) ? 0 : (1UL << (b - 1));
+		output << " [" << low;
+		if (b == NANOS6_SCHEDULER_STATS_HISTOGRAM_SIZE - 1) {
+			output << "+";
+		} else if (b > 1) {
+			output << "-" << (1UL << b) - 1;
+		}
+		output << "]=" << stats.served_tasks_histogram[b];
+	}
+	output << std::endl;
+
+	output << "Add queue overflows: " << stats.add_queue_overflows << std::endl;
+	output << "Ready queue depth: average " << average(stats.ready_queue_depth_sum, stats.ready_queue_samples)
+		<< ", max " << stats.ready_queue_depth_max << std::endl;
+	output << "Scheduled tasks: " << stats.scheduled_tasks
+		<< ", immediate successor hits: " << stats.immediate_successor_hits
+		<< " (" << 100.0 * average(stats.immediate_successor_hits, stats.scheduled_tasks) << "%)" << std::endl;
+	output << "+-----------------------------+" << std::endl;
+	output.unsetf(std::ios_base::floatfield);
+}
@@ -0,0 +1,168 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef SCHEDULER_STATS_HPP
+#define SCHEDULER_STATS_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <ostream>
+
+#include "hardware/places/ComputePlace.hpp"
+#include "lowlevel/Padding.hpp"
+#include "support/chronometers/std/Chrono.hpp"
+
+#include "api/nanos6/runtime-info.h"
+
+
+//! \brief Counters of the scheduler that are always gathered
+//!
+//! Each CPU updates the counters of its own slot, which is padded to a
+//! cache line, so the counters are cheap to update. The rest of compute
+//! places, such as external threads and devices, share an additional
+//! slot. The counters are only added up when they are queried. The times
+//! of the scheduler lock are only measured when scheduler.stats_lock_times
+//! is enabled
+class SchedulerStats {
+	struct Counters {
+		//! Whether several compute places update the slot
+		bool _shared;
+
+		std::atomic<uint64_t> _lockRequests;
+		std::atomic<uint64_t> _lockWaitTime;
+		std::atomic<uint64_t> _serverTurns;
+		std::atomic<uint64_t> _lockHoldTime;
+		std::atomic<uint64_t> _servedTasks[NANOS6_SCHEDULER_STATS_HISTOGRAM_SIZE];
+		std::atomic<uint64_t> _addQueueOverflows;
+		std::atomic<uint64_t> _readyQueueSamples;
+		std::atomic<uint64_t> _readyQueueDepthSum;
+		std::atomic<uint64_t> _readyQueueDepthMax;
+		std::atomic<uint64_t> _scheduledTasks;
+		std::atomic<uint64_t> _immediateSuccessorHits;
+
+		Counters();
+	};
+
+	typedef Padded<Counters> slot_t;
+
+	//! Slots of the CPUs, followed by the shared slot
+	static slot_t *_slots;
+	static size_t _numSlots;
+
+	//! Whether the times of the scheduler lock are measured
+	static bool _lockTimes;
+
+	static inline Counters &getSlot(ComputePlace *computePlace)
+	{
+		assert(_slots != nullptr);
+
+		if (computePlace != nullptr
+			&& computePlace->getType() == nanos6_host_device
+			&& (size_t) computePlace->getIndex() < _numSlots - 1
+		) {
+			return _slots[computePlace->getIndex()];
+		}
+		return _slots[_numSlots - 1];
+	}
+
+	//! \brief Add a value to a counter of a slot
+	//!
+	//! Only the owner of a CPU slot updates it, so a load and a store are
+	//! enough. The shared slot needs an atomic read-modify-write
+	static inline void add(Counters &slot, std::atomic<uint64_t> &counter, uint64_t value)
+	{
+		if (slot._shared) {
+			counter.fetch_add(value, std::memory_order_relaxed);
+		} else {
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+	}
+
+public:
+	static void initialize();
+	static void shutdown();
+
+	//! \brief Get the current time in nanoseconds to measure the lock times
+	//!
+	//! \returns the time, or zero if the lock times are not measured
+	static inline uint64_t now()
+	{
+		if (!_lockTimes) {
+			return 0;
+		}
+		return Chrono::now<uint64_t, std::nano>();
+	}
+
+	//! \brief A compute place got the scheduler lock or was served after waiting
+	static inline void lockWaited(ComputePlace *computePlace, uint64_t time)
+	{
+		Counters &slot = getSlot(computePlace);
+		add(slot, slot._lockRequests, 1);
+		add(slot, slot._lockWaitTime, time);
+	}
+
+	//! \brief A compute place released the scheduler lock after serving tasks
+	//!
+	//! \param[in] computePlace the server
+	//! \param[in] time the time that the lock was held
+	//! \param[in] servedTasks the tasks served to other compute places and to itself
+	static inline void serverTurn(ComputePlace *computePlace, uint64_t time, size_t servedTasks)
+	{
+		size_t bucket = 0;
+		while (servedTasks > 0 && bucket < NANOS6_SCHEDULER_STATS_HISTOGRAM_SIZE - 1) {
+			servedTasks >>= 1;
+			++bucket;
+		}
+
+		Counters &slot = getSlot(computePlace);
+		add(slot, slot._serverTurns, 1);
+		add(slot, slot._lockHoldTime, time);
+		add(slot, slot._servedTasks[bucket], 1);
+	}
+
+	//! \brief An add queue was full and its tasks had to wait for a server
+	static inline void addQueueOverflow(ComputePlace *computePlace)
+	{
+		Counters &slot = getSlot(computePlace);
+		add(slot, slot._addQueueOverflows, 1);
+	}
+
+	//! \brief Sample the number of tasks in the ready queue
+	static inline void readyQueueDepth(ComputePlace *computePlace, size_t depth)
+	{
+		Counters &slot = getSlot(computePlace);
+		add(slot, slot._readyQueueSamples, 1);
+		add(slot, slot._readyQueueDepthSum, depth);
+
+		// Only the server updates the maximum of its slot
+		if (depth > slot._readyQueueDepthMax.load(std::memory_order_relaxed)) {
+			slot._readyQueueDepthMax.store(depth, std::memory_order_relaxed);
+		}
+	}
+
+	//! \brief A compute place obtained a task from the scheduler
+	static inline void taskScheduled(ComputePlace *computePlace)
+	{
+		Counters &slot = getSlot(computePlace);
+		add(slot, slot._scheduledTasks, 1);
+	}
+
+	//! \brief A compute place obtained its own immediate successor
+	static inline void immediateSuccessorHit(ComputePlace *computePlace)
+	{
+		Counters &slot = getSlot(computePlace);
+		add(slot, slot._immediateSuccessorHits, 1);
+	}
+
+	//! \brief Add up the counters of all the slots
+	static void getStats(nanos6_scheduler_stats_t &stats);
+
+	//! \brief Print the statistics in a human readable format
+	static void report(std::ostream &output);
+};
+
+#endif // SCHEDULER_STATS_HPP
@@ -0,0 +1,205 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef AFFINITY_QUEUES_HPP
+#define AFFINITY_QUEUES_HPP
+
+#include <cassert>
+#include <cstdint>
+
+#include "executors/threads/CPU.hpp"
+#include "support/Containers.hpp"
+#include "support/chronometers/std/Chrono.hpp"
+#include "tasks/Task.hpp"
+
+//! \brief Ready queues of the tasks with an affinity hint
+//!
+//! There is a FIFO queue per CPU and per NUMA node, and each of them is split
+//! in the strict and the preferred tasks. A CPU serves the tasks of its own
+//! queues, and the preferred tasks of any queue can be spilled to another CPU
+//! once they have waited for longer than the spill time. The tasks keep their
+//! arrival time, so the spilled task is always the oldest one
+class AffinityQueues {
+	struct Entry {
+		Task *_task;
+		uint64_t _arrival;
+
+		inline Entry(Task *task, uint64_t arrival) :
+			_task(task),
+			_arrival(arrival)
+		{
+		}
+	};
+
+	typedef Container::deque<Entry> queue_t;
+
+	//! Strict and preferred queues
+	struct QueuePair {
+		queue_t _strict;
+		queue_t _preferred;
+	};
+
+	//! Queues of each CPU, indexed by CPU index
+	Container::vector<QueuePair> _cpuQueues;
+
+	//! Queues of each NUMA node
+	Container::vector<QueuePair> _numaQueues;
+
+	//! Number of tasks in all the queues
+	size_t _numTasks;
+
+	//! Number of preferred tasks in all the queues
+	size_t _numPreferred;
+
+	//! Time in microseconds after which a preferred task can be spilled
+	uint64_t _spillTime;
+
+	static inline Task *pop(queue_t &queue)
+	{
+		assert(!queue.empty());
+
+		Task *task = queue.front()._task;
+		queue.pop_front();
+		return task;
+	}
+
+	//! \brief Get a task from a pair of queues, the strict ones first
+	inline Task *getTask(QueuePair &queues)
+	{
+		if (!queues._strict.empty()) {
+			--_numTasks;
+			return pop(queues._strict);
+		}
+		if (!queues._preferred.empty()) {
+			--_numTasks;
+			--_numPreferred;
+			return pop(queues._preferred);
+		}
+		return nullptr;
+	}
+
+	//! \brief Check whether the head of a preferred queue is older
+	inline static void checkOldest(queue_t &queue, queue_t *&oldest)
+	{
+		if (!queue.empty()) {
+			if (oldest == nullptr || queue.front()._arrival < oldest->front()._arrival) {
+				oldest = &queue;
+			}
+		}
+	}
+
+public:
+	inline AffinityQueues(size_t numCPUs, size_t numNUMANodes, uint64_t spillTime) :
+		_cpuQueues(numCPUs),
+		_numaQueues(numNUMANodes),
+		_numTasks(0),
+		_numPreferred(0),
+		_spillTime(spillTime)
+	{
+	}
+
+	inline ~AffinityQueues()
+	{
+		assert(_numTasks == 0);
+	}
+
+	inline size_t getNumTasks() const
+	{
+		return _numTasks;
+	}
+
+	//! \brief Add a ready task with an affinity hint
+	//!
+	//! \param[in] task the task, which has an affinity to a CPU or a NUMA node
+	//!
+	//! \returns false if the target of the task is not known by the queues
+	inline bool addTask(Task *task)
+	{
+		assert(task != nullptr);
+		assert(task->hasAffinity());
+
+		const int cpuId = task->getAffinityCPU();
+		const int numaId = task->getAffinityNUMANode();
+
+		QueuePair *queues;
+		if (cpuId >= 0 && (size_t) cpuId < _cpuQueues.size()) {
+			queues = &_cpuQueues[cpuId];
+		} else if (numaId >= 0 && (size_t) numaId < _numaQueues.size()) {
+			queues = &_numaQueues[numaId];
+		} else {
+			return false;
+		}
+
+		// Only the preferred tasks need their arrival time
+		if (task->hasStrictAffinity()) {
+			queues->_strict.emplace_back(task, 0);
+		} else {
+			queues->_preferred.emplace_back(task, Chrono::now<uint64_t>());
+			++_numPreferred;
+		}
+		++_numTasks;
+
+		return true;
+	}
+
+	//! \brief Get a task with affinity to a CPU or to its NUMA node
+	//!
+	//! \param[in] cpu the CPU asking for a task
+	//!
+	//! \returns a task or nullptr
+	inline Task *getTask(CPU *cpu)
+	{
+		assert(cpu != nullptr);
+
+		if (_numTasks == 0) {
+			return nullptr;
+		}
+
+		const size_t cpuId = cpu->getIndex();
+		if (cpuId < _cpuQueues.size()) {
+			Task *task = getTask(_cpuQueues[cpuId]);
+			if (task != nullptr) {
+				return task;
+			}
+		}
+
+		const size_t numaId = cpu->getNumaNodeId();
+		if (numaId < _numaQueues.size()) {
+			return getTask(_numaQueues[numaId]);
+		}
+		return nullptr;
+	}
+
+	//! \brief Get the oldest preferred task if it has waited for longer
+	//! than the spill time
+	//!
+	//! \returns a task or nullptr
+	inline Task *getSpilledTask()
+	{
+		if (_numPreferred == 0) {
+			return nullptr;
+		}
+
+		queue_t *oldest = nullptr;
+		for (QueuePair &queues : _cpuQueues) {
+			checkOldest(queues._preferred, oldest);
+		}
+		for (QueuePair &queues : _numaQueues) {
+			checkOldest(queues._preferred, oldest);
+		}
+		assert(oldest != nullptr);
+
+		if (Chrono::now<uint64_t>() - oldest->front()._arrival < _spillTime) {
+			return nullptr;
+		}
+
+		--_numTasks;
+		--_numPreferred;
+		return pop(*oldest);
+	}
+};
+
+#endif // AFFINITY_QUEUES_HPP
@@ -7,47 +7,279 @@
 #ifndef DEADLINE_QUEUE_HPP
 #define DEADLINE_QUEUE_HPP
 
+#include <cstdint>
+
+#include "MemoryAllocator.hpp"
 #include "scheduling/ReadyQueue.hpp"
 #include "support/Containers.hpp"
 #include "support/chronometers/std/Chrono.hpp"
 #include "tasks/Task.hpp"
 
 //! This kind of ready queue supports deadlines
+//!
+//! The deadline tasks are kept in a hierarchical timing wheel. Each slot of
+//! the first level spans a microsecond, and each slot of the next levels spans
+//! a whole turn of the previous level. A task is placed in the first level in
+//! which its deadline differs from the current time of the wheel, so adding a
+//! task is constant time. When the wheel advances, the slots of the upper
+//! levels are cascaded to the lower ones and the slots of the first level
+//! expire. The non-empty slots are tracked with a bitmask per level, so the
+//! wheel jumps directly to the next non-empty slot. The tasks are linked
+//! through nodes taken from a pool owned by the queue, so the hot path does not
+//! allocate memory once the pool has grown enough
 class DeadlineQueue : public ReadyQueue {
-	//! Deadline compare function
-	struct DeadlineCompare {
-		bool operator() (const Task *left, const Task *right) const
+	//! Bits of the deadline that index the slots of each level
+	static const size_t SLOT_BITS = 6;
+	static const size_t NUM_SLOTS = (1 << SLOT_BITS);
+	static const size_t SLOT_MASK = NUM_SLOTS - 1;
+
+	//! Number of levels, which span 2^24 microseconds (around 16 seconds).
+	//! Farther deadlines wait in the overflow list
+	static const size_t NUM_LEVELS = 4;
+
+	//! Number of nodes allocated at once when the pool is empty
+	static const size_t NODES_PER_CHUNK = 64;
+
+	struct Node {
+		Task *_task;
+		Node *_next;
+	};
+
+	//! Singly linked list of nodes
+	struct NodeList {
+		Node *_head;
+		Node *_tail;
+
+		inline NodeList() :
+			_head(nullptr),
+			_tail(nullptr)
+		{
+		}
+
+		inline bool empty() const
 		{
-			if (left->getDeadline() != right->getDeadline()) {
-				return (left->getDeadline() < right->getDeadline());
+			return (_head == nullptr);
+		}
+
+		inline void push(Node *node)
+		{
+			node->_next = nullptr;
+			if (_tail == nullptr) {
+				_head = node;
+			} else {
+				_tail->_next = node;
+			}
+			_tail = node;
+		}
+
+		inline Node *pop()
+		{
+			Node *node = _head;
+			if (node != nullptr) {
+				_head = node->_next;
+				if (_head == nullptr) {
+					_tail = nullptr;
+				}
 			}
-			return (left < right);
+			return node;
+		}
+
+		//! \brief Move all the nodes of another list to the end of this one
+		inline void splice(NodeList &other)
+		{
+			if (other.empty()) {
+				return;
+			}
+			if (_tail == nullptr) {
+				_head = other._head;
+			} else {
+				_tail->_next = other._head;
+			}
+			_tail = other._tail;
+			other._head = other._tail = nullptr;
+		}
+
+		//! \brief Take all the nodes of the list, leaving it empty
+		inline Node *takeAll()
+		{
+			Node *node = _head;
+			_head = _tail = nullptr;
+			return node;
 		}
 	};
 
-	//! Set of deadline tasks ordered by their task deadline
-	//! in ascending order. Tasks with the lowest deadline
-	//! are stored at the first positions. It also allows
-	//! different tasks to share the same deadline
-	typedef Container::set<Task *, DeadlineCompare> deadline_set_t;
+	//! The slots of each level and the bitmasks of the non-empty slots. They
+	//! are mutable since advancing the wheel does not change the tasks of the
+	//! queue, just where they are placed
+	mutable NodeList _slots[NUM_LEVELS][NUM_SLOTS];
+	mutable uint64_t _occupied[NUM_LEVELS];
 
-	//! The ordered set of deadline tasks
-	deadline_set_t _deadlineTasks;
+	//! Tasks with a deadline beyond the last level
+	mutable NodeList _overflow;
+
+	//! Tasks whose deadline has expired, in order of deadline
+	mutable NodeList _expired;
+	mutable size_t _numExpired;
+
+	//! Current time of the wheel. The deadlines of the tasks in the wheel are
+	//! all later, and the slots of the current time are empty in all levels
+	mutable Task::deadline_t _current;
+
+	//! Total number of tasks in the queue
+	size_t _numTasks;
+
+	//! Pool of free nodes and the chunks of memory that contain them
+	Node *_freeNodes;
+	Container::vector<Node *> _chunks;
 
 	//! The cached current time point (may be stale)
 	mutable Task::deadline_t _now;
 
+	static inline size_t getSlot(Task::deadline_t deadline, size_t level)
+	{
+		return (deadline >> (level * SLOT_BITS)) & SLOT_MASK;
+	}
+
+	inline Node *allocateNode()
+	{
+		if (_freeNodes == nullptr) {
+			Node *chunk = (Node *) MemoryAllocator::alloc(NODES_PER_CHUNK * sizeof(Node));
+			assert(chunk != nullptr);
+			_chunks.push_back(chunk);
+
+			for (size_t i = 0; i < NODES_PER_CHUNK; ++i) {
+				chunk[i]._next = _freeNodes;
+				_freeNodes = &chunk[i];
+			}
+		}
+
+		Node *node = _freeNodes;
+		_freeNodes = node->_next;
+		return node;
+	}
+
+	inline void freeNode(Node *node)
+	{
+		node->_next = _freeNodes;
+		_freeNodes = node;
+	}
+
+	//! \brief Place a node in the wheel relative to its current time
+	inline void place(Node *node) const
+	{
+		const Task::deadline_t deadline = node->_task->getDeadline();
+		if (deadline <= _current) {
+			_expired.push(node);
+			++_numExpired;
+			return;
+		}
+
+		// The level is given by the most significant bit that differs
+		const size_t level = (63 - __builtin_clzll(deadline ^ _current)) / SLOT_BITS;
+		if (level >= NUM_LEVELS) {
+			_overflow.push(node);
+			return;
+		}
+
+		const size_t slot = getSlot(deadline, level);
+		assert(slot != getSlot(_current, level));
+
+		_slots[level][slot].push(node);
+		_occupied[level] |= (1ULL << slot);
+	}
+
+	//! \brief Place again all the nodes of a list
+	inline void replace(NodeList &list) const
+	{
+		Node *node = list.takeAll();
+		while (node != nullptr) {
+			Node *next = node->_next;
+			place(node);
+			node = next;
+		}
+	}
+
+	//! \brief Advance the wheel up to a time, expiring the tasks with a
+	//! deadline that is not later than it
+	inline void advance(Task::deadline_t now) const
+	{
+		while (now > _current) {
+			// Find the lowest level with a non-empty slot after the current
+			// one. Its first slot is the next point in which the wheel changes
+			size_t level = 0;
+			uint64_t pending = 0;
+			for (; level < NUM_LEVELS; ++level) {
+				const size_t currentSlot = getSlot(_current, level);
+				pending = (currentSlot == SLOT_MASK) ? 0 : (_occupied[level] & (~0ULL << (currentSlot + 1)));
+				if (pending != 0) {
+					break;
+				}
+			}
+
+			const size_t shift = level * SLOT_BITS;
+			Task::deadline_t next;
+			if (level < NUM_LEVELS) {
+				// The start of the slot within the current turn of the level
+				const size_t slot = __builtin_ctzll(pending);
+				const Task::deadline_t turn = (_current >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+				next = turn | ((Task::deadline_t) slot << shift);
+			} else if (!_overflow.empty()) {
+				// The start of the next turn of the last level
+				next = ((_current >> shift) + 1) << shift;
+			} else {
+				// The wheel is empty
+				_current = now;
+				return;
+			}
+
+			if (next > now) {
+				return;
+			}
+
+			_current = next;
+			if (level < NUM_LEVELS) {
+				const size_t slot = getSlot(next, level);
+				_occupied[level] &= ~(1ULL << slot);
+				if (level == 0) {
+					// The tasks of a first level slot expire all together
+					NodeList &expiring = _slots[0][slot];
+					for (Node *node = expiring._head; node != nullptr; node = node->_next) {
+						++_numExpired;
+					}
+					_expired.splice(expiring);
+				} else {
+					replace(_slots[level][slot]);
+				}
+			} else {
+				replace(_overflow);
+			}
+		}
+	}
+
 public:
 	inline DeadlineQueue(SchedulingPolicy policy) :
 		ReadyQueue(policy),
-		_deadlineTasks(),
+		_overflow(),
+		_expired(),
+		_numExpired(0),
+		_numTasks(0),
+		_freeNodes(nullptr),
+		_chunks(),
 		_now(Chrono::now<Task::deadline_t>())
 	{
+		for (size_t level = 0; level < NUM_LEVELS; ++level) {
+			_occupied[level] = 0;
+		}
+		_current = _now;
 	}
 
 	inline ~DeadlineQueue()
 	{
-		assert(_deadlineTasks.empty());
+		assert(_numTasks == 0);
+
+		for (Node *chunk : _chunks) {
+			MemoryAllocator::free(chunk, NODES_PER_CHUNK * sizeof(Node));
+		}
 	}
 
 	//! \brief Add ready task with deadline
@@ -62,12 +294,11 @@ public:
 	{
 		assert(task->hasDeadline());
 
-#ifndef NDEBUG
-		auto res = _deadlineTasks.insert(task);
-		assert(res.second);
-#else
-		_deadlineTasks.insert(task);
-#endif
+		Node *node = allocateNode();
+		node->_task = task;
+		place(node);
+
+		++_numTasks;
 	}
 
 	//! \brief Get a ready task with the deadline satisfied
@@ -75,46 +306,45 @@ public:
 	//! \param computePlace The current compute place
 	inline Task *getReadyTask(ComputePlace *)
 	{
-		if (_deadlineTasks.empty())
+		if (_numTasks == 0)
 			return nullptr;
 
-		auto it = _deadlineTasks.begin();
-		assert(it != _deadlineTasks.end());
-
-		Task *task = *it;
-		assert(task != nullptr);
-
 		// First check using the cached current time
 		// and then using the updated current time
-		if (task->getDeadline() <= _now) {
-			_deadlineTasks.erase(it);
-			return task;
-		} else {
-			_now = Chrono::now<Task::deadline_t>();
-			if (task->getDeadline() < _now) {
-				_deadlineTasks.erase(it);
-				return task;
+		if (_expired.empty()) {
+			advance(_now);
+			if (_expired.empty()) {
+				_now = Chrono::now<Task::deadline_t>();
+				advance(_now);
+				if (_expired.empty()) {
+					return nullptr;
+				}
 			}
 		}
-		return nullptr;
+
+		Node *node = _expired.pop();
+		assert(node != nullptr);
+		assert(_numExpired > 0);
+		--_numExpired;
+		--_numTasks;
+
+		Task *task = node->_task;
+		assert(task != nullptr);
+		freeNode(node);
+
+		return task;
 	}
 
 	//! \brief Get the number of available deadline tasks
 	inline size_t getNumReadyTasks() const
 	{
-		if (_deadlineTasks.empty())
+		if (_numTasks == 0)
 			return 0;
 
 		_now = Chrono::now<Task::deadline_t>();
+		advance(_now);
 
-		size_t numReady = 0;
-		for (Task *task : _deadlineTasks) {
-			if (task->getDeadline() > _now)
-				break;
-
-			++numReady;
-		}
-		return numReady;
+		return _numExpired;
 	}
 };
 
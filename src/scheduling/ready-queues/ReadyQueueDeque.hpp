@@ -7,6 +7,8 @@
 #ifndef READY_QUEUE_DEQUE_HPP
 #define READY_QUEUE_DEQUE_HPP
 
+#include <iterator>
+
 #include "scheduling/ReadyQueue.hpp"
 #include "support/Containers.hpp"
 
@@ -34,6 +36,18 @@ public:
 		}
 	}
 
+	void addReadyTasks(Task *tasks[], const size_t numTasks, bool unblocked)
+	{
+		if (unblocked || _policy == SchedulingPolicy::LIFO_POLICY) {
+			// Pushing them one by one to the front reverses their order
+			_readyDeque.insert(_readyDeque.begin(),
+				std::reverse_iterator<Task **>(tasks + numTasks),
+				std::reverse_iterator<Task **>(tasks));
+		} else {
+			_readyDeque.insert(_readyDeque.end(), tasks, tasks + numTasks);
+		}
+	}
+
 	Task *getReadyTask(ComputePlace *)
 	{
 		if (_readyDeque.empty()) {
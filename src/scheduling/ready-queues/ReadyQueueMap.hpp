@@ -7,72 +7,285 @@
 #ifndef READY_QUEUE_MAP_HPP
 #define READY_QUEUE_MAP_HPP
 
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include <MemoryAllocator.hpp>
+
 #include "scheduling/ReadyQueue.hpp"
 #include "support/Containers.hpp"
 #include "tasks/Task.hpp"
 
-// This kind of ready queue supports priorities
+//! \brief Ready queue that supports priorities
+//!
+//! The tasks of each priority are kept in a level, which is looked up in a
+//! hash map. A max-heap keeps the priorities of the non-empty levels, so that
+//! the highest level is always known. Adding a task to an existing level and
+//! getting a task are constant-time operations; only activating a level or
+//! emptying one costs a heap operation, logarithmic in the number of distinct
+//! priorities that have ready tasks.
+//!
+//! The queue is used while holding the scheduler lock, so empty levels are
+//! not freed. They stay indexed by their priority as idle levels, and a
+//! priority that becomes ready again reuses its level and its hash node
+//! without allocating. A new priority takes an idle level instead, and only
+//! allocates when there are none. Some idle levels are preallocated when the
+//! queue is created, and they are only freed when there are too many
 class ReadyQueueMap : public ReadyQueue {
 	typedef Container::deque<Task *> ready_queue_t;
-	typedef Container::map<Task::priority_t, ready_queue_t, std::greater<Task::priority_t>> ready_map_t;
 
-	ready_map_t _readyMap;
+	struct PriorityLevel {
+		Task::priority_t _priority;
+
+		//! Whether the level has tasks and its priority is in the heap
+		bool _active;
+
+		//! Whether the level is in the map under its priority
+		bool _indexed;
+
+		//! Position of the level in the idle levels while it is idle
+		size_t _idleIndex;
+
+		ready_queue_t _tasks;
+
+		PriorityLevel() :
+			_priority(0),
+			_active(false),
+			_indexed(false),
+			_idleIndex(0),
+			_tasks()
+		{
+		}
+	};
+
+	typedef Container::unordered_map<Task::priority_t, PriorityLevel *> level_map_t;
+	typedef Container::vector<Task::priority_t> priority_storage_t;
+	typedef Container::priority_queue<Task::priority_t> priority_heap_t;
+	typedef Container::vector<PriorityLevel *> level_pool_t;
+
+	//! Number of idle levels allocated when the queue is created
+	static const size_t PREALLOCATED_LEVELS = 8;
+
+	//! Maximum number of idle levels kept for reuse
+	static const size_t MAX_IDLE_LEVELS = 64;
+
+	//! Active and idle levels indexed by priority
+	level_map_t _levels;
+
+	//! Priorities of the active levels, with the highest on top
+	priority_heap_t _priorities;
+
+	//! Levels without tasks, either indexed or not
+	level_pool_t _idleLevels;
+
+	//! Level with the highest priority, or nullptr if there are no tasks
+	PriorityLevel *_topLevel;
+
+	//! Last level where a task was added, which avoids the lookup when
+	//! consecutive tasks have the same priority
+	PriorityLevel *_lastLevel;
 
 	size_t _numReadyTasks;
 
+	inline void pushIdleLevel(PriorityLevel *level)
+	{
+		level->_idleIndex = _idleLevels.size();
+		_idleLevels.push_back(level);
+	}
+
+	inline void removeIdleLevel(PriorityLevel *level)
+	{
+		assert(level->_idleIndex < _idleLevels.size());
+		assert(_idleLevels[level->_idleIndex] == level);
+
+		PriorityLevel *last = _idleLevels.back();
+		_idleLevels[level->_idleIndex] = last;
+		last->_idleIndex = level->_idleIndex;
+		_idleLevels.pop_back();
+	}
+
+	inline void unindexLevel(PriorityLevel *level)
+	{
+		if (level->_indexed) {
+			_levels.erase(level->_priority);
+			level->_indexed = false;
+		}
+	}
+
+	inline void activateLevel(PriorityLevel *level)
+	{
+		assert(!level->_active);
+		assert(level->_tasks.empty());
+
+		level->_active = true;
+		_priorities.push(level->_priority);
+
+		if (_topLevel == nullptr || level->_priority > _topLevel->_priority) {
+			_topLevel = level;
+		}
+	}
+
+	inline PriorityLevel *getLevel(Task::priority_t priority)
+	{
+		if (_lastLevel != nullptr && _lastLevel->_priority == priority) {
+			assert(_lastLevel->_active);
+			return _lastLevel;
+		}
+
+		PriorityLevel *level;
+		level_map_t::iterator it = _levels.find(priority);
+		if (it != _levels.end()) {
+			level = it->second;
+			if (!level->_active) {
+				removeIdleLevel(level);
+				activateLevel(level);
+			}
+		} else {
+			if (!_idleLevels.empty()) {
+				level = _idleLevels.front();
+				removeIdleLevel(level);
+				unindexLevel(level);
+			} else {
+				level = MemoryAllocator::newObject<PriorityLevel>();
+			}
+
+			level->_priority = priority;
+			level->_indexed = true;
+			_levels.emplace(priority, level);
+			activateLevel(level);
+		}
+
+		_lastLevel = level;
+		return level;
+	}
+
+	//! \brief Deactivate the top level, which has become empty
+	inline void reclaimTopLevel()
+	{
+		PriorityLevel *level = _topLevel;
+		assert(level != nullptr);
+		assert(level->_active);
+		assert(level->_tasks.empty());
+		assert(!_priorities.empty());
+		assert(_priorities.top() == level->_priority);
+
+		_priorities.pop();
+		level->_active = false;
+
+		if (_lastLevel == level) {
+			_lastLevel = nullptr;
+		}
+
+		if (_idleLevels.size() >= MAX_IDLE_LEVELS) {
+			PriorityLevel *evicted = _idleLevels.front();
+			removeIdleLevel(evicted);
+			unindexLevel(evicted);
+			MemoryAllocator::deleteObject<PriorityLevel>(evicted);
+		}
+		pushIdleLevel(level);
+
+		if (_priorities.empty()) {
+			_topLevel = nullptr;
+		} else {
+			level_map_t::iterator it = _levels.find(_priorities.top());
+			assert(it != _levels.end());
+			_topLevel = it->second;
+		}
+	}
+
 public:
 	ReadyQueueMap(SchedulingPolicy policy) :
 		ReadyQueue(policy),
+		_levels(MAX_IDLE_LEVELS),
+		_topLevel(nullptr),
+		_lastLevel(nullptr),
 		_numReadyTasks(0)
 	{
+		priority_storage_t storage;
+		storage.reserve(MAX_IDLE_LEVELS);
+		_priorities = priority_heap_t(std::less<Task::priority_t>(), std::move(storage));
+
+		_idleLevels.reserve(MAX_IDLE_LEVELS);
+		for (size_t i = 0; i < PREALLOCATED_LEVELS; ++i) {
+			pushIdleLevel(MemoryAllocator::newObject<PriorityLevel>());
+		}
 	}
 
 	~ReadyQueueMap()
 	{
-		for (ready_map_t::iterator it = _readyMap.begin(); it != _readyMap.end(); it++) {
-			assert(it->second.empty());
+		assert(_numReadyTasks == 0);
+		for (PriorityLevel *level : _idleLevels) {
+			assert(!level->_active);
+			unindexLevel(level);
+			MemoryAllocator::deleteObject<PriorityLevel>(level);
+		}
+		for (level_map_t::iterator it = _levels.begin(); it != _levels.end(); it++) {
+			assert(it->second->_tasks.empty());
+			MemoryAllocator::deleteObject<PriorityLevel>(it->second);
 		}
-		_readyMap.clear();
 	}
 
 	void addReadyTask(Task *task, bool unblocked)
 	{
-		Task::priority_t priority = task->getPriority();
-
-		// Get ready queue for the given priority, if exists. If not, create it, and return it
-		ready_map_t::iterator it = (_readyMap.emplace(priority, ready_queue_t())).first;
-		assert(it != _readyMap.end());
+		PriorityLevel *level = getLevel(task->getPriority());
+		assert(level != nullptr);
 
 		if (unblocked || _policy == SchedulingPolicy::LIFO_POLICY) {
-			it->second.push_front(task);
+			level->_tasks.push_front(task);
 		} else {
-			it->second.push_back(task);
+			level->_tasks.push_back(task);
 		}
 
 		++_numReadyTasks;
 	}
 
+	void addReadyTasks(Task *tasks[], const size_t numTasks, bool unblocked)
+	{
+		// Insert each run of tasks with the same priority at once
+		size_t start = 0;
+		while (start < numTasks) {
+			const Task::priority_t priority = tasks[start]->getPriority();
+			size_t end = start + 1;
+			while (end < numTasks && tasks[end]->getPriority() == priority) {
+				++end;
+			}
+
+			PriorityLevel *level = getLevel(priority);
+			assert(level != nullptr);
+
+			if (unblocked || _policy == SchedulingPolicy::LIFO_POLICY) {
+				// Pushing them one by one to the front reverses their order
+				level->_tasks.insert(level->_tasks.begin(),
+					std::reverse_iterator<Task **>(tasks + end),
+					std::reverse_iterator<Task **>(tasks + start));
+			} else {
+				level->_tasks.insert(level->_tasks.end(), tasks + start, tasks + end);
+			}
+
+			_numReadyTasks += end - start;
+			start = end;
+		}
+	}
+
 	Task *getReadyTask(ComputePlace *)
 	{
-		if (_readyMap.empty()) {
+		if (_topLevel == nullptr) {
 			return nullptr;
 		}
 
-		ready_map_t::iterator it = _readyMap.begin();
-		while (it != _readyMap.end()) {
-			if (it->second.empty()) {
-				it++;
-			} else {
-				Task *result = it->second.front();
-				assert(result != nullptr);
+		assert(!_topLevel->_tasks.empty());
+		Task *result = _topLevel->_tasks.front();
+		assert(result != nullptr);
 
-				it->second.pop_front();
-				--_numReadyTasks;
-				return result;
-			}
+		_topLevel->_tasks.pop_front();
+		--_numReadyTasks;
+
+		if (_topLevel->_tasks.empty()) {
+			reclaimTopLevel();
 		}
 
-		return nullptr;
+		return result;
 	}
 
 	inline size_t getNumReadyTasks() const
@@ -8,15 +8,57 @@
 #define HOST_SCHEDULER_HPP
 
 #include "HostUnsyncScheduler.hpp"
+#include "NUMAHostUnsyncScheduler.hpp"
 #include "SyncScheduler.hpp"
 
 class HostScheduler : public SyncScheduler {
+	//! The owned CPUs of each NUMA node, which are candidates to be resumed
+	//! for the strict affinity tasks of their node
+	Container::vector<Container::vector<CPU *>> _numaCPUs;
+
+	//! \brief Check whether a CPU can be resumed to run strict affinity tasks
+	//!
+	//! The owned CPUs that have not been disabled qualify, including the ones
+	//! lent through DLB, which can be reclaimed
+	static inline bool canRunAffinityTasks(CPU *cpu)
+	{
+		assert(cpu != nullptr);
+
+		if (!cpu->isOwned()) {
+			return false;
+		}
+
+		const CPU::activation_status_t status = cpu->getActivationStatus();
+		return CPUManager::acceptsWork(cpu) || status == CPU::lent_status || status == CPU::lending_status;
+	}
+
 public:
 
-	HostScheduler(size_t totalComputePlaces, SchedulingPolicy policy, bool enablePriority, bool enableImmediateSuccessor)
-		: SyncScheduler(totalComputePlaces)
+	HostScheduler(
+		size_t totalComputePlaces,
+		SchedulingPolicy policy,
+		bool enablePriority,
+		bool enableImmediateSuccessor,
+		bool enableNUMAQueues
+	) :
+		SyncScheduler(totalComputePlaces)
 	{
-		_scheduler = new HostUnsyncScheduler(policy, enablePriority, enableImmediateSuccessor);
+		if (enableNUMAQueues) {
+			_scheduler = new NUMAHostUnsyncScheduler(policy, enablePriority, enableImmediateSuccessor);
+		} else {
+			_scheduler = new HostUnsyncScheduler(policy, enablePriority, enableImmediateSuccessor);
+		}
+
+		const size_t numNUMANodes = HardwareInfo::getMemoryPlaceCount(nanos6_host_device);
+		_numaCPUs.resize(numNUMANodes);
+
+		const std::vector<CPU *> &cpus = CPUManager::getCPUListReference();
+		for (CPU *cpu : cpus) {
+			assert(cpu != nullptr);
+			if (cpu->getNumaNodeId() < numNUMANodes && cpu->isOwned()) {
+				_numaCPUs[cpu->getNumaNodeId()].push_back(cpu);
+			}
+		}
 	}
 
 	virtual ~HostScheduler()
@@ -25,6 +67,39 @@ public:
 		_scheduler = nullptr;
 	}
 
+	inline void addReadyTasks(Task *tasks[], const size_t numTasks, ComputePlace *computePlace, ReadyTaskHint hint)
+	{
+		// The strict affinity tasks can only run in their targets, which may
+		// be idle. Get the CPUs to resume before adding the tasks, since they
+		// may run and disappear as soon as they are added
+		size_t numStrict = 0;
+		for (size_t t = 0; t < numTasks; ++t) {
+			if (tasks[t]->hasAffinity() && tasks[t]->hasStrictAffinity()) {
+				++numStrict;
+			}
+		}
+
+		if (numStrict == 0) {
+			SyncScheduler::addReadyTasks(tasks, numTasks, computePlace, hint);
+			return;
+		}
+
+		CPU *targets[numStrict];
+		size_t numTargets = 0;
+		for (size_t t = 0; t < numTasks; ++t) {
+			CPU *target = resolveStrictAffinity(tasks[t]);
+			if (target != nullptr && target != computePlace) {
+				targets[numTargets++] = target;
+			}
+		}
+
+		SyncScheduler::addReadyTasks(tasks, numTasks, computePlace, hint);
+
+		for (size_t t = 0; t < numTargets; ++t) {
+			CPUManager::executeCPUManagerPolicy(targets[t], REQUEST_SPECIFIC_CPU);
+		}
+	}
+
 	inline Task *getReadyTask(ComputePlace *computePlace)
 	{
 		Task *result = getTask(computePlace);
@@ -37,7 +112,55 @@ public:
 		return "HostScheduler";
 	}
 
-private:
+protected:
+	//! \brief Get the CPU that runs a task with affinity, or the first CPU of
+	//! its NUMA node that can run it
+	//!
+	//! \returns the CPU, or nullptr if no CPU of the target can run the task
+	inline CPU *getAffinityCPU(Task *task) const
+	{
+		assert(task->hasAffinity());
+
+		if (task->getAffinityCPU() >= 0) {
+			const std::vector<CPU *> &cpus = CPUManager::getCPUListReference();
+			if ((size_t) task->getAffinityCPU() < cpus.size()) {
+				CPU *cpu = cpus[task->getAffinityCPU()];
+				return canRunAffinityTasks(cpu) ? cpu : nullptr;
+			}
+		}
+
+		if ((size_t) task->getAffinityNUMANode() < _numaCPUs.size()) {
+			for (CPU *cpu : _numaCPUs[task->getAffinityNUMANode()]) {
+				if (canRunAffinityTasks(cpu)) {
+					return cpu;
+				}
+			}
+		}
+		return nullptr;
+	}
+
+	//! \brief Get the CPU to resume for a ready task with strict affinity
+	//!
+	//! A strict task whose target has no CPU that can run it loses its
+	//! affinity, so that it goes to the shared ready queue instead of
+	//! waiting forever
+	//!
+	//! \returns the CPU, or nullptr if the task has no strict affinity
+	inline CPU *resolveStrictAffinity(Task *task) const
+	{
+		assert(task != nullptr);
+
+		if (!task->hasAffinity() || !task->hasStrictAffinity()) {
+			return nullptr;
+		}
+
+		CPU *cpu = getAffinityCPU(task);
+		if (cpu == nullptr) {
+			task->setAffinity(-1, -1, false);
+		}
+		return cpu;
+	}
+
 	inline ComputePlace *getComputePlace(uint64_t computePlaceIndex) const
 	{
 		const std::vector<CPU *> &cpus = CPUManager::getCPUListReference();
@@ -57,6 +180,30 @@ private:
 		return !CPUManager::acceptsWork(cpu);
 	}
 
+	//! \brief Get the number of tasks of a batch of ready tasks that the
+	//! compute place that added them is not going to run
+	//!
+	//! A compute place that releases the successors of its finished task
+	//! runs one of them next. The ones that create, unblock or delay tasks
+	//! keep running their current task, and the external threads run none
+	static inline size_t getNumTasksForOthers(ComputePlace *computePlace, size_t numTasks, ReadyTaskHint hint)
+	{
+		if (computePlace != nullptr && hint == SIBLING_TASK_HINT && numTasks > 0) {
+			return numTasks - 1;
+		}
+		return numTasks;
+	}
+
+	inline void postAddReadyTasks(ComputePlace *computePlace, size_t numTasks, ReadyTaskHint hint)
+	{
+		// Resume an idle compute place for each task that the current one
+		// is not going to run, in a single request for the whole batch
+		const size_t numWakeUps = getNumTasksForOthers(computePlace, numTasks, hint);
+		if (numWakeUps > 0) {
+			CPUManager::executeCPUManagerPolicy(computePlace, REQUEST_CPUS, numWakeUps);
+		}
+	}
+
 	inline void postServingTasks(ComputePlace *computePlace, Task *assignedTask)
 	{
 		if (assignedTask == nullptr) {
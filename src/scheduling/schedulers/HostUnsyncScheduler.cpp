@@ -5,6 +5,7 @@
 */
 
 #include "HostUnsyncScheduler.hpp"
+#include "scheduling/SchedulerStats.hpp"
 #include "scheduling/ready-queues/DeadlineQueue.hpp"
 #include "scheduling/ready-queues/ReadyQueueDeque.hpp"
 #include "scheduling/ready-queues/ReadyQueueMap.hpp"
@@ -37,15 +38,14 @@ Task *HostUnsyncScheduler::getReadyTask(ComputePlace *computePlace)
 
 			groupTaskfor->notifyCollaboratorHasStarted();
 			bool remove = false;
-			int myChunk = groupTaskfor->getNextChunk(cpuId, &remove);
+			Taskfor *taskfor = computePlace->getPreallocatedTaskfor();
+			// We are setting the chunk that the collaborator will execute in the preallocatedTaskfor
+			groupTaskfor->getNextChunk(taskfor->getMyChunk(), &remove);
 			if (remove) {
 				_groupSlots[groupId] = nullptr;
 				groupTaskfor->removedFromScheduler();
 			}
 
-			Taskfor *taskfor = computePlace->getPreallocatedTaskfor();
-			// We are setting the chunk that the collaborator will execute in the preallocatedTaskfor
-			taskfor->setChunk(myChunk);
 			return groupTaskfor;
 		}
 	}
@@ -70,14 +70,27 @@ Task *HostUnsyncScheduler::getReadyTask(ComputePlace *computePlace)
 			result = _immediateSuccessorTasks[cpuId];
 			_immediateSuccessorTasks[cpuId] = nullptr;
 		}
+
+		if (result != nullptr) {
+			SchedulerStats::immediateSuccessorHit(computePlace);
+		}
+	}
+
+	// 5. Check if there is work with affinity to this CPU or its NUMA node,
+	// and then in the ready queue
+	if (result == nullptr) {
+		result = _affinityTasks->getTask((CPU *) computePlace);
+		if (result == nullptr) {
+			result = getReadyQueueTask(computePlace);
+		}
 	}
 
-	// 5. Check if there is work remaining in the ready queue
+	// 6. Run a preferred affinity task of another place that waited for too long
 	if (result == nullptr) {
-		result = _readyTasks->getReadyTask(computePlace);
+		result = _affinityTasks->getSpilledTask();
 	}
 
-	// 6. Try to get work from other immediateSuccessorTasks
+	// 7. Try to get work from other immediateSuccessorTasks
 	if (result == nullptr && _enableImmediateSuccessor) {
 		for (size_t i = 0; i < _immediateSuccessorTasks.size(); i++) {
 			if (_immediateSuccessorTasks[i] != nullptr) {
@@ -89,7 +102,7 @@ Task *HostUnsyncScheduler::getReadyTask(ComputePlace *computePlace)
 		}
 	}
 
-	// 7. Try to get work from other immediateSuccessorTasksfors
+	// 8. Try to get work from other immediateSuccessorTasksfors
 	if (result == nullptr && _enableImmediateSuccessor) {
 		for (size_t i = 0; i < _immediateSuccessorTaskfors.size(); i++) {
 			if (_immediateSuccessorTaskfors[i] != nullptr) {
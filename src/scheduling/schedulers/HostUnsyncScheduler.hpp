@@ -7,9 +7,14 @@
 #ifndef HOST_UNSYNC_SCHEDULER_HPP
 #define HOST_UNSYNC_SCHEDULER_HPP
 
+#include <algorithm>
+
 #include "UnsyncScheduler.hpp"
+#include "hardware/HardwareInfo.hpp"
+#include "scheduling/ready-queues/AffinityQueues.hpp"
 #include "scheduling/ready-queues/DeadlineQueue.hpp"
 #include "support/Containers.hpp"
+#include "support/config/ConfigVariable.hpp"
 
 class Taskfor;
 
@@ -18,6 +23,17 @@ class HostUnsyncScheduler : public UnsyncScheduler {
 
 	taskfor_group_slots_t _groupSlots;
 
+	//! Ready tasks with an affinity hint
+	AffinityQueues *_affinityTasks;
+
+	//! \brief Check whether a ready task goes to the affinity queues
+	inline bool hasAffinity(Task *task, ReadyTaskHint hint) const
+	{
+		// Taskfors are shared by the CPUs of a group, and the deadline
+		// tasks are served by any CPU once their deadline expires
+		return task->hasAffinity() && !task->isTaskfor() && hint != DEADLINE_TASK_HINT;
+	}
+
 public:
 	HostUnsyncScheduler(SchedulingPolicy policy, bool enablePriority, bool enableImmediateSuccessor) :
 		UnsyncScheduler(policy, enablePriority, enableImmediateSuccessor)
@@ -32,12 +48,59 @@ public:
 
 		_deadlineTasks = new DeadlineQueue(policy);
 		assert(_deadlineTasks != nullptr);
+
+		ConfigVariable<size_t> spillTime("scheduler.affinity_spill_time");
+		_affinityTasks = new AffinityQueues(
+			CPUManager::getTotalCPUs(),
+			std::max(HardwareInfo::getMemoryPlaceCount(nanos6_host_device), (size_t) 1),
+			spillTime.getValue());
 	}
 
 	virtual ~HostUnsyncScheduler()
 	{
 		assert(_deadlineTasks != nullptr);
 		delete _deadlineTasks;
+		delete _affinityTasks;
+	}
+
+	//! \brief Add a (ready) task that has been created or freed
+	//!
+	//! The tasks with an affinity hint never become the immediate successor,
+	//! so that they are only run by their target
+	//!
+	//! \param[in] task the task to be added
+	//! \param[in] computePlace the hardware place of the creator or the liberator
+	//! \param[in] hint a hint about the relation of the task to the current task
+	inline void addReadyTask(Task *task, ComputePlace *computePlace, ReadyTaskHint hint = NO_HINT)
+	{
+		assert(task != nullptr);
+
+		if (!hasAffinity(task, hint) || !_affinityTasks->addTask(task)) {
+			UnsyncScheduler::addReadyTask(task, computePlace, hint);
+		}
+	}
+
+	//! \brief Add a batch of (ready) tasks that have been created or freed
+	//!
+	//! \param[in] tasks the tasks to be added
+	//! \param[in] numTasks the number of tasks
+	//! \param[in] computePlace the hardware place of the creator or the liberator
+	//! \param[in] hint a hint about the relation of the tasks to the current task
+	inline void addReadyTasks(Task *tasks[], const size_t numTasks, ComputePlace *computePlace, ReadyTaskHint hint)
+	{
+		assert(tasks != nullptr);
+
+		for (size_t t = 0; t < numTasks; ++t) {
+			if (hasAffinity(tasks[t], hint)) {
+				// Rare case; add the tasks one by one to keep their order
+				for (size_t u = 0; u < numTasks; ++u) {
+					addReadyTask(tasks[u], computePlace, hint);
+				}
+				return;
+			}
+		}
+
+		UnsyncScheduler::addReadyTasks(tasks, numTasks, computePlace, hint);
 	}
 
 	//! \brief Get a ready task for execution
@@ -0,0 +1,163 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <algorithm>
+#include <numa.h>
+
+#include "NUMAHostUnsyncScheduler.hpp"
+#include "executors/threads/CPU.hpp"
+#include "hardware/HardwareInfo.hpp"
+#include "scheduling/ready-queues/ReadyQueueDeque.hpp"
+#include "scheduling/ready-queues/ReadyQueueMap.hpp"
+#include "support/config/ConfigVariable.hpp"
+#include "tasks/Task.hpp"
+
+#include <DataAccessRegistration.hpp>
+#include <DataAccessRegistrationImplementation.hpp>
+#include <VirtualMemoryManagement.hpp>
+
+NUMAHostUnsyncScheduler::NUMAHostUnsyncScheduler(
+	SchedulingPolicy policy,
+	bool enablePriority,
+	bool enableImmediateSuccessor
+) :
+	HostUnsyncScheduler(policy, enablePriority, enableImmediateSuccessor),
+	_nextQueue(0)
+{
+	ConfigVariable<bool> dataAffinity("scheduler.numa_data_affinity");
+	_dataAffinity = dataAffinity.getValue();
+
+	const size_t numNUMANodes = std::max(HardwareInfo::getMemoryPlaceCount(nanos6_host_device), (size_t) 1);
+
+	// Reuse the ready queue of the base scheduler for the first NUMA node
+	_numaQueues = numa_queues_t(numNUMANodes, nullptr);
+	_numaQueues[0] = _readyTasks;
+	for (size_t i = 1; i < numNUMANodes; ++i) {
+		if (enablePriority) {
+			_numaQueues[i] = new ReadyQueueMap(policy);
+		} else {
+			_numaQueues[i] = new ReadyQueueDeque(policy);
+		}
+	}
+
+	// Steal from the closest NUMA nodes first. Fall back to the distance
+	// between the indices when libnuma does not report the distances
+	const bool haveDistances = (numa_available() != -1);
+
+	_stealOrder = steal_order_t(numNUMANodes);
+	for (size_t i = 0; i < numNUMANodes; ++i) {
+		Container::vector<size_t> &order = _stealOrder[i];
+		for (size_t j = 0; j < numNUMANodes; ++j) {
+			order.push_back(j);
+		}
+
+		auto distance = [&](size_t j) -> size_t {
+			if (i == j) {
+				return 0;
+			}
+			if (haveDistances) {
+				return numa_distance(i, j);
+			}
+			return (i > j) ? i - j : j - i;
+		};
+
+		std::stable_sort(order.begin(), order.end(),
+			[&](size_t a, size_t b) {
+				return distance(a) < distance(b);
+			}
+		);
+		assert(order[0] == i);
+	}
+}
+
+NUMAHostUnsyncScheduler::~NUMAHostUnsyncScheduler()
+{
+	// The first queue is deleted by the base scheduler
+	for (size_t i = 1; i < _numaQueues.size(); ++i) {
+		delete _numaQueues[i];
+	}
+}
+
+size_t NUMAHostUnsyncScheduler::getDataNUMANode(Task *task) const
+{
+	const size_t numNUMANodes = _numaQueues.size();
+
+	// Most tasks access a few regions, so count linearly per NUMA node
+	size_t bestNUMANode = numNUMANodes;
+	size_t bestBytes = 0;
+	Container::vector<size_t> bytes(numNUMANodes, 0);
+
+	DataAccessRegistration::processAllDataAccesses(
+		task,
+		[&](const DataAccess *access) -> bool {
+			DataAccessRegion const &region = access->getAccessRegion();
+
+			const size_t numaId = VirtualMemoryManagement::findNUMA(region.getStartAddress());
+			if (numaId < numNUMANodes) {
+				bytes[numaId] += region.getSize();
+				if (bytes[numaId] > bestBytes) {
+					bestBytes = bytes[numaId];
+					bestNUMANode = numaId;
+				}
+			}
+			return true;
+		}
+	);
+
+	return bestNUMANode;
+}
+
+size_t NUMAHostUnsyncScheduler::getPlacement(Task *task, ComputePlace *computePlace)
+{
+	assert(task != nullptr);
+	const size_t numNUMANodes = _numaQueues.size();
+
+	// 1. The NUMA node holding most of the data of the task
+	if (_dataAffinity) {
+		const int numaId = task->getDataNUMANode();
+		if (numaId >= 0 && (size_t) numaId < numNUMANodes) {
+			return numaId;
+		}
+	}
+
+	// 2. The NUMA node of the creator or the liberator
+	if (computePlace != nullptr && computePlace->getType() == nanos6_host_device) {
+		const size_t numaId = ((CPU *) computePlace)->getNumaNodeId();
+		if (numaId < numNUMANodes) {
+			return numaId;
+		}
+	}
+
+	// 3. Spread the tasks without any hint
+	const size_t numaId = _nextQueue;
+	_nextQueue = (_nextQueue + 1) % numNUMANodes;
+	return numaId;
+}
+
+Task *NUMAHostUnsyncScheduler::getReadyQueueTask(ComputePlace *computePlace)
+{
+	assert(computePlace != nullptr);
+	assert(computePlace->getType() == nanos6_host_device);
+
+	size_t numaId = ((CPU *) computePlace)->getNumaNodeId();
+	if (numaId >= _numaQueues.size()) {
+		numaId = 0;
+	}
+
+	for (size_t victim : _stealOrder[numaId]) {
+		ReadyQueue *queue = _numaQueues[victim];
+		if (queue->getNumReadyTasks() == 0) {
+			continue;
+		}
+
+		Task *result = queue->getReadyTask(computePlace);
+		if (result != nullptr) {
+			return result;
+		}
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,93 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef NUMA_HOST_UNSYNC_SCHEDULER_HPP
+#define NUMA_HOST_UNSYNC_SCHEDULER_HPP
+
+#include "HostUnsyncScheduler.hpp"
+#include "support/Containers.hpp"
+
+//! \brief Host scheduler with a ready queue per NUMA node
+//!
+//! Every ready task is placed in the queue of a NUMA node, which is the
+//! majority NUMA node of its data when the data affinity is enabled and
+//! known, or the NUMA node of the CPU that created or released it otherwise.
+//! CPUs serve the tasks of their own NUMA node first, and steal from the
+//! queues of the other NUMA nodes in order of increasing distance
+class NUMAHostUnsyncScheduler : public HostUnsyncScheduler {
+	typedef Container::vector<ReadyQueue *> numa_queues_t;
+	typedef Container::vector<Container::vector<size_t>> steal_order_t;
+
+	//! Ready queue of each NUMA node. The first one is the ready queue of
+	//! the base scheduler
+	numa_queues_t _numaQueues;
+
+	//! NUMA nodes sorted by distance from each NUMA node, starting by itself
+	steal_order_t _stealOrder;
+
+	//! Next queue used for the tasks without any NUMA hint
+	size_t _nextQueue;
+
+	//! Whether the tasks are placed in the NUMA node holding most of their data
+	bool _dataAffinity;
+
+	//! \brief Get the NUMA node that holds most bytes of the accesses of a task
+	//!
+	//! \returns the NUMA node, or the number of NUMA nodes if unknown
+	size_t getDataNUMANode(Task *task) const;
+
+	//! \brief Compute the queue in which a ready task is placed
+	size_t getPlacement(Task *task, ComputePlace *computePlace);
+
+protected:
+	inline void addReadyQueueTask(Task *task, ComputePlace *computePlace, bool unblocked)
+	{
+		const size_t numaId = getPlacement(task, computePlace);
+		assert(numaId < _numaQueues.size());
+
+		_numaQueues[numaId]->addReadyTask(task, unblocked);
+	}
+
+	inline void addReadyQueueTasks(Task *tasks[], const size_t numTasks, ComputePlace *computePlace, bool unblocked)
+	{
+		// Each task may go to a different NUMA node
+		for (size_t t = 0; t < numTasks; ++t) {
+			addReadyQueueTask(tasks[t], computePlace, unblocked);
+		}
+	}
+
+	Task *getReadyQueueTask(ComputePlace *computePlace);
+
+public:
+	NUMAHostUnsyncScheduler(
+		SchedulingPolicy policy,
+		bool enablePriority,
+		bool enableImmediateSuccessor
+	);
+
+	virtual ~NUMAHostUnsyncScheduler();
+
+	inline void prepareReadyTask(Task *task)
+	{
+		// Finding the NUMA node of the data takes the lock of the accesses
+		// of the task, so it is done before the scheduler lock is taken
+		if (_dataAffinity) {
+			const size_t numaId = getDataNUMANode(task);
+			task->setDataNUMANode((numaId < _numaQueues.size()) ? (int) numaId : -1);
+		}
+	}
+
+	inline size_t getNumReadyTasks() const
+	{
+		size_t numReadyTasks = 0;
+		for (ReadyQueue *queue : _numaQueues) {
+			numReadyTasks += queue->getNumReadyTasks();
+		}
+		return numReadyTasks;
+	}
+};
+
+#endif // NUMA_HOST_UNSYNC_SCHEDULER_HPP
@@ -5,6 +5,7 @@
 */
 
 #include "SyncScheduler.hpp"
+#include "scheduling/SchedulerStats.hpp"
 
 #include <InstrumentScheduler.hpp>
 
@@ -17,8 +18,12 @@ Task *SyncScheduler::getTask(ComputePlace *computePlace)
 
 	Instrument::enterSchedulerLock();
 
+	const uint64_t waitStart = SchedulerStats::now();
+
 	// Lock or delegate the work of getting a ready task
 	if (!_lock.lockOrDelegate(computePlaceIdx, task)) {
+		SchedulerStats::lockWaited(computePlace, SchedulerStats::now() - waitStart);
+
 		// Someone else acquired the lock and assigned us work
 		if (task) {
 			Instrument::exitSchedulerLockAsClient(task->getInstrumentationTaskId());
@@ -29,9 +34,15 @@ Task *SyncScheduler::getTask(ComputePlace *computePlace)
 	}
 
 	// We acquired the lock and we have to serve tasks
+	const uint64_t holdStart = SchedulerStats::now();
+	SchedulerStats::lockWaited(computePlace, holdStart - waitStart);
+
 	Instrument::schedulerLockBecomesServer();
 	setServingTasks(true);
 
+	size_t totalServedTasks = 0;
+	bool sampled = false;
+
 	// The idea is to always keep a compute place inside the following scheduling loop
 	// serving tasks to the rest of active compute places, except when there is work for
 	// all compute places. A compute place should stay inside the scheduler to check for
@@ -45,6 +56,13 @@ Task *SyncScheduler::getTask(ComputePlace *computePlace)
 		// Move ready tasks from add queues to the unsynchronized scheduler
 		processReadyTasks();
 
+		// Sample the ready queue once per turn, since the server may
+		// spin here while there is no work
+		if (!sampled) {
+			SchedulerStats::readyQueueDepth(computePlace, _scheduler->getNumReadyTasks());
+			sampled = true;
+		}
+
 		// Serve the rest of computes places that are waiting
 		while (servedTasks < _maxServedTasks && !_lock.empty()) {
 			// Get the index of the waiting compute place
@@ -72,10 +90,13 @@ Task *SyncScheduler::getTask(ComputePlace *computePlace)
 			servedTasks++;
 			if (task == nullptr)
 				break;
+			totalServedTasks++;
 		}
 
 		// No more compute places waiting; try to get work for myself
 		task = _scheduler->getReadyTask(computePlace);
+		if (task != nullptr)
+			totalServedTasks++;
 
 		// Keep serving while there is no work for the current compute
 		// place or it is external/disabling
@@ -88,6 +109,8 @@ Task *SyncScheduler::getTask(ComputePlace *computePlace)
 	// Release the lock so another compute place can serve tasks
 	_lock.unlock();
 
+	SchedulerStats::serverTurn(computePlace, SchedulerStats::now() - holdStart, totalServedTasks);
+
 	// Perform the required actions after stop serving tasks. In the case of
 	// the host scheduler it should resume idle compute places to guarantee
 	// that there is always a compute place serving tasks
@@ -17,6 +17,7 @@
 #include "hardware/HardwareInfo.hpp"
 #include "lowlevel/DelegationLock.hpp"
 #include "lowlevel/TicketArraySpinLock.hpp"
+#include "scheduling/SchedulerStats.hpp"
 #include "scheduling/SchedulerSupport.hpp"
 
 
@@ -51,6 +52,10 @@ private:
 	//! serving tasks inside the scheduling loop
 	std::atomic<bool> _servingTasks;
 
+	//! Maximum number of tasks moved at once from an add queue
+	//! to the unsynchronized scheduler
+	static const size_t PROCESS_BATCH_SIZE = 64;
+
 	//! The limit of tasks that a compute place can serve within a
 	//! single burst in the scheduling loop. This avoids that an
 	//! external compute place gets stuck solely serving tasks for
@@ -114,11 +119,10 @@ public:
 
 	inline void addReadyTask(Task *task, ComputePlace *computePlace, ReadyTaskHint hint)
 	{
-		// TODO: Allow adding multiple tasks in the future
 		addReadyTasks(&task, 1, computePlace, hint);
 	}
 
-	inline void addReadyTasks(Task *tasks[], const size_t numTasks, ComputePlace *computePlace, ReadyTaskHint hint)
+	virtual inline void addReadyTasks(Task *tasks[], const size_t numTasks, ComputePlace *computePlace, ReadyTaskHint hint)
 	{
 		// Use a special queue not belonging to any NUMA node if no compute place
 		const size_t queueIndex = (computePlace != nullptr) ? ((CPU *)computePlace)->getNumaNodeId() : _totalAddQueues-1;
@@ -129,21 +133,32 @@ public:
 			// Set temporary info that is used when processing ready tasks
 			tasks[t]->setComputePlace(computePlace);
 			tasks[t]->setSchedulingHint(hint);
+			_scheduler->prepareReadyTask(tasks[t]);
 		}
 
-		size_t count = 0;
-		while (numTasks > count) {
-			// Acquire lock since other cpus from the same NUMA may be enqueueing
-			_addQueuesLocks[queueIndex].lock();
-			count += _addQueues[queueIndex].push(tasks+count, numTasks-count);
-			_addQueuesLocks[queueIndex].unlock();
-
-			if ((numTasks > count) && _lock.tryLock()) {
-				// Process queues before pushing new tasks
-				processReadyTasks();
-				_lock.unlock();
+		// Acquire lock since other cpus from the same NUMA may be enqueueing
+		_addQueuesLocks[queueIndex].lock();
+		size_t count = _addQueues[queueIndex].push(tasks, numTasks);
+		_addQueuesLocks[queueIndex].unlock();
+
+		if (numTasks > count) {
+			// Count the overflow once, regardless of the retries it takes
+			SchedulerStats::addQueueOverflow(computePlace);
+
+			while (numTasks > count) {
+				if (_lock.tryLock()) {
+					// Process queues before pushing new tasks
+					processReadyTasks();
+					_lock.unlock();
+				}
+
+				_addQueuesLocks[queueIndex].lock();
+				count += _addQueues[queueIndex].push(tasks+count, numTasks-count);
+				_addQueuesLocks[queueIndex].unlock();
 			}
 		}
+
+		postAddReadyTasks(computePlace, numTasks, hint);
 	}
 
 	Task *getTask(ComputePlace *computePlace);
@@ -161,18 +176,32 @@ private:
 	//! of the scheduler acquired
 	inline void processReadyTasks()
 	{
+		Task *batch[PROCESS_BATCH_SIZE];
+
 		for (size_t i = 0; i < _totalAddQueues; i++) {
-			if (!_addQueues[i].empty()) {
-				_addQueues[i].consume_all(
-					[&](Task *task) {
-						// Add the task to the unsync scheduler
-						_scheduler->addReadyTask(task,
-							task->getComputePlace(),
-							task->getSchedulingHint());
-						// Reset compute place for security
-						task->setComputePlace(nullptr);
+			size_t numTasks;
+			while ((numTasks = _addQueues[i].pop(batch, PROCESS_BATCH_SIZE)) > 0) {
+				// Add each run of tasks with the same compute place
+				// and hint to the unsync scheduler at once
+				size_t start = 0;
+				for (size_t t = 1; t <= numTasks; t++) {
+					if (t < numTasks
+						&& batch[t]->getComputePlace() == batch[start]->getComputePlace()
+						&& batch[t]->getSchedulingHint() == batch[start]->getSchedulingHint()
+					) {
+						continue;
+					}
+
+					_scheduler->addReadyTasks(batch + start, t - start,
+						batch[start]->getComputePlace(),
+						batch[start]->getSchedulingHint());
+
+					// Reset compute place for security
+					for (size_t r = start; r < t; r++) {
+						batch[r]->setComputePlace(nullptr);
 					}
-				);
+					start = t;
+				}
 			}
 		}
 	}
@@ -207,6 +236,18 @@ private:
 	//! \return Whether the compute place should stop
 	virtual bool mustStopServingTasks(ComputePlace *computePlace) const = 0;
 
+	//! \brief Perform the required actions after adding a batch of ready tasks
+	//!
+	//! This function is called once per batch, so that the decisions about
+	//! resuming compute places are not taken for each task
+	//!
+	//! \param[in] computePlace The compute place that added the tasks (if any)
+	//! \param[in] numTasks The number of tasks in the batch
+	//! \param[in] hint The scheduling hint of the tasks
+	virtual void postAddReadyTasks(ComputePlace *, size_t, ReadyTaskHint)
+	{
+	}
+
 	//! \brief Perform the required actions after serving tasks
 	//!
 	//! This function is called when a compute place has stopped
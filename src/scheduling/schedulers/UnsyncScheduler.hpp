@@ -19,6 +19,7 @@
 class UnsyncScheduler {
 protected:
 	typedef Container::vector<Task *> immediate_successor_tasks_t;
+	typedef Container::vector<Task *> task_batch_t;
 
 	immediate_successor_tasks_t _immediateSuccessorTasks;
 	immediate_successor_tasks_t _immediateSuccessorTaskfors;
@@ -29,11 +30,55 @@ protected:
 	bool _enableImmediateSuccessor;
 	bool _enablePriority;
 
+	//! Scratch space to build the batches of tasks for the ready queue
+	task_batch_t _batch;
+
+	//! \brief Add a task to the ready queue
+	//!
+	//! \param[in] task the task to be added
+	//! \param[in] computePlace the hardware place of the creator or the liberator
+	//! \param[in] unblocked whether it is an unblocked task or not
+	virtual inline void addReadyQueueTask(Task *task, ComputePlace *, bool unblocked)
+	{
+		_readyTasks->addReadyTask(task, unblocked);
+	}
+
+	//! \brief Add a batch of tasks to the ready queue
+	//!
+	//! \param[in] tasks the tasks to be added
+	//! \param[in] numTasks the number of tasks
+	//! \param[in] computePlace the hardware place of the creator or the liberator
+	//! \param[in] unblocked whether they are unblocked tasks or not
+	virtual inline void addReadyQueueTasks(Task *tasks[], const size_t numTasks, ComputePlace *, bool unblocked)
+	{
+		_readyTasks->addReadyTasks(tasks, numTasks, unblocked);
+	}
+
+	//! \brief Get a task from the ready queue
+	//!
+	//! \param[in] computePlace the hardware place asking for scheduling orders
+	//!
+	//! \returns a ready task or nullptr
+	virtual inline Task *getReadyQueueTask(ComputePlace *computePlace)
+	{
+		return _readyTasks->getReadyTask(computePlace);
+	}
+
 public:
 	UnsyncScheduler(SchedulingPolicy policy, bool enablePriority, bool enableImmediateSuccessor);
 
 	virtual ~UnsyncScheduler();
 
+	//! \brief Prepare a ready task before the scheduler lock is taken
+	//!
+	//! Any information about the task that the scheduler needs to place it
+	//! and is costly to compute should be computed here
+	//!
+	//! \param[in] task the ready task
+	virtual inline void prepareReadyTask(Task *)
+	{
+	}
+
 	//! \brief Add a (ready) task that has been created or freed
 	//!
 	//! \param[in] task the task to be added
@@ -58,7 +103,7 @@ public:
 					Task *currentIS = _immediateSuccessorTasks[immediateSuccessorId];
 					if (currentIS != nullptr) {
 						assert(!currentIS->isTaskfor());
-						_readyTasks->addReadyTask(currentIS, false);
+						addReadyQueueTask(currentIS, computePlace, false);
 					}
 					_immediateSuccessorTasks[immediateSuccessorId] = task;
 				} else {
@@ -71,7 +116,7 @@ public:
 					} else if (currentIS2 == nullptr) {
 						_immediateSuccessorTaskfors[immediateSuccessorId+1] = task;
 					} else {
-						_readyTasks->addReadyTask(currentIS1, false);
+						addReadyQueueTask(currentIS1, computePlace, false);
 						_immediateSuccessorTaskfors[immediateSuccessorId] = task;
 					}
 				}
@@ -79,7 +124,69 @@ public:
 			}
 		}
 
-		_readyTasks->addReadyTask(task, hint == UNBLOCKED_TASK_HINT);
+		addReadyQueueTask(task, computePlace, hint == UNBLOCKED_TASK_HINT);
+	}
+
+	//! \brief Add a batch of (ready) tasks that have been created or freed
+	//!
+	//! The result is the same as adding the tasks one by one in order, but
+	//! the tasks that go to the ready queue are inserted at once
+	//!
+	//! \param[in] tasks the tasks to be added
+	//! \param[in] numTasks the number of tasks
+	//! \param[in] computePlace the hardware place of the creator or the liberator
+	//! \param[in] hint a hint about the relation of the tasks to the current task
+	virtual inline void addReadyTasks(Task *tasks[], const size_t numTasks, ComputePlace *computePlace, ReadyTaskHint hint)
+	{
+		assert(tasks != nullptr);
+
+		if (hint == DEADLINE_TASK_HINT) {
+			for (size_t t = 0; t < numTasks; ++t) {
+				addReadyTask(tasks[t], computePlace, hint);
+			}
+			return;
+		}
+
+		if (!_enableImmediateSuccessor || computePlace == nullptr || hint != SIBLING_TASK_HINT) {
+			addReadyQueueTasks(tasks, numTasks, computePlace, hint == UNBLOCKED_TASK_HINT);
+			return;
+		}
+
+		// Only the last sibling that is not a taskfor ends up as immediate
+		// successor. The previous immediate successor and the rest of them
+		// go to the ready queue in order
+		size_t last = numTasks;
+		for (size_t t = numTasks; t > 0; --t) {
+			if (!tasks[t - 1]->isTaskfor()) {
+				last = t - 1;
+				break;
+			}
+		}
+
+		const size_t immediateSuccessorId = computePlace->getIndex();
+		if (last < numTasks && _immediateSuccessorTasks[immediateSuccessorId] != nullptr) {
+			assert(!_immediateSuccessorTasks[immediateSuccessorId]->isTaskfor());
+			_batch.push_back(_immediateSuccessorTasks[immediateSuccessorId]);
+		}
+
+		for (size_t t = 0; t < numTasks; ++t) {
+			Task *task = tasks[t];
+			assert(task != nullptr);
+
+			if (task->isTaskfor()) {
+				// Taskfors go to the slots of the group
+				addReadyTask(task, computePlace, hint);
+			} else if (t == last) {
+				_immediateSuccessorTasks[immediateSuccessorId] = task;
+			} else {
+				_batch.push_back(task);
+			}
+		}
+
+		if (!_batch.empty()) {
+			addReadyQueueTasks(_batch.data(), _batch.size(), computePlace, false);
+			_batch.clear();
+		}
 	}
 
 	//! \brief Get a ready task for execution
@@ -88,6 +195,12 @@ public:
 	//!
 	//! \returns a ready task or nullptr
 	virtual Task *getReadyTask(ComputePlace *computePlace) = 0;
+
+	//! \brief Get the number of tasks in the ready queue
+	virtual inline size_t getNumReadyTasks() const
+	{
+		return _readyTasks->getNumReadyTasks();
+	}
 };
 
 
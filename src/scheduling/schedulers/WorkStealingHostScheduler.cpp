@@ -0,0 +1,298 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include "WorkStealingHostScheduler.hpp"
+#include "executors/threads/CPU.hpp"
+#include "executors/threads/CPUManager.hpp"
+#include "executors/threads/WorkerThread.hpp"
+#include "hardware/HardwareInfo.hpp"
+#include "scheduling/SchedulerStats.hpp"
+#include "support/config/ConfigVariable.hpp"
+#include "tasks/Task.hpp"
+
+#include <MemoryAllocator.hpp>
+
+WorkStealingHostScheduler::WorkStealingHostScheduler(
+	size_t totalComputePlaces,
+	SchedulingPolicy policy,
+	bool enablePriority,
+	bool enableImmediateSuccessor,
+	bool enableNUMAQueues
+) :
+	HostScheduler(totalComputePlaces, policy, enablePriority, enableImmediateSuccessor, enableNUMAQueues),
+	_numCPUs(totalComputePlaces),
+	_policy(policy),
+	_enablePriority(enablePriority),
+	_enableImmediateSuccessor(enableImmediateSuccessor),
+	_prioritizedTasks(0),
+	_stealableTasks(0)
+{
+	ConfigVariable<size_t> sideCheckPeriod("scheduler.work_stealing_check_period");
+	_sideCheckPeriod = sideCheckPeriod.getValue();
+	FatalErrorHandler::failIf(_sideCheckPeriod == 0,
+		"scheduler.work_stealing_check_period must be greater than zero");
+
+	_cpuStates = (CPUState *) MemoryAllocator::alloc(_numCPUs * sizeof(CPUState));
+	for (size_t i = 0; i < _numCPUs; ++i) {
+		new (&_cpuStates[i]) CPUState(i + 1);
+	}
+
+	// Group the CPUs by NUMA node to steal from the closest ones first
+	const size_t numNUMANodes = HardwareInfo::getMemoryPlaceCount(nanos6_host_device);
+	_numaCPUs.resize(numNUMANodes);
+
+	const std::vector<CPU *> &cpus = CPUManager::getCPUListReference();
+	for (CPU *cpu : cpus) {
+		assert(cpu != nullptr);
+		if (cpu->getNumaNodeId() < numNUMANodes && (size_t) cpu->getIndex() < _numCPUs) {
+			_numaCPUs[cpu->getNumaNodeId()].push_back(cpu->getIndex());
+		}
+	}
+}
+
+WorkStealingHostScheduler::~WorkStealingHostScheduler()
+{
+	for (size_t i = 0; i < _numCPUs; ++i) {
+		assert(_cpuStates[i]._deque.empty());
+		_cpuStates[i].~CPUState();
+	}
+	MemoryAllocator::free(_cpuStates, _numCPUs * sizeof(CPUState));
+}
+
+bool WorkStealingHostScheduler::isCurrentComputePlace(ComputePlace *computePlace)
+{
+	WorkerThread *currentThread = WorkerThread::getCurrentWorkerThread();
+	return (currentThread != nullptr && currentThread->getComputePlace() == computePlace);
+}
+
+void WorkStealingHostScheduler::addSideTasks(
+	Task *tasks[],
+	const size_t numTasks,
+	ComputePlace *computePlace,
+	ReadyTaskHint hint
+) {
+	// Count the prioritized and affinity tasks before adding them, so that
+	// the CPUs look for them as soon as they can be served. The strict tasks
+	// that nobody can run lose their affinity before being counted
+	long prioritized = 0;
+	for (size_t t = 0; t < numTasks; ++t) {
+		resolveStrictAffinity(tasks[t]);
+		if (isUrgent(tasks[t])) {
+			++prioritized;
+		}
+	}
+	if (prioritized > 0) {
+		_prioritizedTasks += prioritized;
+	}
+
+	HostScheduler::addReadyTasks(tasks, numTasks, computePlace, hint);
+}
+
+void WorkStealingHostScheduler::addReadyTasks(
+	Task *tasks[],
+	const size_t numTasks,
+	ComputePlace *computePlace,
+	ReadyTaskHint hint
+) {
+	// Only the CPU that owns a deque can push to it
+	if (computePlace == nullptr || !isCurrentComputePlace(computePlace)) {
+		addSideTasks(tasks, numTasks, computePlace, hint);
+		return;
+	}
+
+	assert((size_t) computePlace->getIndex() < _numCPUs);
+	CPUState &state = _cpuStates[computePlace->getIndex()];
+
+	// Count the tasks that go to the deque or the slot before they can be
+	// stolen. The side tasks are counted and resume CPUs on their own
+	size_t numLocalTasks = 0;
+	for (size_t t = 0; t < numTasks; ++t) {
+		assert(tasks[t] != nullptr);
+		if (!needsSideScheduler(tasks[t], hint)) {
+			++numLocalTasks;
+		}
+	}
+	if (numLocalTasks > 0) {
+		_stealableTasks.fetch_add(numLocalTasks, std::memory_order_relaxed);
+	}
+
+	const bool dequeWasEmpty = state._deque.empty();
+	size_t numPushedTasks = 0;
+
+	for (size_t t = 0; t < numTasks; ++t) {
+		Task *task = tasks[t];
+
+		if (needsSideScheduler(task, hint)) {
+			addSideTasks(&task, 1, computePlace, hint);
+			continue;
+		}
+
+		if (_enableImmediateSuccessor && hint == SIBLING_TASK_HINT) {
+			// The previous immediate successor goes to the deque
+			task = state._immediateSuccessor.exchange(task, std::memory_order_acq_rel);
+			if (task == nullptr) {
+				continue;
+			}
+		}
+
+		state._deque.push(task);
+		++numPushedTasks;
+	}
+
+	// Resume a CPU for each task that this one is not going to run. When
+	// the deque was empty, resume at least one so that the pushed tasks
+	// are stolen while this CPU is busy, since nobody may be stealing
+	size_t numWakeUps = getNumTasksForOthers(computePlace, numLocalTasks, hint);
+	if (numWakeUps == 0 && dequeWasEmpty && numPushedTasks > 0) {
+		numWakeUps = 1;
+	}
+	if (numWakeUps > 0) {
+		CPUManager::executeCPUManagerPolicy(computePlace, REQUEST_CPUS, numWakeUps);
+	}
+}
+
+Task *WorkStealingHostScheduler::getSideTask(ComputePlace *computePlace)
+{
+	Task *task = HostScheduler::getReadyTask(computePlace);
+	if (task != nullptr && isUrgent(task)) {
+		--_prioritizedTasks;
+	}
+	return task;
+}
+
+Task *WorkStealingHostScheduler::getLocalTask(CPUState &state)
+{
+	Task *task = nullptr;
+
+	// The bottom of the deque has the last added task, and the top the
+	// first one, which the owner can also take as a thief
+	if (_policy == LIFO_POLICY) {
+		if (state._deque.pop(task)) {
+			return task;
+		}
+	} else {
+		while (!state._deque.empty()) {
+			if (state._deque.steal(task)) {
+				return task;
+			}
+		}
+	}
+	return nullptr;
+}
+
+Task *WorkStealingHostScheduler::stealTask(ComputePlace *computePlace, CPUState &state)
+{
+	const size_t cpuId = computePlace->getIndex();
+	const size_t numaId = ((CPU *) computePlace)->getNumaNodeId();
+	Task *task = nullptr;
+
+	// Xorshift generator to start at a random victim
+	uint64_t &seed = state._seed;
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+
+	// 1. Steal from the CPUs of the same NUMA node
+	if (numaId < _numaCPUs.size() && !_numaCPUs[numaId].empty()) {
+		Container::vector<size_t> const &neighbours = _numaCPUs[numaId];
+		const size_t start = seed % neighbours.size();
+		for (size_t i = 0; i < neighbours.size(); ++i) {
+			const size_t victim = neighbours[(start + i) % neighbours.size()];
+			if (victim != cpuId && _cpuStates[victim]._deque.steal(task)) {
+				return task;
+			}
+		}
+	}
+
+	// 2. Steal from any CPU
+	const size_t start = seed % _numCPUs;
+	for (size_t i = 0; i < _numCPUs; ++i) {
+		const size_t victim = (start + i) % _numCPUs;
+		if (victim != cpuId && _cpuStates[victim]._deque.steal(task)) {
+			return task;
+		}
+	}
+
+	return nullptr;
+}
+
+Task *WorkStealingHostScheduler::stealImmediateSuccessor()
+{
+	for (size_t i = 0; i < _numCPUs; ++i) {
+		if (_cpuStates[i]._immediateSuccessor.load(std::memory_order_relaxed) != nullptr) {
+			Task *task = _cpuStates[i]._immediateSuccessor.exchange(nullptr, std::memory_order_acq_rel);
+			if (task != nullptr) {
+				return task;
+			}
+		}
+	}
+	return nullptr;
+}
+
+bool WorkStealingHostScheduler::mustStopServingTasks(ComputePlace *computePlace) const
+{
+	// The CPU serving the side scheduler has to leave it to steal tasks
+	return HostScheduler::mustStopServingTasks(computePlace) || hasStealableTasks();
+}
+
+Task *WorkStealingHostScheduler::getReadyTask(ComputePlace *computePlace)
+{
+	assert(computePlace != nullptr);
+	assert(computePlace->getType() == nanos6_host_device);
+	assert((size_t) computePlace->getIndex() < _numCPUs);
+
+	CPUState &state = _cpuStates[computePlace->getIndex()];
+	Task *task = nullptr;
+
+	// 1. Check the side scheduler first while it has prioritized or affinity tasks,
+	// and periodically to not starve its taskfors and deadline tasks
+	if (_prioritizedTasks.load(std::memory_order_relaxed) > 0
+		|| ++state._tasksSinceSideCheck >= _sideCheckPeriod
+	) {
+		state._tasksSinceSideCheck = 0;
+		task = getSideTask(computePlace);
+		if (task != nullptr) {
+			return task;
+		}
+	}
+
+	// 2. Try to get my immediate successor
+	if (_enableImmediateSuccessor) {
+		task = takenStealableTask(state._immediateSuccessor.exchange(nullptr, std::memory_order_acq_rel));
+		if (task != nullptr) {
+			SchedulerStats::immediateSuccessorHit(computePlace);
+			return task;
+		}
+	}
+
+	// 3. Try to get work from my deque
+	task = takenStealableTask(getLocalTask(state));
+	if (task != nullptr) {
+		return task;
+	}
+
+	// 4. Try to steal work from the deques of other CPUs
+	task = takenStealableTask(stealTask(computePlace, state));
+	if (task != nullptr) {
+		return task;
+	}
+
+	// 5. Try to get work from the side scheduler. This CPU may stay there
+	// serving tasks to other CPUs until there is work to steal
+	task = getSideTask(computePlace);
+	if (task != nullptr) {
+		return task;
+	}
+
+	// 6. Try to steal again, since the CPU may have left the side scheduler
+	// because there was work to steal, and then the other immediate successors
+	task = stealTask(computePlace, state);
+	if (task == nullptr && _enableImmediateSuccessor) {
+		task = stealImmediateSuccessor();
+	}
+
+	return takenStealableTask(task);
+}
@@ -0,0 +1,148 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef WORK_STEALING_HOST_SCHEDULER_HPP
+#define WORK_STEALING_HOST_SCHEDULER_HPP
+
+#include <atomic>
+
+#include "HostScheduler.hpp"
+#include "support/ChaseLevDeque.hpp"
+#include "support/Containers.hpp"
+
+//! \brief Host scheduler with a work-stealing deque per CPU
+//!
+//! The ready tasks added by a worker CPU are pushed to its own Chase-Lev
+//! deque, and its immediate successor is kept in a per-CPU slot, without
+//! taking any lock. An idle CPU steals from the deques of the CPUs of its
+//! NUMA node first, and then from the rest of CPUs.
+//!
+//! The tasks that need a global decision are added to the base (delegation
+//! lock) scheduler instead, which is called the side scheduler here: taskfors,
+//! which are shared by the CPUs of a group, tasks with a deadline, tasks with
+//! a non-default priority or an affinity hint, and tasks added from outside a
+//! worker CPU. A CPU checks the side scheduler before its deque while there
+//! are prioritized or affinity tasks, every few tasks to avoid starving the
+//! rest, and when it finds no task to steal. The CPU that serves the side
+//! scheduler stops serving as soon as there is work to steal
+class WorkStealingHostScheduler : public HostScheduler {
+	struct CPUState {
+		//! Ready tasks added by the CPU
+		ChaseLevDeque<Task *> _deque;
+
+		//! Immediate successor of the last task run by the CPU
+		std::atomic<Task *> _immediateSuccessor;
+
+		//! Tasks obtained since the last check of the side scheduler
+		size_t _tasksSinceSideCheck;
+
+		//! State of the random generator to select victims
+		uint64_t _seed;
+
+		CPUState(uint64_t seed) :
+			_deque(),
+			_immediateSuccessor(nullptr),
+			_tasksSinceSideCheck(0),
+			_seed(seed)
+		{
+		}
+	};
+
+	//! Number of CPUs and their states, indexed by CPU index
+	size_t _numCPUs;
+	CPUState *_cpuStates;
+
+	//! Indices of the CPUs of each NUMA node
+	Container::vector<Container::vector<size_t>> _numaCPUs;
+
+	SchedulingPolicy _policy;
+	bool _enablePriority;
+	bool _enableImmediateSuccessor;
+
+	//! Number of prioritized and affinity tasks in the side scheduler
+	std::atomic<long> _prioritizedTasks;
+
+	//! Number of tasks in the deques and immediate successor slots. It is
+	//! increased before the tasks are added, so it does not go below zero
+	std::atomic<long> _stealableTasks;
+
+	//! Number of tasks after which a CPU checks the side scheduler
+	size_t _sideCheckPeriod;
+
+	//! \brief Check whether the current thread runs on a compute place
+	static bool isCurrentComputePlace(ComputePlace *computePlace);
+
+	inline bool isPrioritized(Task *task) const
+	{
+		return _enablePriority && task->getPriority() != 0 && !task->isTaskfor();
+	}
+
+	//! \brief Check whether the CPUs should look for a task in the side
+	//! scheduler before their deques
+	inline bool isUrgent(Task *task) const
+	{
+		return isPrioritized(task) || (task->hasAffinity() && !task->isTaskfor());
+	}
+
+	inline bool needsSideScheduler(Task *task, ReadyTaskHint hint) const
+	{
+		return hint == DEADLINE_TASK_HINT || task->isTaskfor() || isUrgent(task);
+	}
+
+	//! \brief Add tasks to the side scheduler, counting the urgent ones
+	void addSideTasks(Task *tasks[], const size_t numTasks, ComputePlace *computePlace, ReadyTaskHint hint);
+
+	//! \brief Get a task from the side scheduler
+	Task *getSideTask(ComputePlace *computePlace);
+
+	//! \brief Get a task from the deque of a CPU
+	Task *getLocalTask(CPUState &state);
+
+	//! \brief Steal a task from the deques of other CPUs
+	Task *stealTask(ComputePlace *computePlace, CPUState &state);
+
+	//! \brief Steal the immediate successor of another CPU
+	Task *stealImmediateSuccessor();
+
+	//! \brief Check whether there is any task in the deques or slots
+	inline bool hasStealableTasks() const
+	{
+		return _stealableTasks.load(std::memory_order_relaxed) > 0;
+	}
+
+	//! \brief Account for a task taken from a deque or slot, if any
+	inline Task *takenStealableTask(Task *task)
+	{
+		if (task != nullptr) {
+			_stealableTasks.fetch_sub(1, std::memory_order_relaxed);
+		}
+		return task;
+	}
+
+	bool mustStopServingTasks(ComputePlace *computePlace) const;
+
+public:
+	WorkStealingHostScheduler(
+		size_t totalComputePlaces,
+		SchedulingPolicy policy,
+		bool enablePriority,
+		bool enableImmediateSuccessor,
+		bool enableNUMAQueues
+	);
+
+	virtual ~WorkStealingHostScheduler();
+
+	void addReadyTasks(Task *tasks[], const size_t numTasks, ComputePlace *computePlace, ReadyTaskHint hint);
+
+	Task *getReadyTask(ComputePlace *computePlace);
+
+	inline std::string getName() const
+	{
+		return "WorkStealingHostScheduler";
+	}
+};
+
+#endif // WORK_STEALING_HOST_SCHEDULER_HPP
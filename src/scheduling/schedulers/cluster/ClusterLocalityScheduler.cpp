@@ -72,8 +72,7 @@ void ClusterLocalityScheduler::addReadyTask(
 	}
 
 	assert(!bytes.empty());
-	std::vector<size_t>::iterator it = bytes.begin();
-	const size_t nodeId = std::distance(it, std::max_element(it, it + _clusterSize));
+	const size_t nodeId = getClosestNode(bytes);
 
 	addReadyLocalOrExecuteRemote(nodeId, task, computePlace, hint);
 }
@@ -7,6 +7,9 @@
 #ifndef CLUSTER_LOCALITY_SCHEDULER_HPP
 #define CLUSTER_LOCALITY_SCHEDULER_HPP
 
+#include <cstdint>
+#include <vector>
+
 #include "scheduling/schedulers/cluster/ClusterSchedulerInterface.hpp"
 #include "system/RuntimeInfo.hpp"
 
@@ -23,6 +26,41 @@ private:
 		return location->getIndex();
 	}
 
+	//! \brief Find the node that minimizes the cost of moving the data of a task
+	//!
+	//! The cost of running on a node is the number of bytes located on
+	//! every other node weighted by their distance. With equidistant
+	//! nodes this is the node holding most of the data, otherwise nodes
+	//! that share a host with the data are preferred. Saturated nodes are
+	//! not considered
+	//!
+	//! \param[in] bytes is the number of bytes of the task on every node
+	inline size_t getClosestNode(std::vector<size_t> const &bytes) const
+	{
+		size_t bestNode = 0;
+		size_t bestCost = SIZE_MAX;
+
+		for (size_t candidate = 0; candidate < (size_t) _clusterSize; ++candidate) {
+			if (isSaturated(candidate)) {
+				continue;
+			}
+
+			size_t cost = 0;
+			for (size_t location = 0; location < (size_t) _clusterSize; ++location) {
+				if (bytes[location] != 0) {
+					cost += bytes[location] * ClusterManager::getDistance(candidate, location);
+				}
+			}
+
+			if (cost < bestCost) {
+				bestCost = cost;
+				bestNode = candidate;
+			}
+		}
+
+		return bestNode;
+	}
+
 public:
 	ClusterLocalityScheduler() : ClusterSchedulerInterface("ClusterLocalityScheduler")
 	{
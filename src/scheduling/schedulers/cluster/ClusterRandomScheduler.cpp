@@ -37,5 +37,12 @@ void ClusterRandomScheduler::addReadyTask(
 		return;
 	}
 
-	addReadyLocalOrExecuteRemote(distr(eng), task, computePlace, hint);
+	// Take the first node that is not saturated, starting from a random one.
+	// The current node is never saturated
+	size_t nodeId = distr(eng);
+	while (isSaturated(nodeId)) {
+		nodeId = (nodeId + 1) % _clusterSize;
+	}
+
+	addReadyLocalOrExecuteRemote(nodeId, task, computePlace, hint);
 }
@@ -7,7 +7,11 @@
 #ifndef CLUSTER_SCHEDULER_INTERFACE_HPP
 #define CLUSTER_SCHEDULER_INTERFACE_HPP
 
+#include <algorithm>
+
+#include "lowlevel/FatalErrorHandler.hpp"
 #include "scheduling/SchedulerInterface.hpp"
+#include "support/config/ConfigVariable.hpp"
 #include "system/RuntimeInfo.hpp"
 
 #include <ClusterManager.hpp>
@@ -24,6 +28,37 @@ protected:
 	//! Scheduler name
 	const std::string _name;
 
+	//! Memory pressure (0-100%) from which a node is saturated. Zero
+	//! disables the check
+	size_t _saturationPressure;
+
+	//! Number of pending offloaded tasks from which a node is saturated.
+	//! Zero disables the check
+	size_t _saturationTasks;
+
+	//! \brief Check whether a node should not receive more offloaded tasks
+	//!
+	//! The load of a remote node is refreshed by the MessageTaskFinished of
+	//! the tasks offloaded to it. Thus, a node without pending tasks from
+	//! the current node is never saturated, so that its load is eventually
+	//! refreshed. The current node is never saturated either
+	inline bool isSaturated(size_t nodeId) const
+	{
+		ClusterNode const *node = ClusterManager::getClusterNode(nodeId);
+		const size_t offloadedTasks = node->getNumOffloadedTasks();
+
+		if (node == _thisNode || offloadedTasks == 0) {
+			return false;
+		}
+
+		if (_saturationPressure > 0 && node->getMemoryPressure() >= _saturationPressure) {
+			return true;
+		}
+
+		const size_t remoteTasks = std::max(offloadedTasks, node->getNumRemoteTasks());
+		return (_saturationTasks > 0 && remoteTasks >= _saturationTasks);
+	}
+
 	//! Function to pass the task to the local scheduler or call the execute function in workflow
 	//! when the task is remote.
 	void addReadyLocalOrExecuteRemote(
@@ -49,6 +84,15 @@ public:
 		_clusterSize(ClusterManager::clusterSize()),
 		_name(name)
 	{
+		ConfigVariable<size_t> saturationPressure("cluster.saturation.memory_pressure");
+		ConfigVariable<size_t> saturationTasks("cluster.saturation.tasks");
+
+		_saturationPressure = saturationPressure.getValue();
+		_saturationTasks = saturationTasks.getValue();
+
+		FatalErrorHandler::failIf(_saturationPressure > 100,
+			"cluster.saturation.memory_pressure must be between 0 and 100%");
+
 		RuntimeInfo::addEntry("cluster-scheduler", "Cluster Scheduler", _name);
 	}
 
@@ -63,6 +107,20 @@ public:
 
 	virtual void addReadyTask(Task *task, ComputePlace *computePlace, ReadyTaskHint hint = NO_HINT) = 0;
 
+	//! The cluster scheduling decisions are taken for each task, so the
+	//! tasks of a batch cannot be added directly to the local scheduler
+	inline void addReadyTasks(
+		nanos6_device_t,
+		Task *tasks[],
+		const size_t numTasks,
+		ComputePlace *computePlace,
+		ReadyTaskHint hint)
+	{
+		for (size_t t = 0; t < numTasks; ++t) {
+			addReadyTask(tasks[t], computePlace, hint);
+		}
+	}
+
 };
 
 #endif // CLUSTER_SCHEDULER_INTERFACE_HPP
@@ -0,0 +1,182 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef CHASE_LEV_DEQUE_HPP
+#define CHASE_LEV_DEQUE_HPP
+
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "lowlevel/Padding.hpp"
+
+
+//! \brief Lock-free work-stealing deque of Chase and Lev
+//!
+//! The owner thread pushes and pops elements at the bottom of the deque,
+//! while any other thread can steal elements from the top. The memory
+//! orderings follow the C11 formulation of Lê et al. (PPoPP'13). The
+//! buffer grows when it is full; the old buffers are kept until the deque
+//! is destroyed, since a concurrent thief may still be reading them
+//!
+//! \tparam T the type of the elements, which must be trivially copyable
+template <typename T>
+class ChaseLevDeque {
+	struct Buffer {
+		int64_t _mask;
+		std::atomic<T> *_elements;
+		Buffer *_previous;
+
+		Buffer(int64_t capacity, Buffer *previous) :
+			_mask(capacity - 1),
+			_elements(new std::atomic<T>[capacity]),
+			_previous(previous)
+		{
+			assert((capacity & _mask) == 0);
+		}
+
+		~Buffer()
+		{
+			delete [] _elements;
+		}
+
+		inline int64_t getCapacity() const
+		{
+			return _mask + 1;
+		}
+
+		inline T get(int64_t index) const
+		{
+			return _elements[index & _mask].load(std::memory_order_relaxed);
+		}
+
+		inline void put(int64_t index, T element)
+		{
+			_elements[index & _mask].store(element, std::memory_order_relaxed);
+		}
+	};
+
+	alignas(CACHELINE_SIZE) std::atomic<int64_t> _top;
+	alignas(CACHELINE_SIZE) std::atomic<int64_t> _bottom;
+	std::atomic<Buffer *> _buffer;
+
+	//! \brief Replace the buffer by another one with twice its capacity
+	inline Buffer *grow(Buffer *buffer, int64_t bottom, int64_t top)
+	{
+		Buffer *bigger = new Buffer(buffer->getCapacity() * 2, buffer);
+		for (int64_t i = top; i < bottom; ++i) {
+			bigger->put(i, buffer->get(i));
+		}
+		_buffer.store(bigger, std::memory_order_release);
+		return bigger;
+	}
+
+public:
+	//! \param[in] capacity the initial capacity, which must be a power of two
+	ChaseLevDeque(size_t capacity = 1024) :
+		_top(0),
+		_bottom(0),
+		_buffer(new Buffer(capacity, nullptr))
+	{
+	}
+
+	~ChaseLevDeque()
+	{
+		Buffer *buffer = _buffer.load(std::memory_order_relaxed);
+		while (buffer != nullptr) {
+			Buffer *previous = buffer->_previous;
+			delete buffer;
+			buffer = previous;
+		}
+	}
+
+	ChaseLevDeque(ChaseLevDeque const &) = delete;
+	ChaseLevDeque &operator=(ChaseLevDeque const &) = delete;
+
+	//! \brief Push an element at the bottom. Only called by the owner
+	inline void push(T element)
+	{
+		int64_t bottom = _bottom.load(std::memory_order_relaxed);
+		int64_t top = _top.load(std::memory_order_acquire);
+		Buffer *buffer = _buffer.load(std::memory_order_relaxed);
+
+		if (bottom - top > buffer->getCapacity() - 1) {
+			buffer = grow(buffer, bottom, top);
+		}
+
+		buffer->put(bottom, element);
+		std::atomic_thread_fence(std::memory_order_release);
+		_bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	//! \brief Pop the element at the bottom. Only called by the owner
+	//!
+	//! \returns true if an element was popped
+	inline bool pop(T &element)
+	{
+		int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+		Buffer *buffer = _buffer.load(std::memory_order_relaxed);
+		_bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t top = _top.load(std::memory_order_relaxed);
+
+		if (top > bottom) {
+			// Empty deque
+			_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		element = buffer->get(bottom);
+		if (top == bottom) {
+			// Last element; race against the thieves
+			bool won = _top.compare_exchange_strong(top, top + 1,
+				std::memory_order_seq_cst, std::memory_order_relaxed);
+			_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+
+	//! \brief Steal the element at the top. Can be called by any thread
+	//!
+	//! \returns true if an element was stolen. A false result does not
+	//! guarantee that the deque is empty, since the thief may have lost
+	//! a race against another thief or the owner
+	inline bool steal(T &element)
+	{
+		int64_t top = _top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t bottom = _bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom) {
+			return false;
+		}
+
+		Buffer *buffer = _buffer.load(std::memory_order_acquire);
+		element = buffer->get(top);
+		return _top.compare_exchange_strong(top, top + 1,
+			std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+
+	//! \brief Approximate number of elements, which is exact for the owner
+	//! when there are no concurrent thieves
+	inline size_t size() const
+	{
+		int64_t bottom = _bottom.load(std::memory_order_relaxed);
+		int64_t top = _top.load(std::memory_order_relaxed);
+		return (bottom > top) ? (size_t) (bottom - top) : 0;
+	}
+
+	inline bool empty() const
+	{
+		return size() == 0;
+	}
+};
+
+
+#endif // CHASE_LEV_DEQUE_HPP
@@ -0,0 +1,249 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef FLAT_POINTER_MAP_HPP
+#define FLAT_POINTER_MAP_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include <MemoryAllocator.hpp>
+
+
+//! \brief Open-addressing hash map whose keys are non-null pointers
+//!
+//! The entries are stored in a single power-of-two table with linear probing,
+//! so a lookup usually touches a single cache line. The first table is inlined
+//! in the map, and it is only replaced by a table from the memory allocator
+//! when the map grows, so the maps with few keys do not allocate at all. The
+//! null pointer marks the empty slots and the entries cannot be erased, which
+//! avoids the tombstones. Inserting may move the entries, so the iterators and
+//! references are invalidated by emplace. The map is not thread-safe
+//!
+//! \tparam T the type of the values, which must be default-constructible
+//! \tparam INLINE_CAPACITY the number of slots of the inlined table
+template <typename T, size_t INLINE_CAPACITY = 4>
+class FlatPointerMap {
+	static_assert(INLINE_CAPACITY >= 2 && (INLINE_CAPACITY & (INLINE_CAPACITY - 1)) == 0,
+		"The inline capacity must be a power of two");
+
+public:
+	typedef std::pair<void *, T> value_type;
+
+	class iterator {
+		value_type *_slot;
+		value_type *_end;
+
+		inline void skipEmpty()
+		{
+			while (_slot != _end && _slot->first == nullptr)
+				++_slot;
+		}
+
+	public:
+		iterator() :
+			_slot(nullptr),
+			_end(nullptr)
+		{
+		}
+
+		iterator(value_type *slot, value_type *end) :
+			_slot(slot),
+			_end(end)
+		{
+			skipEmpty();
+		}
+
+		inline value_type &operator*() const
+		{
+			return *_slot;
+		}
+
+		inline value_type *operator->() const
+		{
+			return _slot;
+		}
+
+		inline iterator &operator++()
+		{
+			++_slot;
+			skipEmpty();
+			return *this;
+		}
+
+		inline iterator operator++(int)
+		{
+			iterator previous(*this);
+			++(*this);
+			return previous;
+		}
+
+		inline bool operator==(const iterator &other) const
+		{
+			return (_slot == other._slot);
+		}
+
+		inline bool operator!=(const iterator &other) const
+		{
+			return (_slot != other._slot);
+		}
+	};
+
+private:
+	value_type *_table;
+	size_t _capacity;
+	size_t _size;
+
+	//! Right shift that leaves log2(capacity) bits of the hash
+	unsigned int _shift;
+
+	value_type _inlineTable[INLINE_CAPACITY];
+
+	//! Fibonacci hashing, which takes the upper bits of the product so that
+	//! the alignment of the pointers does not matter
+	inline size_t slotOf(void *key) const
+	{
+		return (size_t) (((uint64_t) (uintptr_t) key * 0x9E3779B97F4A7C15ULL) >> _shift);
+	}
+
+	//! \brief Find the slot of a key, or the empty slot where it would go
+	inline value_type *probe(void *key) const
+	{
+		const size_t mask = _capacity - 1;
+		size_t slot = slotOf(key);
+
+		while (_table[slot].first != key && _table[slot].first != nullptr) {
+			slot = (slot + 1) & mask;
+		}
+
+		return &_table[slot];
+	}
+
+	//! Grow the table to keep the load factor under 0.75
+	void grow()
+	{
+		value_type *oldTable = _table;
+		const size_t oldCapacity = _capacity;
+
+		_capacity = oldCapacity * 2;
+		_shift--;
+		_table = (value_type *) MemoryAllocator::alloc(_capacity * sizeof(value_type));
+		assert(_table != nullptr);
+
+		for (size_t i = 0; i < _capacity; ++i) {
+			new (&_table[i]) value_type();
+		}
+
+		for (size_t i = 0; i < oldCapacity; ++i) {
+			if (oldTable[i].first != nullptr) {
+				value_type *slot = probe(oldTable[i].first);
+				assert(slot->first == nullptr);
+				*slot = std::move(oldTable[i]);
+			}
+		}
+
+		if (oldTable != _inlineTable) {
+			destroyTable(oldTable, oldCapacity);
+		}
+	}
+
+	static inline void destroyTable(value_type *table, size_t capacity)
+	{
+		for (size_t i = 0; i < capacity; ++i) {
+			table[i].~value_type();
+		}
+		MemoryAllocator::free(table, capacity * sizeof(value_type));
+	}
+
+	static constexpr unsigned int log2(size_t value)
+	{
+		return (value <= 1) ? 0 : 1 + log2(value / 2);
+	}
+
+public:
+	FlatPointerMap() :
+		_table(_inlineTable),
+		_capacity(INLINE_CAPACITY),
+		_size(0),
+		_shift(64 - log2(INLINE_CAPACITY)),
+		_inlineTable()
+	{
+	}
+
+	~FlatPointerMap()
+	{
+		if (_table != _inlineTable) {
+			destroyTable(_table, _capacity);
+		}
+	}
+
+	//! The inline table would be left behind
+	FlatPointerMap(const FlatPointerMap &) = delete;
+	FlatPointerMap &operator=(const FlatPointerMap &) = delete;
+
+	inline size_t size() const
+	{
+		return _size;
+	}
+
+	inline bool empty() const
+	{
+		return (_size == 0);
+	}
+
+	inline iterator begin()
+	{
+		return iterator(_table, _table + _capacity);
+	}
+
+	inline iterator end()
+	{
+		return iterator(_table + _capacity, _table + _capacity);
+	}
+
+	inline iterator find(void *key)
+	{
+		assert(key != nullptr);
+
+		value_type *slot = probe(key);
+		if (slot->first == nullptr)
+			return end();
+
+		return iterator(slot, _table + _capacity);
+	}
+
+	//! \brief Insert a value constructed from the arguments if the key is not
+	//! in the map
+	//!
+	//! \returns the iterator to the entry of the key, and whether it was inserted
+	template <typename... TS>
+	std::pair<iterator, bool> emplace(void *key, TS &&... args)
+	{
+		assert(key != nullptr);
+
+		value_type *slot = probe(key);
+		if (slot->first != nullptr)
+			return std::make_pair(iterator(slot, _table + _capacity), false);
+
+		if ((_size + 1) * 4 > _capacity * 3) {
+			grow();
+			slot = probe(key);
+			assert(slot->first == nullptr);
+		}
+
+		slot->first = key;
+		slot->second = T(std::forward<TS>(args)...);
+		_size++;
+
+		return std::make_pair(iterator(slot, _table + _capacity), true);
+	}
+};
+
+
+#endif // FLAT_POINTER_MAP_HPP
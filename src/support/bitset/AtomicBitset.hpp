@@ -102,6 +102,20 @@ public:
 		elem.fetch_and(~(ONE << getBitIndex(pos)), std::memory_order_release);
 	}
 
+	//! \brief Set a single bit in the AtomicBitset if it was a 0
+	//!
+	//! \remark This function is wait-free and has O(1) complexity
+	//!
+	//! \param[in] pos position of the bit to set
+	//!
+	//! \return Whether the bit was a 0 and has been set by this call
+	inline bool trySet(size_t pos)
+	{
+		backing_t &elem = getStorage(pos);
+		const backingstorage_t mask = (ONE << getBitIndex(pos));
+		return !(elem.fetch_or(mask, std::memory_order_acquire) & mask);
+	}
+
 	//! \brief Set the first found zero-bit in the AtomicBitset
 	//!
 	//! \remark This function only provides one guarantee: if a position != -1 is
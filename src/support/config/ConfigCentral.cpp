@@ -16,11 +16,20 @@ void ConfigCentral::initialize()
 	// Cluster
 	registerOption<bool_t>("cluster.services_in_task", false);
 	registerOption<string_t>("cluster.communication", "disabled");
+	registerOption<string_t>("cluster.distance_matrix", "");
 	registerOption<memory_t>("cluster.distributed_memory", 2UL << 30);
 	registerOption<memory_t>("cluster.local_memory", 0);
+	registerOption<integer_t>("cluster.saturation.memory_pressure", 90);
+	registerOption<integer_t>("cluster.saturation.tasks", 0);
 	registerOption<string_t>("cluster.scheduling_policy", "locality");
 	registerOption<integer_t>("cluster.va_start", 0);
 	registerOption<bool_t>("cluster.use_namespace", false);
+	registerOption<memory_t>("cluster.transfer.chunk_size", 64 * 1024 * 1024);
+	registerOption<integer_t>("cluster.transfer.max_inflight_chunks", 4);
+	registerOption<bool_t>("cluster.compression.enabled", false);
+	registerOption<memory_t>("cluster.compression.threshold", 1024 * 1024);
+	registerOption<memory_t>("cluster.compression.chunk_size", 256 * 1024);
+	registerOption<integer_t>("cluster.compression.element_size", 4);
 
 	// CPU manager
 	registerOption<string_t>("cpumanager.policy", "default");
@@ -114,15 +123,26 @@ void ConfigCentral::initialize()
 	registerOption<bool_t>("monitoring.wisdom", false);
 
 	// Scheduler
+	registerOption<integer_t>("scheduler.affinity_spill_time", 1000);
+	registerOption<bool_t>("scheduler.critical_path_priority", false);
 	registerOption<bool_t>("scheduler.immediate_successor", true);
+	registerOption<bool_t>("scheduler.locality_immediate_successor", false);
+	registerOption<bool_t>("scheduler.numa_data_affinity", true);
 	registerOption<string_t>("scheduler.policy", "fifo");
 	registerOption<bool_t>("scheduler.priority", true);
+	registerOption<bool_t>("scheduler.stats_lock_times", false);
+	registerOption<bool_t>("scheduler.stats_report", false);
+	registerOption<bool_t>("scheduler.work_stealing", false);
+	registerOption<integer_t>("scheduler.work_stealing_check_period", 64);
 
 	// Taskfor
+	registerOption<integer_t>("taskfor.adaptive_chunk_time", 100);
 	registerOption<integer_t>("taskfor.groups", 1);
 	registerOption<bool_t>("taskfor.report", false);
+	registerOption<string_t>("taskfor.schedule", "static");
 
 	// Throttle
+	registerOption<bool_t>("throttle.cluster_aware", false);
 	registerOption<bool_t>("throttle.enabled", false);
 	registerOption<memory_t>("throttle.max_memory", 0);
 	registerOption<integer_t>("throttle.pressure", 70);
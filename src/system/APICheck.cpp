@@ -18,6 +18,7 @@ static const nanos6_api_versions_t apiVersions = {
 	.api_check_api_version = nanos6_api_check_api,
 	.major_api_version = nanos6_major_api,
 
+	.affinity_api_version = nanos6_affinity_api,
 	.blocking_api_version = nanos6_blocking_api,
 	.bootstrap_api_version = nanos6_bootstrap_api,
 	.cluster_api_version = nanos6_cluster_api,
@@ -36,6 +37,7 @@ static const nanos6_api_versions_t apiVersions = {
 	.task_execution_api_version = nanos6_task_execution_api,
 	.task_info_registration_api_version = nanos6_task_info_registration_api,
 	.loop_api_version = nanos6_loop_api,
+	.taskgraph_api_version = nanos6_taskgraph_api,
 	.taskwait_api_version = nanos6_taskwait_api,
 };
 
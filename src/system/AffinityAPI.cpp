@@ -0,0 +1,117 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <cassert>
+#include <cstdint>
+#include <numa.h>
+
+#include <nanos6/affinity.h>
+
+#include "executors/threads/CPU.hpp"
+#include "executors/threads/CPUManager.hpp"
+#include "hardware/HardwareInfo.hpp"
+#include "tasks/Task.hpp"
+
+#include <VirtualMemoryManagement.hpp>
+
+
+//! \brief Get an owned CPU given its system identifier
+//!
+//! \returns the CPU, or nullptr if the runtime does not own it
+static CPU *getOwnedCPU(size_t systemCPUId)
+{
+	const std::vector<CPU *> &cpus = CPUManager::getCPUListReference();
+	for (CPU *cpu : cpus) {
+		assert(cpu != nullptr);
+		if (cpu->getSystemCPUId() == systemCPUId) {
+			return cpu->isOwned() ? cpu : nullptr;
+		}
+	}
+	return nullptr;
+}
+
+//! \brief Check whether the runtime owns any CPU of a NUMA node
+static bool hasOwnedCPUs(size_t numaId)
+{
+	const std::vector<CPU *> &cpus = CPUManager::getCPUListReference();
+	for (CPU *cpu : cpus) {
+		assert(cpu != nullptr);
+		if (cpu->getNumaNodeId() == numaId && cpu->isOwned()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//! \brief Get the NUMA node that holds an address
+//!
+//! \returns the NUMA node, or the number of NUMA nodes if unknown
+static size_t getAddressNUMANode(void const *address, size_t numNUMANodes)
+{
+	// The memory allocated by the runtime has a known NUMA node
+	size_t numaId = VirtualMemoryManagement::findNUMA((void *) address);
+	if (numaId < numNUMANodes) {
+		return numaId;
+	}
+
+	// Otherwise ask the kernel where the page is. The page may not be
+	// touched yet, in which case it has no NUMA node
+	if (numa_available() != -1) {
+		const uintptr_t pageSize = HardwareInfo::getPageSize();
+		void *page = (void *) ((uintptr_t) address & ~(pageSize - 1));
+		int status = -1;
+		if (numa_move_pages(0, 1, &page, nullptr, &status, 0) == 0 && status >= 0) {
+			return (size_t) status;
+		}
+	}
+
+	return numNUMANodes;
+}
+
+
+extern "C" int nanos6_set_task_affinity(void *taskHandle, nanos6_affinity_t const *affinity)
+{
+	Task *task = (Task *) taskHandle;
+	assert(task != nullptr);
+
+	if (affinity == nullptr || affinity->target == nanos6_affinity_none) {
+		task->setAffinity(-1, -1, false);
+		return 1;
+	}
+
+	const size_t numNUMANodes = HardwareInfo::getMemoryPlaceCount(nanos6_host_device);
+	const bool strict = (affinity->mode == nanos6_affinity_strict);
+
+	size_t numaId = numNUMANodes;
+	int cpuId = -1;
+
+	switch (affinity->target) {
+		case nanos6_affinity_numa_node:
+			numaId = affinity->index;
+			break;
+		case nanos6_affinity_cpu: {
+			CPU *cpu = getOwnedCPU(affinity->index);
+			if (cpu != nullptr) {
+				cpuId = cpu->getIndex();
+				numaId = cpu->getNumaNodeId();
+			}
+			break;
+		}
+		case nanos6_affinity_address:
+			numaId = getAddressNUMANode(affinity->address, numNUMANodes);
+			break;
+		default:
+			break;
+	}
+
+	// Nobody would run the task if its NUMA node has no CPUs
+	if (numaId >= numNUMANodes || !hasOwnedCPUs(numaId)) {
+		return 0;
+	}
+
+	task->setAffinity(cpuId, (int) numaId, strict);
+	return 1;
+}
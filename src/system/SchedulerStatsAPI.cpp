@@ -0,0 +1,19 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <cassert>
+
+#include <nanos6/runtime-info.h>
+
+#include "scheduling/SchedulerStats.hpp"
+
+
+extern "C" void nanos6_get_scheduler_stats(nanos6_scheduler_stats_t *stats)
+{
+	assert(stats != nullptr);
+
+	SchedulerStats::getStats(*stats);
+}
@@ -0,0 +1,53 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <cassert>
+
+#include <nanos6/taskgraph.h>
+
+#include "executors/threads/WorkerThread.hpp"
+#include "tasks/Task.hpp"
+#include "tasks/TaskGraph.hpp"
+
+#include <MemoryAllocator.hpp>
+
+
+static inline Task *getCurrentTask()
+{
+	WorkerThread *currentThread = WorkerThread::getCurrentWorkerThread();
+	assert(currentThread != nullptr);
+
+	Task *currentTask = currentThread->getTask();
+	assert(currentTask != nullptr);
+
+	return currentTask;
+}
+
+extern "C" nanos6_taskgraph_t nanos6_taskgraph_create(void)
+{
+	return MemoryAllocator::newObject<TaskGraph>();
+}
+
+extern "C" void nanos6_taskgraph_destroy(nanos6_taskgraph_t graph)
+{
+	assert(graph != nullptr);
+
+	MemoryAllocator::deleteObject<TaskGraph>((TaskGraph *) graph);
+}
+
+extern "C" int nanos6_taskgraph_begin(nanos6_taskgraph_t graph)
+{
+	assert(graph != nullptr);
+
+	return (int) ((TaskGraph *) graph)->begin(getCurrentTask());
+}
+
+extern "C" void nanos6_taskgraph_end(nanos6_taskgraph_t graph)
+{
+	assert(graph != nullptr);
+
+	((TaskGraph *) graph)->end(getCurrentTask());
+}
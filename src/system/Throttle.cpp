@@ -6,6 +6,7 @@
 
 #include <nanos6.h>
 
+#include <ClusterManager.hpp>
 #include <MemoryAllocator.hpp>
 
 #include "DataAccessRegistration.hpp"
@@ -20,6 +21,7 @@ ConfigVariable<bool> Throttle::_enabled("throttle.enabled");
 ConfigVariable<int> Throttle::_throttleTasks("throttle.tasks");
 ConfigVariable<int> Throttle::_throttlePressure("throttle.pressure");
 ConfigVariable<StringifiedMemorySize> Throttle::_throttleMem("throttle.max_memory");
+ConfigVariable<bool> Throttle::_clusterAware("throttle.cluster_aware");
 
 void Throttle::initialize()
 {
@@ -63,7 +65,15 @@ int Throttle::evaluate(void *)
 	assert(_throttleMem.getValue() != 0);
 
 	size_t memoryUsage = MemoryAllocator::getMemoryUsage();
-	_pressure = std::min((memoryUsage * 100) / _throttleMem.getValue(), (size_t)100);
+	size_t pressure = std::min((memoryUsage * 100) / _throttleMem.getValue(), (size_t)100);
+
+	// In cluster mode, the pending work can be offloaded to other nodes unless
+	// all of them are under pressure too
+	if (_clusterAware && ClusterManager::inClusterMode()) {
+		pressure = std::max(pressure, ClusterManager::getRemoteMemoryPressure());
+	}
+
+	_pressure = pressure;
 
 	return 0;
 }
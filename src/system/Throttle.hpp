@@ -19,6 +19,7 @@ private:
 	static ConfigVariable<int> _throttleTasks;
 	static ConfigVariable<int> _throttlePressure;
 	static ConfigVariable<StringifiedMemorySize> _throttleMem;
+	static ConfigVariable<bool> _clusterAware;
 
 	static int getAllowedTasks(int nestingLevel);
 
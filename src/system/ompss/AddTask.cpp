@@ -13,6 +13,7 @@
 #include <config.h>
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 
@@ -32,6 +33,7 @@
 #include "system/TrackingPoints.hpp"
 #include "tasks/StreamExecutor.hpp"
 #include "tasks/Task.hpp"
+#include "tasks/TaskGraph.hpp"
 #include "tasks/TaskImplementation.hpp"
 #include "tasks/Taskfor.hpp"
 #include "tasks/Taskloop.hpp"
@@ -101,13 +103,26 @@ Task *AddTask::createTask(
 	size_t taskCountersSize = TaskHardwareCounters::getAllocationSize();
 	size_t taskStatisticsSize = Monitoring::getAllocationSize();
 
+	// The look-ahead rank of the critical path priority goes right before
+	// the task, so that the task can find it without a pointer
+	size_t lookAheadRankSize = 0;
+	if (Scheduler::isCriticalPathPriorityEnabled()) {
+		static_assert(sizeof(Task::LookAheadRank) % DATA_ALIGNMENT_SIZE == 0,
+			"The look-ahead rank would misalign the task");
+
+		lookAheadRankSize = sizeof(Task::LookAheadRank);
+		flags |= (size_t) Task::nanos6_task_runtime_flag_t::nanos6_look_ahead_flag;
+	}
+
 	bool hasPreallocatedArgsBlock = (flags & nanos6_preallocated_args_block);
 	if (hasPreallocatedArgsBlock) {
 		assert(argsBlock != nullptr);
-		task = (Task *) MemoryAllocator::alloc(taskSize
+		void *block = MemoryAllocator::alloc(lookAheadRankSize
+			+ taskSize
 			+ taskAccessesSize
 			+ taskCountersSize
 			+ taskStatisticsSize);
+		task = (Task *) ((char *) block + lookAheadRankSize);
 	} else {
 		// Alignment fixup
 		const size_t missalignment = argsBlockSize & (DATA_ALIGNMENT_SIZE - 1);
@@ -115,11 +130,16 @@ Task *AddTask::createTask(
 		argsBlockSize += correction;
 
 		// Allocation and layout
-		argsBlock = MemoryAllocator::alloc(argsBlockSize + taskSize
+		argsBlock = MemoryAllocator::alloc(argsBlockSize + lookAheadRankSize
+			+ taskSize
 			+ taskAccessesSize
 			+ taskCountersSize
 			+ taskStatisticsSize);
-		task = (Task *) ((char *) argsBlock + argsBlockSize);
+		task = (Task *) ((char *) argsBlock + argsBlockSize + lookAheadRankSize);
+	}
+
+	if (lookAheadRankSize > 0) {
+		new ((char *) task - lookAheadRankSize) Task::LookAheadRank();
 	}
 
 	Instrument::createdArgsBlock(taskId, argsBlock, originalArgsBlockSize, argsBlockSize);
@@ -172,6 +192,22 @@ void AddTask::submitTask(Task *task, Task *parent, bool fromUserCode)
 		assert(computePlace != nullptr);
 	}
 
+	// The tasks that the user submits in the region of a task graph are
+	// recorded or replayed. This may wait for the previous children of the
+	// parent, so it is done before the task becomes one of them
+	TaskGraph *taskGraph = nullptr;
+	bool replayed = false;
+	if (parent != nullptr) {
+		if (parent->getTaskGraph() != nullptr) {
+			parent->getTaskGraph()->nestedTaskSubmitted(parent);
+		}
+
+		taskGraph = parent->getActiveTaskGraph();
+		if (taskGraph != nullptr && fromUserCode) {
+			replayed = taskGraph->submitTask(task);
+		}
+	}
+
 	// Set the parent and check if it is a stream executor
 	if (parent != nullptr) {
 		task->setParent(parent);
@@ -206,12 +242,28 @@ void AddTask::submitTask(Task *task, Task *parent, bool fromUserCode)
 		Instrument::taskHasNewPriority(task->getInstrumentationTaskId(), task->getPriority());
 	}
 
+	// The look-ahead rank of the task starts at its predicted cost, and it is
+	// raised as its direct successors are registered. Use the cost clause of
+	// the task when Monitoring has no prediction
+	if (Scheduler::isCriticalPathPriorityEnabled()) {
+		const double prediction = Monitoring::getTaskTimePrediction(task);
+		Task::priority_t cost = (prediction != PREDICTION_UNAVAILABLE) ?
+			(Task::priority_t) prediction : (Task::priority_t) task->getCost();
+		task->setPredictedCost(std::max(cost, (Task::priority_t) 1));
+	}
+
 	bool ready = true;
 	const nanos6_task_info_t *taskInfo = task->getTaskInfo();
 
 	assert(taskInfo != 0);
 
-	if (taskInfo->register_depinfo != 0) {
+	if (replayed) {
+		// Runtime Tracking Point - The created task has unresolved dependencies and is pending
+		TrackingPoints::taskIsPending(task);
+
+		// Wait only for the recorded predecessors
+		ready = taskGraph->registerReplayedTask(task);
+	} else if (taskInfo->register_depinfo != 0) {
 		assert(computePlace != nullptr);
 
 		Instrument::task_id_t taskInstrumentationId = task->getInstrumentationTaskId();
@@ -32,6 +32,7 @@ struct DataAccessBase;
 struct StreamFunctionCallback;
 class ComputePlace;
 class MemoryPlace;
+class TaskGraph;
 class TaskStatistics;
 class TasktypeData;
 class WorkerThread;
@@ -67,6 +68,7 @@ public:
 		remote_wrapper_flag,
 		remote_flag,
 		polling_flag,
+		look_ahead_flag,
 		total_flags
 	};
 
@@ -77,11 +79,30 @@ public:
 		nanos6_main_task_flag = (1 << main_task_flag),
 		nanos6_remote_wrapper_flag = (1 << remote_wrapper_flag),
 		nanos6_remote_flag = (1 << remote_flag),
-		nanos6_polling_flag = (1 << polling_flag)
+		nanos6_polling_flag = (1 << polling_flag),
+		nanos6_look_ahead_flag = (1 << look_ahead_flag)
 	};
 
 	typedef long priority_t;
 
+	//! Look-ahead rank of the critical path priority. It is only allocated
+	//! when that priority is enabled, right before the task, so the layout
+	//! of the task does not change
+	struct LookAheadRank {
+		//! Predicted cost of the task
+		priority_t _predictedCost;
+
+		//! Predicted cost plus the maximum predicted cost of the direct
+		//! successors registered so far
+		std::atomic<priority_t> _rank;
+
+		LookAheadRank() :
+			_predictedCost(0),
+			_rank(0)
+		{
+		}
+	};
+
 	typedef uint64_t deadline_t;
 
 private:
@@ -112,6 +133,25 @@ private:
 	//! Scheduling hint used by the scheduler
 	ReadyTaskHint _schedulingHint;
 
+	//! CPU index and NUMA node where the task should run, or -1 if none
+	int _affinityCPU;
+	int _affinityNUMANode;
+
+	//! Whether the task can only run in its CPU or NUMA node
+	bool _strictAffinity;
+
+	//! NUMA node holding most of the data of the task, set by the schedulers
+	//! that place the tasks by their data, or -1 if unknown. It is short to
+	//! fit in the padding after the affinity
+	int16_t _dataNUMANode;
+
+	//! Task graph of the region where this task is creating tasks, if any
+	TaskGraph *_activeTaskGraph;
+
+	//! Task graph that recorded or replays this task, and its node in it
+	TaskGraph *_taskGraph;
+	size_t _taskGraphNode;
+
 protected:
 	//! The thread assigned to this task, nullptr if the task has finished (but possibly waiting its children)
 	std::atomic<WorkerThread *> _thread;
@@ -172,6 +212,13 @@ private:
 	//! Nesting level of the task
 	int _nestingLevel;
 
+	//! \brief Get the look-ahead rank, which is allocated right before the task
+	inline LookAheadRank *getLookAheadRankStorage() const
+	{
+		assert(hasLookAheadRank());
+		return (LookAheadRank *) ((char *) this - sizeof(LookAheadRank));
+	}
+
 public:
 	inline Task(
 		void *argsBlock,
@@ -366,6 +413,77 @@ public:
 		return false;
 	}
 
+	//! \brief Indicates whether the task has a look-ahead rank
+	inline bool hasLookAheadRank() const
+	{
+		return _flags[look_ahead_flag];
+	}
+
+	//! \brief Set the predicted cost of the task, which is also its initial
+	//! look-ahead rank since it has no successors yet
+	inline void setPredictedCost(priority_t cost)
+	{
+		LookAheadRank *lookAhead = getLookAheadRankStorage();
+		lookAhead->_predictedCost = cost;
+		lookAhead->_rank.store(cost, std::memory_order_relaxed);
+	}
+
+	//! \brief Get the predicted cost of the task
+	//!
+	//! \returns the cost, or zero if the task has no look-ahead rank
+	inline priority_t getPredictedCost() const
+	{
+		if (!hasLookAheadRank()) {
+			return 0;
+		}
+		return getLookAheadRankStorage()->_predictedCost;
+	}
+
+	//! \brief Get the look-ahead rank of the task
+	//!
+	//! \returns the rank, or zero if the task has no look-ahead rank
+	inline priority_t getLookAheadRank() const
+	{
+		if (!hasLookAheadRank()) {
+			return 0;
+		}
+		return getLookAheadRankStorage()->_rank.load(std::memory_order_relaxed);
+	}
+
+	//! \brief Raise the look-ahead rank of the task with a new successor
+	//!
+	//! The rank only looks one level ahead. The dependency systems keep no
+	//! links to the predecessors, so the successors of the successor cannot
+	//! raise the rank of this task
+	//!
+	//! \param[in] successorCost The predicted cost of the direct successor
+	inline void addSuccessorCost(priority_t successorCost)
+	{
+		if (!hasLookAheadRank()) {
+			return;
+		}
+
+		LookAheadRank *lookAhead = getLookAheadRankStorage();
+		const priority_t rank = lookAhead->_predictedCost + successorCost;
+		priority_t current = lookAhead->_rank.load(std::memory_order_relaxed);
+		while (current < rank) {
+			if (lookAhead->_rank.compare_exchange_weak(current, rank, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+	}
+
+	//! \brief Use the look-ahead rank as the priority of the task, unless
+	//! the user defined its priority
+	inline void applyLookAheadPriority()
+	{
+		assert(_taskInfo != nullptr);
+
+		if (hasLookAheadRank() && _taskInfo->get_priority == nullptr) {
+			_priority = getLookAheadRank();
+		}
+	}
+
 	//! \brief Indicates whether the task has deadline
 	//!
 	//! \returns whether the task has deadline
@@ -390,6 +508,93 @@ public:
 		_deadline = deadline;
 	}
 
+	//! \brief Indicates whether the task has an affinity hint
+	inline bool hasAffinity() const
+	{
+		return (_affinityNUMANode >= 0);
+	}
+
+	//! \brief Get the index of the CPU where the task should run
+	//!
+	//! \returns the CPU index, or -1 if the affinity is a whole NUMA node
+	inline int getAffinityCPU() const
+	{
+		return _affinityCPU;
+	}
+
+	//! \brief Get the NUMA node where the task should run
+	//!
+	//! \returns the NUMA node, or -1 if the task has no affinity
+	inline int getAffinityNUMANode() const
+	{
+		return _affinityNUMANode;
+	}
+
+	//! \brief Indicates whether the task can only run in its affinity target
+	inline bool hasStrictAffinity() const
+	{
+		return _strictAffinity;
+	}
+
+	//! \brief Set the affinity hint of the task
+	//!
+	//! \param[in] cpuId the CPU index, or -1 to target the whole NUMA node
+	//! \param[in] numaNodeId the NUMA node, which is the one of the CPU if
+	//! any, or -1 to remove the affinity
+	//! \param[in] strict whether the task can only run in its target
+	inline void setAffinity(int cpuId, int numaNodeId, bool strict)
+	{
+		assert(cpuId < 0 || numaNodeId >= 0);
+
+		_affinityCPU = cpuId;
+		_affinityNUMANode = numaNodeId;
+		_strictAffinity = strict;
+	}
+
+	//! \brief Get the NUMA node holding most of the data of the task
+	//!
+	//! \returns the NUMA node, or -1 if unknown
+	inline int getDataNUMANode() const
+	{
+		return _dataNUMANode;
+	}
+
+	//! \brief Set the NUMA node holding most of the data of the task
+	inline void setDataNUMANode(int numaNodeId)
+	{
+		assert(numaNodeId >= -1 && numaNodeId <= INT16_MAX);
+		_dataNUMANode = (int16_t) numaNodeId;
+	}
+
+	//! \brief Get the task graph of the region where this task is creating tasks
+	inline TaskGraph *getActiveTaskGraph() const
+	{
+		return _activeTaskGraph;
+	}
+
+	inline void setActiveTaskGraph(TaskGraph *taskGraph)
+	{
+		_activeTaskGraph = taskGraph;
+	}
+
+	//! \brief Get the task graph that recorded or replays this task
+	inline TaskGraph *getTaskGraph() const
+	{
+		return _taskGraph;
+	}
+
+	//! \brief Get the node of this task in its task graph
+	inline size_t getTaskGraphNode() const
+	{
+		return _taskGraphNode;
+	}
+
+	inline void setTaskGraph(TaskGraph *taskGraph, size_t node)
+	{
+		_taskGraph = taskGraph;
+		_taskGraphNode = node;
+	}
+
 	//! \brief Get the task scheduling hint
 	//!
 	//! \returns the scheduling hint
@@ -0,0 +1,297 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <iterator>
+
+#include "TaskGraph.hpp"
+#include "executors/threads/WorkerThread.hpp"
+#include "lowlevel/FatalErrorHandler.hpp"
+#include "scheduling/Scheduler.hpp"
+#include "system/ompss/TaskWait.hpp"
+#include "tasks/Task.hpp"
+
+#include <ClusterManager.hpp>
+
+
+TaskGraph::TaskGraph() :
+	_state(EMPTY_STATE),
+	_replayable(false),
+	_creator(nullptr),
+	_nodes(),
+	_fragments(),
+	_nextNode(0),
+	_pendingPredecessors(),
+	_replayedTasks(),
+	_checkedAccesses(0),
+	_accessesMatch(false)
+{
+}
+
+TaskGraph::fragment_map_t::iterator TaskGraph::splitFragment(uintptr_t address)
+{
+	fragment_map_t::iterator next = _fragments.upper_bound(address);
+	if (next == _fragments.begin())
+		return next;
+
+	fragment_map_t::iterator previous = std::prev(next);
+	if (previous->first == address)
+		return previous;
+
+	if (address < previous->second._end) {
+		// Both halves keep the writer and the readers
+		Fragment second(previous->second);
+		previous->second._end = address;
+		return _fragments.emplace_hint(next, address, second);
+	}
+
+	return next;
+}
+
+void TaskGraph::recordAccess(size_t nodeIndex, Access const &access)
+{
+	const uintptr_t start = (uintptr_t) access._start;
+	const uintptr_t end = start + access._length;
+	const bool write = (access._type != READ_ACCESS_TYPE);
+
+	fragment_map_t::iterator it = splitFragment(start);
+	splitFragment(end);
+
+	uintptr_t position = start;
+	while (position < end) {
+		if (it == _fragments.end() || it->first > position) {
+			// Data that no previous task accessed
+			uintptr_t gapEnd = (it == _fragments.end()) ? end : std::min(it->first, end);
+			it = _fragments.emplace_hint(it, position, Fragment(gapEnd));
+		}
+		assert(it->first == position);
+		assert(it->second._end <= end);
+
+		Fragment &fragment = it->second;
+		addEdge(fragment._lastWriter, nodeIndex);
+
+		if (write) {
+			for (size_t reader : fragment._readers) {
+				addEdge(reader, nodeIndex);
+			}
+			fragment._lastWriter = nodeIndex;
+			fragment._readers.clear();
+		} else if (fragment._readers.empty() || fragment._readers.back() != nodeIndex) {
+			fragment._readers.push_back(nodeIndex);
+		}
+
+		position = fragment._end;
+		++it;
+	}
+}
+
+void TaskGraph::fallback()
+{
+	assert(_state == REPLAYING_STATE);
+
+	// The tasks registered from now on do not know about the replayed ones
+	_state = FALLBACK_STATE;
+	TaskWait::taskWait("task graph fallback", true, false);
+}
+
+bool TaskGraph::begin(Task *creator)
+{
+	assert(creator != nullptr);
+	FatalErrorHandler::failIf(_creator != nullptr, "The task graph is already in use");
+	FatalErrorHandler::failIf(creator->getActiveTaskGraph() != nullptr, "Task graph regions cannot be nested");
+
+	TaskWait::taskWait("nanos6_taskgraph_begin", true, false);
+
+	_creator = creator;
+
+	if (_state == EMPTY_STATE) {
+		// The dependencies are not replayed in other nodes
+		_nodes.clear();
+		_replayable = !ClusterManager::inClusterMode();
+		_state = RECORDING_STATE;
+		creator->setActiveTaskGraph(this);
+		return false;
+	}
+
+	assert(_state == RECORDED_STATE);
+	if (!_replayable) {
+		return false;
+	}
+
+	for (size_t n = 0; n < _nodes.size(); ++n) {
+		_pendingPredecessors[n].store(_nodes[n]._numPredecessors + 1, std::memory_order_relaxed);
+		_replayedTasks[n] = nullptr;
+	}
+	_nextNode = 0;
+	_state = REPLAYING_STATE;
+	creator->setActiveTaskGraph(this);
+
+	return true;
+}
+
+void TaskGraph::end(Task *creator)
+{
+	assert(creator != nullptr);
+	FatalErrorHandler::failIf(_creator != creator, "The task graph region was not begun by this task");
+
+	TaskWait::taskWait("nanos6_taskgraph_end", true, false);
+
+	creator->setActiveTaskGraph(nullptr);
+	_creator = nullptr;
+
+	if (_state == RECORDING_STATE) {
+		_fragments.clear();
+
+		Container::vector<std::atomic<size_t>> pendingPredecessors(_nodes.size());
+		_pendingPredecessors.swap(pendingPredecessors);
+		_replayedTasks.assign(_nodes.size(), nullptr);
+
+		_state = RECORDED_STATE;
+	} else if (_state == REPLAYING_STATE && _nextNode == _nodes.size()) {
+		_state = RECORDED_STATE;
+	} else if (_state != RECORDED_STATE) {
+		// Fewer tasks than recorded, or a task that did not match
+		_state = EMPTY_STATE;
+	}
+}
+
+bool TaskGraph::submitTask(Task *task)
+{
+	assert(task != nullptr);
+
+	if (_state == RECORDING_STATE) {
+		if (task->isIf0() || task->isTaskloop()) {
+			_replayable = false;
+		}
+
+		Node node;
+		node._taskInfo = task->getTaskInfo();
+		node._flags = task->getFlags();
+		node._argsBlockSize = task->getArgsBlockSize();
+		node._numPredecessors = 0;
+		_nodes.push_back(node);
+
+		// The task registers its accesses as usual, and they are recorded
+		task->setTaskGraph(this, _nodes.size() - 1);
+		return false;
+	}
+
+	if (_state != REPLAYING_STATE) {
+		return false;
+	}
+
+	if (_nextNode < _nodes.size()) {
+		const Node &node = _nodes[_nextNode];
+		if (node._taskInfo == task->getTaskInfo()
+			&& node._flags == task->getFlags()
+			&& node._argsBlockSize == task->getArgsBlockSize()
+		) {
+			// Check the accesses without registering them
+			task->setTaskGraph(this, _nextNode);
+			_checkedAccesses = 0;
+			_accessesMatch = true;
+
+			if (task->getTaskInfo()->register_depinfo != nullptr) {
+				task->registerDependencies();
+			}
+
+			if (_accessesMatch && _checkedAccesses == node._accesses.size()) {
+				_nextNode++;
+				return true;
+			}
+
+			task->setTaskGraph(nullptr, 0);
+		}
+	}
+
+	fallback();
+	return false;
+}
+
+bool TaskGraph::registerReplayedTask(Task *task)
+{
+	assert(task != nullptr);
+	assert(task->getTaskGraph() == this);
+
+	const size_t nodeIndex = task->getTaskGraphNode();
+	assert(nodeIndex < _nodes.size());
+
+	// The task must be visible before it can be made ready by a predecessor
+	_replayedTasks[nodeIndex] = task;
+	return (_pendingPredecessors[nodeIndex].fetch_sub(1, std::memory_order_acq_rel) == 1);
+}
+
+bool TaskGraph::registerAccess(Task *task, DataAccessType type, bool weak, void *start, size_t length)
+{
+	assert(task != nullptr);
+	assert(task->getTaskGraph() == this);
+
+	const bool replaying = (_state == REPLAYING_STATE);
+	if (start == nullptr || length == 0) {
+		return replaying;
+	}
+
+	Node &node = _nodes[task->getTaskGraphNode()];
+	Access access = { start, length, type };
+
+	if (!replaying) {
+		assert(_state == RECORDING_STATE);
+
+		// The weak accesses pass their dependencies to the children, and
+		// the commutative and reduction accesses are not ordered
+		if (weak || type == COMMUTATIVE_ACCESS_TYPE || type == REDUCTION_ACCESS_TYPE) {
+			_replayable = false;
+		}
+
+		node._accesses.push_back(access);
+		recordAccess(task->getTaskGraphNode(), access);
+		return false;
+	}
+
+	if (weak || _checkedAccesses >= node._accesses.size()) {
+		_accessesMatch = false;
+	} else {
+		const Access &recorded = node._accesses[_checkedAccesses];
+		if (recorded._start != start || recorded._length != length || recorded._type != type) {
+			_accessesMatch = false;
+		}
+	}
+	_checkedAccesses++;
+
+	return true;
+}
+
+void TaskGraph::nestedTaskSubmitted(Task *parent)
+{
+	assert(parent != nullptr);
+	assert(parent->getTaskGraph() == this);
+
+	// A replayed task holds no accesses in the dependency system, so its
+	// children would not delay its successors. Release the successors once
+	// the children finish, as if the task had a wait clause. The recorded
+	// tasks register their accesses, so their children need nothing else
+	if (hasReplayedTasks() && !parent->mustDelayRelease()) {
+		parent->setDelayedRelease(true);
+	}
+}
+
+void TaskGraph::unregisterReplayedTask(Task *task, ComputePlace *computePlace, bool fromBusyThread)
+{
+	assert(task != nullptr);
+	assert(task->getTaskGraph() == this);
+	assert(hasReplayedTasks());
+
+	const Node &node = _nodes[task->getTaskGraphNode()];
+	const ReadyTaskHint hint = (fromBusyThread) ? BUSY_COMPUTE_PLACE_TASK_HINT : SIBLING_TASK_HINT;
+
+	for (size_t successor : node._successors) {
+		if (_pendingPredecessors[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			Task *readyTask = _replayedTasks[successor];
+			assert(readyTask != nullptr);
+
+			Scheduler::addReadyTask(readyTask, computePlace, hint);
+		}
+	}
+}
@@ -0,0 +1,187 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef TASK_GRAPH_HPP
+#define TASK_GRAPH_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <nanos6.h>
+
+#include "dependencies/DataAccessType.hpp"
+#include "support/Containers.hpp"
+
+
+class ComputePlace;
+class Task;
+
+//! \brief Recorded region of task creation that can be replayed
+//!
+//! The first execution of a region records the child tasks that the creator
+//! submits, in order, with their accesses. The dependencies between them are
+//! computed while recording, from the sequential order of the accesses, and
+//! are kept as the number of predecessors and the list of successors of each
+//! task. The tasks still register their accesses in the dependency system.
+//!
+//! The next executions replay the graph. Each submitted task is checked
+//! against the recorded one in the same position, and then it only waits for
+//! its recorded predecessors. Its accesses are never registered, so there is
+//! no linking or propagation through the dependency system. Since the region
+//! is delimited by two taskwaits, the replayed tasks cannot depend on other
+//! tasks. When a task does not match, the region waits for the replayed tasks
+//! and registers the rest as usual, and the graph is recorded again the next
+//! time. A replayed task that creates children releases its successors when
+//! the children finish, since its accesses do not contain theirs
+class TaskGraph {
+	static const size_t NO_NODE = ~((size_t) 0);
+
+	struct Access {
+		void *_start;
+		size_t _length;
+		DataAccessType _type;
+	};
+
+	struct Node {
+		nanos6_task_info_t *_taskInfo;
+		size_t _flags;
+		size_t _argsBlockSize;
+		Container::vector<Access> _accesses;
+		size_t _numPredecessors;
+		Container::vector<size_t> _successors;
+	};
+
+	//! \brief Piece of data accessed while recording, with the last task that
+	//! wrote it and the tasks that read it afterwards
+	struct Fragment {
+		uintptr_t _end;
+		size_t _lastWriter;
+		Container::vector<size_t> _readers;
+
+		inline Fragment(uintptr_t end) :
+			_end(end),
+			_lastWriter(NO_NODE),
+			_readers()
+		{
+		}
+	};
+
+	typedef Container::map<uintptr_t, Fragment> fragment_map_t;
+
+	enum state_t {
+		//! Nothing recorded, the next region is recorded
+		EMPTY_STATE = 0,
+		RECORDING_STATE,
+		RECORDED_STATE,
+		REPLAYING_STATE,
+		//! A task did not match while replaying
+		FALLBACK_STATE
+	};
+
+	state_t _state;
+
+	//! Whether the recorded graph can be replayed
+	bool _replayable;
+
+	//! The task running the region, if any
+	Task *_creator;
+
+	Container::vector<Node> _nodes;
+
+	//! Accessed data, only while recording
+	fragment_map_t _fragments;
+
+	//! Next node to be submitted
+	size_t _nextNode;
+
+	//! Replay: the predecessors of each node that have not finished, plus
+	//! one until the node is submitted
+	Container::vector<std::atomic<size_t>> _pendingPredecessors;
+
+	//! Replay: the task of each submitted node
+	Container::vector<Task *> _replayedTasks;
+
+	//! Replay: the accesses of the submitted task checked so far
+	size_t _checkedAccesses;
+	bool _accessesMatch;
+
+	//! \brief Record an access and the dependencies that it creates
+	void recordAccess(size_t nodeIndex, Access const &access);
+
+	//! \brief Get the fragment starting at an address, splitting the one
+	//! that contains it if needed
+	fragment_map_t::iterator splitFragment(uintptr_t address);
+
+	inline void addEdge(size_t predecessor, size_t successor)
+	{
+		if (predecessor == NO_NODE || predecessor == successor)
+			return;
+
+		// The edges to a node are added while recording its accesses,
+		// so a repeated edge is the last one of its predecessor
+		Container::vector<size_t> &successors = _nodes[predecessor]._successors;
+		if (successors.empty() || successors.back() != successor) {
+			successors.push_back(successor);
+			_nodes[successor]._numPredecessors++;
+		}
+	}
+
+	//! \brief Stop replaying after a task that did not match
+	void fallback();
+
+public:
+	TaskGraph();
+
+	//! \brief Begin the region of the graph
+	//!
+	//! \param[in] creator the task that creates the tasks of the region
+	//!
+	//! \returns whether the tasks are replayed
+	bool begin(Task *creator);
+
+	//! \brief End the region of the graph
+	void end(Task *creator);
+
+	//! \brief Check whether the tasks of the graph are replayed tasks
+	//!
+	//! The tasks replayed before a fallback are still running when the
+	//! graph is in the fallback state
+	inline bool hasReplayedTasks() const
+	{
+		return (_state == REPLAYING_STATE || _state == FALLBACK_STATE);
+	}
+
+	//! \brief Record or check a task before it is submitted
+	//!
+	//! \param[in] task the task, whose parent is the creator of the region
+	//!
+	//! \returns whether the task is replayed, so it must not register its
+	//! accesses in the dependency system
+	bool submitTask(Task *task);
+
+	//! \brief Make a replayed task wait for its predecessors
+	//!
+	//! \returns whether the task is ready
+	bool registerReplayedTask(Task *task);
+
+	//! \brief Record or check an access of a task of the graph
+	//!
+	//! \returns whether the access must not be registered in the
+	//! dependency system, since the task is replayed
+	bool registerAccess(Task *task, DataAccessType type, bool weak, void *start, size_t length);
+
+	//! \brief A task of the graph created a child task
+	//!
+	//! \param[in] parent the task of the graph, which is running
+	void nestedTaskSubmitted(Task *parent);
+
+	//! \brief Release the successors of a replayed task that finished
+	void unregisterReplayedTask(Task *task, ComputePlace *computePlace, bool fromBusyThread);
+};
+
+#endif // TASK_GRAPH_HPP
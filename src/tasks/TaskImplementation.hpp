@@ -44,6 +44,13 @@ inline Task::Task(
 	_priority(0),
 	_deadline(0),
 	_schedulingHint(NO_HINT),
+	_affinityCPU(-1),
+	_affinityNUMANode(-1),
+	_strictAffinity(false),
+	_dataNUMANode(-1),
+	_activeTaskGraph(nullptr),
+	_taskGraph(nullptr),
+	_taskGraphNode(0),
 	_thread(nullptr),
 	_dataAccesses(taskAccessInfo),
 	_flags(flags),
@@ -97,8 +104,18 @@ inline void Task::reinitialize(
 	_priority = 0;
 	_deadline = 0;
 	_schedulingHint = NO_HINT;
+	_affinityCPU = -1;
+	_affinityNUMANode = -1;
+	_strictAffinity = false;
+	_dataNUMANode = -1;
+	_activeTaskGraph = nullptr;
+	_taskGraph = nullptr;
+	_taskGraphNode = 0;
 	_thread = nullptr;
 	_flags = flags;
+	// Only the tasks created by nanos6_create_task have the storage of
+	// the look-ahead rank, and the reinitialized ones reuse other storage
+	_flags[look_ahead_flag] = false;
 	_predecessorCount = 0;
 	_instrumentationTaskId = instrumentationTaskId;
 	_computePlace = nullptr;
@@ -6,11 +6,38 @@
 
 #include "Taskfor.hpp"
 #include "executors/threads/WorkerThread.hpp"
+#include "lowlevel/FatalErrorHandler.hpp"
+
+
+ConfigVariable<std::string> Taskfor::_chunkScheduleName("taskfor.schedule");
+ConfigVariable<size_t> Taskfor::_adaptiveChunkTime("taskfor.adaptive_chunk_time");
+
+
+Taskfor::chunk_schedule_t Taskfor::getChunkSchedule()
+{
+	static const chunk_schedule_t chunkSchedule = []() {
+		std::string name = _chunkScheduleName.getValue();
+		if (name == "static") {
+			return STATIC_CHUNKS;
+		} else if (name == "guided") {
+			return GUIDED_CHUNKS;
+		} else if (name == "adaptive") {
+			FatalErrorHandler::failIf(_adaptiveChunkTime.getValue() == 0,
+				"taskfor.adaptive_chunk_time must be greater than zero");
+			return ADAPTIVE_CHUNKS;
+		}
+
+		FatalErrorHandler::fail("Invalid taskfor schedule ", name);
+		return STATIC_CHUNKS;
+	}();
+
+	return chunkSchedule;
+}
 
 void Taskfor::run(Taskfor &source, nanos6_address_translation_entry_t *translationTable)
 {
 	assert(getParent()->isTaskfor() && getParent() == &source);
-	assert(getMyChunk() >= 0);
+	assert(hasChunk());
 
 	// Temporary hack in order to solve the problem of updating
 	// the location of the DataAccess objects of the Taskfor,
@@ -18,35 +45,37 @@ void Taskfor::run(Taskfor &source, nanos6_address_translation_entry_t *translati
 	// by supporting the Taskfor construct through the execution
 	// workflow
 	ComputePlace *computePlace = getThread()->getComputePlace();
-	int cpuId = computePlace->getIndex();
 	MemoryPlace *memoryPlace = computePlace->getMemoryPlace(0);
 	source.setMemoryPlace(memoryPlace);
 
-	// Compute source taskfor total chunks
-	bounds_t const &sourceBounds = source.getBounds();
-	const size_t totalIterations = sourceBounds.upper_bound - sourceBounds.lower_bound;
-	const size_t totalChunks = MathSupport::ceil(totalIterations, sourceBounds.chunksize);
-
 	// Get the arguments and the task information
 	const nanos6_task_info_t &taskInfo = *getTaskInfo();
 	void *argsBlock = getArgsBlock();
-	size_t myIterations = computeChunkBounds(totalChunks, sourceBounds);
+	size_t myIterations = computeChunkBounds();
 	assert(myIterations > 0);
 	size_t completedIterations = 0;
 
+	// Only the adaptive chunks need the time of each chunk
+	const bool timeChunks = source.hasAdaptiveChunks();
+
 	do {
+		uint64_t startTime = 0;
+		if (timeChunks) {
+			startTime = Chrono::now<uint64_t, std::nano>();
+		}
+
 		taskInfo.implementations[0].run(argsBlock, &_bounds, translationTable);
 		// Prevent translating twice the addresses because the argsBlock is overwritten
 		translationTable = nullptr;
 
+		if (timeChunks) {
+			source.registerChunkTime(myIterations, Chrono::now<uint64_t, std::nano>() - startTime);
+		}
+
 		completedIterations += myIterations;
 
-		_myChunk = source.getNextChunk(cpuId);
-		if (_myChunk >= 0) {
-			myIterations = computeChunkBounds(totalChunks, sourceBounds);
-		} else {
-			myIterations = 0;
-		}
+		source.getNextChunk(_myChunk);
+		myIterations = computeChunkBounds();
 	} while (myIterations != 0);
 
 	assert(completedIterations > 0);
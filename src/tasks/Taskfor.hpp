@@ -8,8 +8,11 @@
 #define TASKFOR_HPP
 
 #include <cmath>
+#include <string>
 
 #include "support/MathSupport.hpp"
+#include "support/chronometers/std/Chrono.hpp"
+#include "support/config/ConfigVariable.hpp"
 #include "tasks/Task.hpp"
 #include "tasks/TaskImplementation.hpp"
 
@@ -18,24 +21,46 @@ class Taskfor : public Task {
 public:
 	typedef nanos6_loop_bounds_t bounds_t;
 
+	//! How the iterations of a taskfor are split in chunks
+	enum chunk_schedule_t {
+		//! Chunks of the same size, computed from the number of collaborators
+		STATIC_CHUNKS = 0,
+		//! Chunks proportional to the remaining iterations
+		GUIDED_CHUNKS,
+		//! Chunks sized by the observed time per iteration
+		ADAPTIVE_CHUNKS
+	};
+
 private:
-	static const int PENDING_CHUNKS_SIZE=7;
-	static const int NUM_UINT64_BITS=64;
-	// Global counter of remaining chunks
-	std::atomic<int64_t> _remainingChunks;
-	// Array of size_t to complete a cache line, where each bit of each size_t represents a chunk
-	// _remainingChunks+_pendingChunks must occupy a single cache line in the most conservative
-	// cache line size we found that is 64. So, we have _remainingChunks + 7 size_t in _pendingChunks.
-	// That enables us to represent up to 448 chunks.
-	std::atomic<uint64_t> _pendingChunks[PENDING_CHUNKS_SIZE];
+	//! Number of chunks per collaborator handed out by the adaptive
+	//! schedule before any chunk has been timed
+	static const size_t ADAPTIVE_PROBE_CHUNKS = 8;
+
+	//! Fractional bits of the fixed-point cost per iteration
+	static const size_t COST_SHIFT = 10;
+
+	static ConfigVariable<std::string> _chunkScheduleName;
+	static ConfigVariable<size_t> _adaptiveChunkTime;
+
+	// Source. Next iteration to be handed out, which is the only chunk
+	// bookkeeping, so there is no limit in the number of chunks
+	Padded<std::atomic<size_t>> _nextIteration;
+	// Source. Average nanoseconds per iteration, in fixed point, observed
+	// by the adaptive schedule. Zero until the first chunk is timed
+	std::atomic<uint64_t> _iterationCost;
+	// Source
+	chunk_schedule_t _chunkSchedule;
+	// Source
+	size_t _numCollaborators;
 	// Source
 	Padded<std::atomic<size_t>> _remainingIterations;
-	// Source and collaborator
+	// Source and collaborator. The chunksize of the source is the size of
+	// the static chunks, or the minimum size of the other chunks
 	bounds_t _bounds;
 	// Collaborator
 	size_t _completedIterations;
-	// Collaborator
-	int _myChunk;
+	// Collaborator. Iterations that it has to execute, set by the scheduler
+	bounds_t _myChunk;
 
 public:
 	// Methods for both source and collaborator taskfors
@@ -58,18 +83,17 @@ public:
 			flags, taskAccessInfo,
 			taskCountersAddress,
 			taskStatistics),
-		_remainingChunks(0),
+		_nextIteration(0),
+		_iterationCost(0),
+		_chunkSchedule(STATIC_CHUNKS),
+		_numCollaborators(1),
 		_remainingIterations(0),
 		_bounds(),
 		_completedIterations(0),
-		_myChunk(-1)
+		_myChunk()
 	{
 		assert(isFinal());
 		setRunnable(runnable);
-
-		for (int i = 0; i < PENDING_CHUNKS_SIZE; i++) {
-			std::atomic_init(&_pendingChunks[i], (uint64_t) 0);
-		}
 	}
 
 	inline void setRunnable(bool runnableValue)
@@ -97,7 +121,14 @@ public:
 		size_t totalIterations = getIterationCount();
 		_remainingIterations.store(totalIterations, std::memory_order_relaxed);
 
-		if (_bounds.chunksize == 0) {
+		_chunkSchedule = getChunkSchedule();
+		_numCollaborators = maxCollaborators;
+
+		if (_chunkSchedule != STATIC_CHUNKS) {
+			// The chunksize is the minimum size of the chunks, and
+			// all of them are multiples of it except the last one
+			_bounds.chunksize = std::max(_bounds.chunksize, (size_t) 1);
+		} else if (_bounds.chunksize == 0) {
 			// Just distribute iterations over collaborators if no hint.
 			_bounds.chunksize = std::max(MathSupport::ceil(totalIterations, maxCollaborators), (size_t) 1);
 		} else {
@@ -111,16 +142,8 @@ public:
 			_bounds.chunksize = alignedChunksize;
 		}
 
-		size_t totalChunks = MathSupport::ceil(totalIterations, _bounds.chunksize);
-		// Each bit of the _pendingChunks var represents a chunk. 1 is pending, 0 is already executed.
-		FatalErrorHandler::failIf(totalChunks > PENDING_CHUNKS_SIZE * NUM_UINT64_BITS, "Too many chunks required.");
-		_remainingChunks.store(totalChunks, std::memory_order_relaxed);
-		while (totalChunks > 0 ) {
-			int index = (totalChunks-1)/NUM_UINT64_BITS;
-			int localChunks = totalChunks - (index * NUM_UINT64_BITS);
-			_pendingChunks[index].store((uint64_t)((uint64_t) 2 << (localChunks-1)) - (uint64_t) 1, std::memory_order_relaxed);
-			totalChunks -= localChunks;
-		}
+		_nextIteration.store(lowerBound, std::memory_order_relaxed);
+		_iterationCost.store(0, std::memory_order_relaxed);
 	}
 
 	inline bounds_t const &getBounds() const
@@ -160,63 +183,77 @@ public:
 		return (remaining == 0);
 	}
 
-	inline int getNextChunk(long cpuId, bool *remove = nullptr)
+	//! \brief Get the next chunk of iterations
+	//!
+	//! \param[out] chunk the bounds of the chunk, which are empty if there
+	//! are no iterations left
+	//! \param[out] remove whether the taskfor has no iterations left after
+	//! this call, so it must be removed from the scheduler
+	//!
+	//! \returns whether a chunk was obtained
+	inline bool getNextChunk(bounds_t &chunk, bool *remove = nullptr)
 	{
 		assert(!isRunnable());
 
-		size_t totalIterations = _bounds.upper_bound - _bounds.lower_bound;
-		size_t totalChunks = MathSupport::ceil(totalIterations, _bounds.chunksize);
-		int chunkId = -1;
-		size_t fetched = 0;
+		const size_t upperBound = _bounds.upper_bound;
+		size_t lowerBound;
+		size_t chunkUpperBound = upperBound;
 
-		int64_t remaining = _remainingChunks.fetch_sub(1, std::memory_order_relaxed) - 1;
+		if (_chunkSchedule == STATIC_CHUNKS) {
+			lowerBound = _nextIteration.fetch_add(_bounds.chunksize, std::memory_order_relaxed);
+			if (lowerBound < upperBound) {
+				chunkUpperBound = std::min(lowerBound + _bounds.chunksize, upperBound);
+			}
+		} else {
+			lowerBound = _nextIteration.load(std::memory_order_relaxed);
+			do {
+				if (lowerBound >= upperBound)
+					break;
 
-		if (remaining < 0) {
+				chunkUpperBound = lowerBound + computeChunkSize(upperBound - lowerBound);
+				chunkUpperBound = std::min(chunkUpperBound, upperBound);
+			} while (!_nextIteration.compare_exchange_weak(
+				lowerBound, chunkUpperBound, std::memory_order_relaxed));
+		}
+
+		if (lowerBound >= upperBound) {
+			chunk.lower_bound = chunk.upper_bound = upperBound;
 			if (remove != nullptr)
 				*remove = true;
 
-			return chunkId;
-		} else if (remove != nullptr) {
-			*remove = (remaining == 0);
+			return false;
 		}
 
-		// Get the variable where we should start from based on cpuId.
-		for (int c = 0; c < PENDING_CHUNKS_SIZE; c++) {
-			do {
-				int index = ((cpuId/NUM_UINT64_BITS) + c) % PENDING_CHUNKS_SIZE;
-				std::atomic<uint64_t> &pendingChunks = _pendingChunks[index];
-
-				// We use a right rotation to get the first enabled bit starting from cpuId.
-				uint64_t aux = rotateRight(pendingChunks, (cpuId % totalChunks));
-				// Find first set, -1 means no enabled bits at all.
-				int ffs = indexFirstEnabledBit(aux);
-				if (ffs == -1) {
-					break;
-				}
+		chunk.lower_bound = lowerBound;
+		chunk.upper_bound = chunkUpperBound;
+		if (remove != nullptr)
+			*remove = (chunkUpperBound == upperBound);
 
-				// Adjust the id based on the rotation done
-				chunkId = (ffs + (cpuId % totalChunks)) % NUM_UINT64_BITS;
-				assert(chunkId < (int) NUM_UINT64_BITS);
+		return true;
+	}
 
-				// Try to disable chunkId bit
-				fetched = pendingChunks.fetch_and(~((uint64_t) 1 << chunkId), std::memory_order_relaxed);
+	inline bool hasAdaptiveChunks() const
+	{
+		assert(!isRunnable());
+		return (_chunkSchedule == ADAPTIVE_CHUNKS);
+	}
 
-				// If fetched is 0, there are no more bits enabled.
-				if (fetched == 0) {
-					break;
-				}
-
-				// If disable was successful, it means that chunk was not run and we must run it
-				if (fetched & ((uint64_t) 1 << chunkId)) {
-					chunkId += (NUM_UINT64_BITS * index);
-					assert(chunkId < (int) totalChunks);
-					return chunkId;
-				}
-			} while (1);
-		}
+	//! \brief Register the time that a collaborator took to run a chunk
+	//!
+	//! The cost per iteration is a moving average that gives more weight
+	//! to the recent chunks. Concurrent updates may lose a sample, which
+	//! is harmless since it is only a hint for the chunk sizes
+	inline void registerChunkTime(size_t iterations, uint64_t nanoseconds)
+	{
+		assert(!isRunnable());
+		assert(iterations > 0);
 
-		FatalErrorHandler::failIf(1, "There must be a chunk because remainingChunks assigned us a chunk.");
-		return -1;
+		uint64_t cost = std::max((nanoseconds << COST_SHIFT) / iterations, (uint64_t) 1);
+		uint64_t average = _iterationCost.load(std::memory_order_relaxed);
+		if (average != 0) {
+			cost = (3 * average + cost) / 4;
+		}
+		_iterationCost.store(cost, std::memory_order_relaxed);
 	}
 
 	// Methods for collaborator taskfors
@@ -268,34 +305,33 @@ public:
 		return _bounds;
 	}
 
-	inline void setChunk(int chunk)
+	inline bounds_t &getMyChunk()
 	{
 		assert(isRunnable());
-		_myChunk = chunk;
+		return _myChunk;
 	}
 
-	inline int getMyChunk() const
+	inline bool hasChunk() const
 	{
 		assert(isRunnable());
-		return _myChunk;
+		return (_myChunk.lower_bound < _myChunk.upper_bound);
 	}
 
-	inline size_t computeChunkBounds(size_t totalChunks, bounds_t const &sourceBounds)
+	//! \brief Set the bounds to the chunk assigned to this collaborator
+	//!
+	//! \returns the number of iterations of the chunk
+	inline size_t computeChunkBounds()
 	{
 		assert(isRunnable());
-		assert(totalChunks > 0);
 
-		// Invert to start from the beginning.
-		_myChunk = totalChunks - (_myChunk + 1);
-		assert(_myChunk <= (int) totalChunks);
-		assert(_myChunk >= 0);
+		if (!hasChunk()) {
+			return 0;
+		}
 
-		_bounds.lower_bound = sourceBounds.lower_bound + (_myChunk * sourceBounds.chunksize);
-		size_t myIterations = std::min(sourceBounds.chunksize, sourceBounds.upper_bound - _bounds.lower_bound);
-		assert(myIterations > 0 && myIterations <= sourceBounds.chunksize);
-		_bounds.upper_bound = _bounds.lower_bound + myIterations;
+		_bounds.lower_bound = _myChunk.lower_bound;
+		_bounds.upper_bound = _myChunk.upper_bound;
 
-		return myIterations;
+		return (_bounds.upper_bound - _bounds.lower_bound);
 	}
 
 	inline size_t getCompletedIterations() const
@@ -347,23 +383,41 @@ public:
 private:
 	void run(Taskfor &source, nanos6_address_translation_entry_t *translationTable);
 
-	static inline size_t closestMultiple(size_t n, size_t multipleOf)
+	//! \brief Get the chunk schedule chosen by the taskfor.schedule option
+	static chunk_schedule_t getChunkSchedule();
+
+	//! \brief Compute the size of the next guided or adaptive chunk
+	//!
+	//! Guided chunks are the remaining iterations split between twice the
+	//! collaborators, so they shrink as the loop advances. Adaptive chunks
+	//! take the time set by taskfor.adaptive_chunk_time according to the
+	//! observed cost per iteration, and they are never larger than the
+	//! guided ones, so the tail of the loop is still balanced
+	inline size_t computeChunkSize(size_t remainingIterations) const
 	{
-		return ((n + multipleOf - 1) / multipleOf) * multipleOf;
-	}
+		const size_t minChunksize = _bounds.chunksize;
+		assert(minChunksize > 0);
+
+		size_t chunksize = MathSupport::ceil(remainingIterations, 2 * _numCollaborators);
+
+		if (_chunkSchedule == ADAPTIVE_CHUNKS) {
+			const uint64_t cost = _iterationCost.load(std::memory_order_relaxed);
+			if (cost == 0) {
+				// Probe the cost with small chunks
+				size_t probe = MathSupport::ceil(getIterationCount(), ADAPTIVE_PROBE_CHUNKS * _numCollaborators);
+				chunksize = std::min(chunksize, probe);
+			} else {
+				uint64_t target = ((uint64_t) _adaptiveChunkTime * 1000) << COST_SHIFT;
+				chunksize = std::min(chunksize, (size_t) (target / cost));
+			}
+		}
 
-	// Function to right rotate x by y bits
-	static inline uint64_t rotateRight(uint64_t x, int y)
-	{
-		y &= 63;
-		return (x >> y) | (x << (-y & 63));
+		return closestMultiple(std::max(chunksize, minChunksize), minChunksize);
 	}
 
-	// ffs returns the least signficant enabled bit, starting from 1
-	// 0 means x has no enabled bits
-	static inline int indexFirstEnabledBit(uint64_t x)
+	static inline size_t closestMultiple(size_t n, size_t multipleOf)
 	{
-		return __builtin_ffsll(x) - 1;
+		return ((n + multipleOf - 1) / multipleOf) * multipleOf;
 	}
 };
 
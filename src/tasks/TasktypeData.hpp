@@ -7,6 +7,8 @@
 #ifndef TASKTYPE_DATA_HPP
 #define TASKTYPE_DATA_HPP
 
+#include <atomic>
+
 #include "InstrumentTasktypeData.hpp"
 #include "monitoring/TasktypeStatistics.hpp"
 
@@ -15,6 +17,19 @@
 //! instrumentation parameters, etc.)
 class TasktypeData {
 
+public:
+
+	//! \brief The shape of the accesses of the tasks of this type, learned
+	//! from the registration of their accesses
+	enum access_shape_t {
+		//! No task with enough accesses has been registered yet
+		UNKNOWN_ACCESS_SHAPE = 0,
+		//! The tasks access distinct addresses
+		DISTINCT_ACCESS_SHAPE,
+		//! Some task accessed the same address more than once
+		DUPLICATED_ACCESS_SHAPE
+	};
+
 private:
 
 	//! Instrumentation identifier for this Tasktype
@@ -23,11 +38,15 @@ private:
 	//! Monitoring-related statistics per tasktype
 	TasktypeStatistics _tasktypeStatistics;
 
+	//! The shape of the accesses of the tasks of this type
+	std::atomic<access_shape_t> _accessShape;
+
 public:
 
 	inline TasktypeData() :
 		_instrumentId(),
-		_tasktypeStatistics()
+		_tasktypeStatistics(),
+		_accessShape(UNKNOWN_ACCESS_SHAPE)
 	{
 	}
 
@@ -41,6 +60,16 @@ public:
 		return _tasktypeStatistics;
 	}
 
+	inline access_shape_t getAccessShape() const
+	{
+		return _accessShape.load(std::memory_order_relaxed);
+	}
+
+	inline void setAccessShape(access_shape_t accessShape)
+	{
+		_accessShape.store(accessShape, std::memory_order_relaxed);
+	}
+
 };
 
 #endif // TASKTYPE_DATA_HPP
@@ -0,0 +1,177 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#ifndef BENCHMARK_REPORT_HPP
+#define BENCHMARK_REPORT_HPP
+
+
+#include <cmath>
+#include <fstream>
+#include <initializer_list>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+//! \brief Collects the results of a benchmark and prints them as JSON
+//!
+//! The report has the following layout, so that the results of different
+//! runs can be compared by scripts to track performance regressions:
+//!
+//! {
+//!   "benchmark": "<name>",
+//!   "parameters": { "<key>": <value>, ... },
+//!   "results": {
+//!     "<section>": [ { "<field>": <number>, ... }, ... ],
+//!     ...
+//!   }
+//! }
+class BenchmarkReport {
+	typedef std::pair<std::string, std::string> field_t;
+	typedef std::pair<std::string, std::vector<std::string>> section_t;
+
+	std::string _name;
+	std::vector<field_t> _parameters;
+	std::vector<section_t> _sections;
+
+	static inline std::string quote(std::string const &value)
+	{
+		std::ostringstream oss;
+		oss << '"';
+		for (char c : value) {
+			if (c == '"' || c == '\\') {
+				oss << '\\';
+			}
+			oss << c;
+		}
+		oss << '"';
+		return oss.str();
+	}
+
+	static inline std::string serialize(std::string const &value)
+	{
+		return quote(value);
+	}
+
+	static inline std::string serialize(char const *value)
+	{
+		return quote(value);
+	}
+
+	//! JSON has no representation for NaN or infinities, which appear when a
+	//! benchmark divides by a zero elapsed time, so they are written as null
+	static inline std::string serialize(double value)
+	{
+		if (!std::isfinite(value)) {
+			return "null";
+		}
+
+		std::ostringstream oss;
+		oss << value;
+		return oss.str();
+	}
+
+	static inline std::string serialize(float value)
+	{
+		return serialize((double) value);
+	}
+
+	template <typename T>
+	static inline std::string serialize(T const &value)
+	{
+		std::ostringstream oss;
+		oss << value;
+		return oss.str();
+	}
+
+public:
+	BenchmarkReport(std::string const &name)
+		: _name(name)
+	{
+	}
+
+	//! \brief Record a configuration parameter of the run
+	template <typename T>
+	inline void addParameter(std::string const &key, T const &value)
+	{
+		_parameters.emplace_back(key, serialize(value));
+	}
+
+	//! \brief Append a measurement to a section of the results
+	inline void addEntry(
+		std::string const &section,
+		std::initializer_list<std::pair<char const *, double>> fields
+	) {
+		std::ostringstream oss;
+		oss << "{";
+		bool first = true;
+		for (auto const &field : fields) {
+			oss << (first ? " " : ", ") << quote(field.first) << ": " << serialize(field.second);
+			first = false;
+		}
+		oss << " }";
+
+		for (section_t &existing : _sections) {
+			if (existing.first == section) {
+				existing.second.push_back(oss.str());
+				return;
+			}
+		}
+		_sections.emplace_back(section, std::vector<std::string>(1, oss.str()));
+	}
+
+	inline void print(std::ostream &output) const
+	{
+		output << "{" << std::endl;
+		output << "\t\"benchmark\": " << quote(_name) << "," << std::endl;
+
+		output << "\t\"parameters\": {";
+		for (size_t i = 0; i < _parameters.size(); ++i) {
+			output << (i ? "," : "") << std::endl
+				<< "\t\t" << quote(_parameters[i].first) << ": " << _parameters[i].second;
+		}
+		output << std::endl << "\t}," << std::endl;
+
+		output << "\t\"results\": {";
+		for (size_t i = 0; i < _sections.size(); ++i) {
+			output << (i ? "," : "") << std::endl
+				<< "\t\t" << quote(_sections[i].first) << ": [";
+
+			std::vector<std::string> const &entries = _sections[i].second;
+			for (size_t j = 0; j < entries.size(); ++j) {
+				output << (j ? "," : "") << std::endl << "\t\t\t" << entries[j];
+			}
+			output << std::endl << "\t\t]";
+		}
+		output << std::endl << "\t}" << std::endl;
+		output << "}" << std::endl;
+	}
+
+	//! \brief Print the report to a file, or to the standard output if the
+	//! file name is null
+	//!
+	//! \returns false if the file could not be written
+	inline bool write(char const *fileName) const
+	{
+		if (fileName == nullptr) {
+			print(std::cout);
+			return true;
+		}
+
+		std::ofstream file(fileName);
+		if (!file.is_open()) {
+			return false;
+		}
+
+		print(file);
+		return file.good();
+	}
+};
+
+
+#endif // BENCHMARK_REPORT_HPP
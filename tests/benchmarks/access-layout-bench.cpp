@@ -0,0 +1,154 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+//! Data access layout microbenchmark of the dependency system
+//!
+//! Usage: access-layout-bench [output.json]
+//!
+//! The benchmark reports the size of the data accesses of the dependency
+//! implementation, taken from the runtime information, and how many of them
+//! fit in a cache line. Then it measures the cost of registering and
+//! releasing the accesses of tasks with one, two and four dependency symbols,
+//! which are the common cases. Each task accesses one block of each of its
+//! symbols, and the tasks of consecutive rounds form chains over the blocks,
+//! so that there are many live accesses. The dependency implementation is
+//! taken from the runtime configuration, so that run-benchmark.sh can
+//! compare both of them, and running it against two builds of the runtime
+//! shows the effect of a layout change. The results are printed as JSON to
+//! the given file, or to the standard output.
+
+#include <nanos6/debug.h>
+#include <nanos6/runtime-info.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "BenchmarkReport.hpp"
+#include "Timer.hpp"
+
+#define CACHE_LINE_SIZE (64)
+#define BLOCKS (4096)
+#define ROUNDS (50)
+#define REPETITIONS (5)
+
+
+static long _a[BLOCKS];
+static long _b[BLOCKS];
+static long _c[BLOCKS];
+static long _d[BLOCKS];
+
+//! \brief Get an integer entry of the runtime information
+//!
+//! \returns the value, or -1 if there is no such entry
+static long getRuntimeInfoInteger(char const *name)
+{
+	for (void *it = nanos6_runtime_info_begin(); it != nanos6_runtime_info_end(); it = nanos6_runtime_info_advance(it)) {
+		nanos6_runtime_info_entry_t entry;
+		nanos6_runtime_info_get(it, &entry);
+
+		if (strcmp(entry.name, name) == 0 && entry.type == nanos6_integer_runtime_info_entry) {
+			return entry.integer;
+		}
+	}
+	return -1;
+}
+
+static double oneSymbol()
+{
+	Timer timer;
+	for (long r = 0; r < ROUNDS; ++r) {
+		for (long i = 0; i < BLOCKS; ++i) {
+			#pragma oss task inout(_a[i])
+			_a[i]++;
+		}
+	}
+	#pragma oss taskwait
+	timer.stop();
+
+	return (double) timer;
+}
+
+static double twoSymbols()
+{
+	Timer timer;
+	for (long r = 0; r < ROUNDS; ++r) {
+		for (long i = 0; i < BLOCKS; ++i) {
+			#pragma oss task inout(_a[i]) in(_b[i])
+			_a[i] += _b[i];
+		}
+	}
+	#pragma oss taskwait
+	timer.stop();
+
+	return (double) timer;
+}
+
+static double fourSymbols()
+{
+	Timer timer;
+	for (long r = 0; r < ROUNDS; ++r) {
+		for (long i = 0; i < BLOCKS; ++i) {
+			#pragma oss task inout(_a[i]) in(_b[i]) in(_c[i]) in(_d[i])
+			_a[i] += _b[i] + _c[i] + _d[i];
+		}
+	}
+	#pragma oss taskwait
+	timer.stop();
+
+	return (double) timer;
+}
+
+static void report(BenchmarkReport &report, char const *section, long symbols, double elapsed)
+{
+	const long numTasks = ROUNDS * BLOCKS;
+
+	report.addEntry(section, {
+		{"symbols", symbols},
+		{"tasks", numTasks},
+		{"time_us", elapsed},
+		{"ns_per_access", (elapsed * 1000.0) / (numTasks * symbols)}
+	});
+}
+
+int main(int argc, char **argv)
+{
+	const char *outputFile = (argc > 1) ? argv[1] : NULL;
+	const long numCPUs = nanos6_get_num_cpus();
+	const long accessSize = getRuntimeInfoInteger("data_access_size");
+
+	BenchmarkReport benchmarkReport("access-layout");
+	benchmarkReport.addParameter("cpus", numCPUs);
+	benchmarkReport.addParameter("data_access_size", accessSize);
+	if (accessSize > 0) {
+		benchmarkReport.addParameter("accesses_per_cache_line", (double) CACHE_LINE_SIZE / accessSize);
+	}
+
+	const char *configOverride = getenv("NANOS6_CONFIG_OVERRIDE");
+	benchmarkReport.addParameter("config_override", (configOverride != NULL) ? configOverride : "");
+
+	// Warm up the runtime structures
+	oneSymbol();
+
+	for (int r = 0; r < REPETITIONS; ++r) {
+		report(benchmarkReport, "one_symbol", 1, oneSymbol());
+	}
+
+	for (int r = 0; r < REPETITIONS; ++r) {
+		report(benchmarkReport, "two_symbols", 2, twoSymbols());
+	}
+
+	for (int r = 0; r < REPETITIONS; ++r) {
+		report(benchmarkReport, "four_symbols", 4, fourSymbols());
+	}
+
+	if (!benchmarkReport.write(outputFile)) {
+		fprintf(stderr, "Could not write the results to %s\n", outputFile);
+		return 1;
+	}
+
+	return 0;
+}
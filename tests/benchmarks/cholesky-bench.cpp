@@ -0,0 +1,186 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+//! Blocked Cholesky factorization to evaluate the immediate successor policies
+//!
+//! Usage: cholesky-bench [output.json]
+//!
+//! The matrix is stored by tiles and the kernels are plain loops, so that the
+//! benchmark does not depend on any BLAS library. Every task reads and writes
+//! whole tiles, so the successors that a task releases share a different
+//! amount of data with it. The results are printed as JSON to the given file,
+//! or to the standard output. Use run-benchmark.sh to compare the cache
+//! misses with and without scheduler.locality_immediate_successor through the
+//! hardware counters of the runtime
+
+#include <nanos6/debug.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "BenchmarkReport.hpp"
+#include "Timer.hpp"
+
+#define TILES (16)
+#define TILE_SIZE (128)
+#define REPETITIONS (5)
+
+
+typedef double tile_t[TILE_SIZE * TILE_SIZE];
+
+static void potrf(double *A)
+{
+	for (int j = 0; j < TILE_SIZE; ++j) {
+		double diagonal = A[j * TILE_SIZE + j];
+		for (int k = 0; k < j; ++k) {
+			diagonal -= A[j * TILE_SIZE + k] * A[j * TILE_SIZE + k];
+		}
+		diagonal = std::sqrt(diagonal);
+		A[j * TILE_SIZE + j] = diagonal;
+
+		for (int i = j + 1; i < TILE_SIZE; ++i) {
+			double value = A[i * TILE_SIZE + j];
+			for (int k = 0; k < j; ++k) {
+				value -= A[i * TILE_SIZE + k] * A[j * TILE_SIZE + k];
+			}
+			A[i * TILE_SIZE + j] = value / diagonal;
+		}
+	}
+}
+
+static void trsm(const double *L, double *B)
+{
+	// Solve X * L^T = B, overwriting B with X
+	for (int r = 0; r < TILE_SIZE; ++r) {
+		for (int j = 0; j < TILE_SIZE; ++j) {
+			double value = B[r * TILE_SIZE + j];
+			for (int k = 0; k < j; ++k) {
+				value -= B[r * TILE_SIZE + k] * L[j * TILE_SIZE + k];
+			}
+			B[r * TILE_SIZE + j] = value / L[j * TILE_SIZE + j];
+		}
+	}
+}
+
+static void gemm(const double *A, const double *B, double *C)
+{
+	// C -= A * B^T
+	for (int i = 0; i < TILE_SIZE; ++i) {
+		for (int j = 0; j < TILE_SIZE; ++j) {
+			double value = 0.0;
+			for (int k = 0; k < TILE_SIZE; ++k) {
+				value += A[i * TILE_SIZE + k] * B[j * TILE_SIZE + k];
+			}
+			C[i * TILE_SIZE + j] -= value;
+		}
+	}
+}
+
+static void initialize(tile_t *tiles[TILES][TILES])
+{
+	// Symmetric and diagonally dominant, hence positive definite
+	const long size = TILES * TILE_SIZE;
+	for (int ti = 0; ti < TILES; ++ti) {
+		for (int tj = 0; tj <= ti; ++tj) {
+			double *tile = *tiles[ti][tj];
+			for (int i = 0; i < TILE_SIZE; ++i) {
+				for (int j = 0; j < TILE_SIZE; ++j) {
+					const long row = ti * TILE_SIZE + i;
+					const long column = tj * TILE_SIZE + j;
+					double value = 1.0 / (1.0 + std::labs(row - column));
+					if (row == column) {
+						value += size;
+					}
+					tile[i * TILE_SIZE + j] = value;
+				}
+			}
+		}
+	}
+}
+
+static double cholesky(tile_t *tiles[TILES][TILES])
+{
+	Timer timer;
+	for (int k = 0; k < TILES; ++k) {
+		double *Akk = *tiles[k][k];
+
+		#pragma oss task inout(Akk[0;TILE_SIZE*TILE_SIZE]) label("potrf")
+		potrf(Akk);
+
+		for (int i = k + 1; i < TILES; ++i) {
+			double *Aik = *tiles[i][k];
+
+			#pragma oss task in(Akk[0;TILE_SIZE*TILE_SIZE]) inout(Aik[0;TILE_SIZE*TILE_SIZE]) label("trsm")
+			trsm(Akk, Aik);
+		}
+
+		for (int i = k + 1; i < TILES; ++i) {
+			double *Aik = *tiles[i][k];
+
+			for (int j = k + 1; j <= i; ++j) {
+				double *Ajk = *tiles[j][k];
+				double *Aij = *tiles[i][j];
+
+				// The syrk of the diagonal tiles is computed as a gemm
+				#pragma oss task in(Aik[0;TILE_SIZE*TILE_SIZE], Ajk[0;TILE_SIZE*TILE_SIZE]) inout(Aij[0;TILE_SIZE*TILE_SIZE]) label("gemm")
+				gemm(Aik, Ajk, Aij);
+			}
+		}
+	}
+	#pragma oss taskwait
+	timer.stop();
+
+	return (double) timer;
+}
+
+int main(int argc, char **argv)
+{
+	const char *outputFile = (argc > 1) ? argv[1] : NULL;
+	const long numCPUs = nanos6_get_num_cpus();
+
+	BenchmarkReport report("cholesky");
+	report.addParameter("cpus", numCPUs);
+	report.addParameter("tiles", TILES);
+	report.addParameter("tile_size", TILE_SIZE);
+
+	const char *configOverride = getenv("NANOS6_CONFIG_OVERRIDE");
+	report.addParameter("config_override", (configOverride != NULL) ? configOverride : "");
+
+	tile_t *tiles[TILES][TILES];
+	for (int i = 0; i < TILES; ++i) {
+		for (int j = 0; j < TILES; ++j) {
+			tiles[i][j] = (j <= i) ? (tile_t *) malloc(sizeof(tile_t)) : NULL;
+		}
+	}
+
+	const double size = TILES * TILE_SIZE;
+	const double flops = size * size * size / 3.0;
+
+	for (int r = 0; r < REPETITIONS; ++r) {
+		initialize(tiles);
+		const double elapsed = cholesky(tiles);
+
+		report.addEntry("cholesky", {
+			{"cpus", numCPUs},
+			{"time_us", elapsed},
+			{"gflops", flops / (elapsed * 1e3)}
+		});
+	}
+
+	for (int i = 0; i < TILES; ++i) {
+		for (int j = 0; j <= i; ++j) {
+			free(tiles[i][j]);
+		}
+	}
+
+	if (!report.write(outputFile)) {
+		fprintf(stderr, "Could not write the results to %s\n", outputFile);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,188 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+//! Microbenchmarks of the cluster layer, to tune the cluster.* options
+//!
+//! Usage: cluster-bench [output.json]
+//!
+//! Must be run with cluster.communication enabled and at least two nodes.
+//! The results are printed as JSON to the given file, or to the standard
+//! output. The benchmarks only use the public API, so they measure the
+//! following runtime paths:
+//!
+//!  - offload_latency: round trip of an empty task offloaded to every remote
+//!    node, i.e., a MessageTaskNew followed by a MessageTaskFinished. This is
+//!    the ping-pong latency of the messenger plus the ClusterExecutionStep
+//!  - message_rate: throughput of empty tasks offloaded concurrently to every
+//!    remote node. Run with the "stats" instrumentation to get the breakdown
+//!    of the messages per MessageType
+//!  - fetch_bandwidth: time to offload a task that reads a region written by
+//!    the master node, so that its data is fetched by a ClusterDataCopyStep
+//!  - dmalloc_latency: latency of nanos6_dmalloc and nanos6_dfree, which
+//!    synchronize all the nodes. Compare runs with different number of nodes
+
+#include <nanos6/cluster.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "BenchmarkReport.hpp"
+#include "Timer.hpp"
+
+#define LATENCY_ITERATIONS (1000)
+#define RATE_TASKS (10000)
+#define FETCH_ITERATIONS (10)
+#define FETCH_MIN_SIZE (4UL * 1024)
+#define FETCH_MAX_SIZE (256UL * 1024 * 1024)
+#define DMALLOC_ITERATIONS (100)
+#define DMALLOC_SIZE (1024UL * 1024)
+
+
+static void offloadLatency(BenchmarkReport &report, int numNodes)
+{
+	for (int node = 1; node < numNodes; ++node) {
+		// Warm up the path to the node
+		#pragma oss task node(node)
+		{
+		}
+		#pragma oss taskwait
+
+		Timer timer;
+		for (int i = 0; i < LATENCY_ITERATIONS; ++i) {
+			#pragma oss task node(node)
+			{
+			}
+			#pragma oss taskwait
+		}
+		timer.stop();
+
+		report.addEntry("offload_latency", {
+			{"node", node},
+			{"iterations", LATENCY_ITERATIONS},
+			{"latency_us", (double) timer / LATENCY_ITERATIONS}
+		});
+	}
+}
+
+static void messageRate(BenchmarkReport &report, int numNodes)
+{
+	Timer timer;
+	for (int i = 0; i < RATE_TASKS; ++i) {
+		const int node = 1 + (i % (numNodes - 1));
+
+		#pragma oss task node(node)
+		{
+		}
+	}
+	#pragma oss taskwait
+	timer.stop();
+
+	// Every offloaded task sends a MessageTaskNew and a MessageTaskFinished
+	const double seconds = (double) timer / 1e6;
+	report.addEntry("message_rate", {
+		{"remote_nodes", numNodes - 1},
+		{"tasks", RATE_TASKS},
+		{"tasks_per_second", RATE_TASKS / seconds},
+		{"messages_per_second", 2 * RATE_TASKS / seconds}
+	});
+}
+
+static void fetchBandwidth(BenchmarkReport &report)
+{
+	char *data = (char *) nanos6_dmalloc(FETCH_MAX_SIZE, nanos6_equpart_distribution, 0, NULL);
+	if (data == NULL) {
+		fprintf(stderr, "Could not allocate distributed memory\n");
+		exit(1);
+	}
+
+	for (size_t size = FETCH_MIN_SIZE; size <= FETCH_MAX_SIZE; size *= 4) {
+		double elapsed = 0.0;
+
+		for (int i = 0; i < FETCH_ITERATIONS; ++i) {
+			// Write the region on the master, so that the remote node has
+			// to fetch it again
+			#pragma oss task out(data[0;size]) node(0)
+			memset(data, i, size);
+			#pragma oss taskwait
+
+			Timer timer;
+			#pragma oss task in(data[0;size]) node(1)
+			{
+			}
+			#pragma oss taskwait
+			timer.stop();
+
+			elapsed += (double) timer;
+		}
+
+		// Bytes per microsecond are equivalent to MB/s
+		const double latency = elapsed / FETCH_ITERATIONS;
+		report.addEntry("fetch_bandwidth", {
+			{"size", size},
+			{"time_us", latency},
+			{"bandwidth_MBps", size / latency}
+		});
+	}
+
+	nanos6_dfree(data, FETCH_MAX_SIZE);
+}
+
+static void dmallocLatency(BenchmarkReport &report, int numNodes)
+{
+	Timer allocTimer, freeTimer;
+	allocTimer.reset();
+	freeTimer.reset();
+
+	for (int i = 0; i < DMALLOC_ITERATIONS; ++i) {
+		allocTimer.start();
+		void *data = nanos6_dmalloc(DMALLOC_SIZE, nanos6_equpart_distribution, 0, NULL);
+		allocTimer.stop();
+
+		if (data == NULL) {
+			fprintf(stderr, "Could not allocate distributed memory\n");
+			exit(1);
+		}
+
+		freeTimer.start();
+		nanos6_dfree(data, DMALLOC_SIZE);
+		freeTimer.stop();
+	}
+
+	report.addEntry("dmalloc_latency", {
+		{"nodes", numNodes},
+		{"size", DMALLOC_SIZE},
+		{"dmalloc_us", (double) allocTimer / DMALLOC_ITERATIONS},
+		{"dfree_us", (double) freeTimer / DMALLOC_ITERATIONS}
+	});
+}
+
+int main(int argc, char **argv)
+{
+	const char *outputFile = (argc > 1) ? argv[1] : NULL;
+
+	BenchmarkReport report("cluster");
+
+	const int numNodes = nanos6_get_num_cluster_nodes();
+	report.addParameter("nodes", numNodes);
+
+	if (!nanos6_in_cluster_mode() || numNodes < 2) {
+		report.addParameter("skipped", "requires cluster mode with at least two nodes");
+		return report.write(outputFile) ? 0 : 1;
+	}
+
+	offloadLatency(report, numNodes);
+	messageRate(report, numNodes);
+	fetchBandwidth(report);
+	dmallocLatency(report, numNodes);
+
+	if (!report.write(outputFile)) {
+		fprintf(stderr, "Could not write the results to %s\n", outputFile);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,136 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+//! Throughput microbenchmark of the commutative accesses
+//!
+//! Usage: commutative-bench [output.json]
+//!
+//! The benchmark creates many independent chains of tasks with commutative
+//! accesses. The tasks of a chain exclude each other, but the tasks of
+//! different chains can run concurrently, so the throughput should grow with
+//! the number of CPUs unless the arbitration of the commutative accesses
+//! serializes them. The number of CPUs is taken from the process mask, so
+//! that run-benchmark.sh can run it with different numbers of CPUs. The
+//! results are printed as JSON to the given file, or to the standard output:
+//!
+//!  - one_access: each task has a commutative access to its chain
+//!  - two_accesses: each task has commutative accesses to its chain and to
+//!    the next one, so the chains overlap in pairs
+
+#include <nanos6/debug.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "BenchmarkReport.hpp"
+#include "Timer.hpp"
+
+#define CHAINS_PER_CPU (8)
+#define TASKS_PER_CHAIN (2000)
+#define TASK_COST (500)
+#define REPETITIONS (5)
+
+
+struct Chain {
+	double _value;
+	char _padding[128 - sizeof(double)];
+};
+
+static inline void work(Chain &chain)
+{
+	double value = chain._value;
+	for (long c = 0; c < TASK_COST; ++c) {
+		value = value * 1.0000001 + 0.0000001;
+	}
+	chain._value = value;
+}
+
+static double oneAccess(Chain *chains, long numChains)
+{
+	Timer timer;
+	for (long t = 0; t < TASKS_PER_CHAIN; ++t) {
+		for (long c = 0; c < numChains; ++c) {
+			#pragma oss task commutative(chains[c])
+			work(chains[c]);
+		}
+	}
+	#pragma oss taskwait
+	timer.stop();
+
+	return (double) timer;
+}
+
+static double twoAccesses(Chain *chains, long numChains)
+{
+	Timer timer;
+	for (long t = 0; t < TASKS_PER_CHAIN; ++t) {
+		for (long c = 0; c < numChains; c += 2) {
+			#pragma oss task commutative(chains[c], chains[c + 1])
+			{
+				work(chains[c]);
+				work(chains[c + 1]);
+			}
+		}
+	}
+	#pragma oss taskwait
+	timer.stop();
+
+	return (double) timer;
+}
+
+static void report(BenchmarkReport &report, char const *section, long numChains, long numTasks, double elapsed)
+{
+	report.addEntry(section, {
+		{"chains", numChains},
+		{"tasks", numTasks},
+		{"time_us", elapsed},
+		{"tasks_per_second", numTasks / (elapsed / 1e6)}
+	});
+}
+
+int main(int argc, char **argv)
+{
+	const char *outputFile = (argc > 1) ? argv[1] : NULL;
+	const long numCPUs = nanos6_get_num_cpus();
+	const long numChains = CHAINS_PER_CPU * numCPUs;
+
+	Chain *chains = (Chain *) malloc(numChains * sizeof(Chain));
+	if (chains == NULL) {
+		fprintf(stderr, "Could not allocate the chains\n");
+		return 1;
+	}
+	for (long c = 0; c < numChains; ++c) {
+		chains[c]._value = 1.0;
+	}
+
+	BenchmarkReport benchmarkReport("commutative");
+	benchmarkReport.addParameter("cpus", numCPUs);
+	benchmarkReport.addParameter("chains", numChains);
+	benchmarkReport.addParameter("task_cost", TASK_COST);
+
+	const char *configOverride = getenv("NANOS6_CONFIG_OVERRIDE");
+	benchmarkReport.addParameter("config_override", (configOverride != NULL) ? configOverride : "");
+
+	// Warm up the runtime structures
+	oneAccess(chains, numChains);
+
+	for (int r = 0; r < REPETITIONS; ++r) {
+		report(benchmarkReport, "one_access", numChains, TASKS_PER_CHAIN * numChains, oneAccess(chains, numChains));
+	}
+
+	for (int r = 0; r < REPETITIONS; ++r) {
+		report(benchmarkReport, "two_accesses", numChains, TASKS_PER_CHAIN * (numChains / 2), twoAccesses(chains, numChains));
+	}
+
+	free(chains);
+
+	if (!benchmarkReport.write(outputFile)) {
+		fprintf(stderr, "Could not write the results to %s\n", outputFile);
+		return 1;
+	}
+
+	return 0;
+}
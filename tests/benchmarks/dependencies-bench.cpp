@@ -0,0 +1,389 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+//! Microbenchmark of the dependency system through the task creation API
+//!
+//! Usage: dependencies-bench [output.json]
+//!
+//! The tasks are created directly with nanos6_create_task and
+//! nanos6_submit_task, and their accesses are registered with the
+//! nanos6_register_region_*_depinfo1 functions, so it does not need an OmpSs-2
+//! compiler. All the tasks are empty except for a few updates of their data,
+//! so the measured times are dominated by the creation of the tasks and the
+//! registration, release and propagation of their accesses. The program runs
+//! with the dependency implementation of the runtime it is linked to, and
+//! run-benchmark.sh runs it with each of them. The results are printed
+//! as JSON to the given file, or to the standard output, and each entry has
+//! the throughput in tasks per second and the average time per task in ns:
+//!
+//!  - creation: independent tasks, each with an inout access to a different
+//!    element; it also reports the time spent creating them
+//!  - chain: tasks with an inout access to the same element
+//!  - fanout_fanin: one writer followed by many readers of the same element,
+//!    which are all joined by the next writer
+//!  - concurrent: tasks with a concurrent access to the same element
+//!  - commutative: tasks with a commutative access to the same element; there
+//!    are fewer, since all the waiting ones compete again on each release
+//!  - reduction: tasks with an addition reduction over the same element
+//!  - taskwait_on: each task is followed by a taskwait on its element
+//!  - nesting: a binary tree of tasks with weak accesses over halves of an
+//!    array, whose leaves have strong accesses to single elements
+
+#include <nanos6.h>
+#include <nanos6/debug.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "BenchmarkReport.hpp"
+#include "Timer.hpp"
+
+#define NUM_TASKS (100000)
+#define NUM_COMMUTATIVE_TASKS (5000)
+#define NUM_TASKWAITS (10000)
+#define FANOUT_WIDTH (64)
+#define NESTING_DEPTH (16)
+#define REPETITIONS (5)
+
+
+struct TaskArgs {
+	long *_data;
+	long _elements;
+};
+
+//! The information of a type of task and its only implementation
+struct TaskType {
+	nanos6_task_implementation_info_t _implementation;
+	nanos6_task_info_t _info;
+};
+
+static nanos6_task_invocation_info_t invocationInfo = { "dependencies-bench.cpp" };
+
+static TaskType updateTask;
+static TaskType readTask;
+static TaskType concurrentTask;
+static TaskType commutativeTask;
+static TaskType reductionTask;
+static TaskType taskwaitOnTask;
+static TaskType nestedTask;
+
+static long *array;
+static long element;
+
+
+static void createTask(TaskType &type, long *data, long elements, size_t flags = 0)
+{
+	void *argsBlock = nullptr;
+	void *task = nullptr;
+
+	nanos6_create_task(&type._info, &invocationInfo, sizeof(TaskArgs), &argsBlock, &task, flags, 1);
+
+	TaskArgs *args = (TaskArgs *) argsBlock;
+	args->_data = data;
+	args->_elements = elements;
+
+	nanos6_submit_task(task);
+}
+
+
+//
+// Bodies of the tasks
+//
+
+static void updateBody(void *argsBlock, void *, nanos6_address_translation_entry_t *)
+{
+	TaskArgs *args = (TaskArgs *) argsBlock;
+	(*args->_data)++;
+}
+
+static void emptyBody(void *, void *, nanos6_address_translation_entry_t *)
+{
+}
+
+static void concurrentBody(void *argsBlock, void *, nanos6_address_translation_entry_t *)
+{
+	TaskArgs *args = (TaskArgs *) argsBlock;
+	__atomic_fetch_add(args->_data, 1, __ATOMIC_RELAXED);
+}
+
+static void reductionBody(void *argsBlock, void *, nanos6_address_translation_entry_t *translationTable)
+{
+	TaskArgs *args = (TaskArgs *) argsBlock;
+
+	// The private storage of the reduction is given by the translation table
+	long *data = args->_data;
+	if (translationTable != nullptr && translationTable[0].device_address != 0) {
+		data = (long *) (translationTable[0].device_address + ((size_t) data - translationTable[0].local_address));
+	}
+	(*data)++;
+}
+
+static void nestedBody(void *argsBlock, void *, nanos6_address_translation_entry_t *)
+{
+	TaskArgs *args = (TaskArgs *) argsBlock;
+
+	if (args->_elements == 1) {
+		(*args->_data)++;
+	} else {
+		long half = args->_elements / 2;
+		createTask(nestedTask, args->_data, half);
+		createTask(nestedTask, args->_data + half, args->_elements - half);
+	}
+}
+
+
+//
+// Registration of the accesses
+//
+
+#define REGISTER_ACCESS(registrationFunction, handler, args) \
+	registrationFunction(handler, 0, "data", (args)->_data, \
+		(args)->_elements * sizeof(long), 0, (args)->_elements * sizeof(long))
+
+static void registerUpdate(void *argsBlock, void *, void *handler)
+{
+	REGISTER_ACCESS(nanos6_register_region_readwrite_depinfo1, handler, (TaskArgs *) argsBlock);
+}
+
+static void registerRead(void *argsBlock, void *, void *handler)
+{
+	REGISTER_ACCESS(nanos6_register_region_read_depinfo1, handler, (TaskArgs *) argsBlock);
+}
+
+static void registerConcurrent(void *argsBlock, void *, void *handler)
+{
+	REGISTER_ACCESS(nanos6_register_region_concurrent_depinfo1, handler, (TaskArgs *) argsBlock);
+}
+
+static void registerCommutative(void *argsBlock, void *, void *handler)
+{
+	REGISTER_ACCESS(nanos6_register_region_commutative_depinfo1, handler, (TaskArgs *) argsBlock);
+}
+
+static void registerReduction(void *argsBlock, void *, void *handler)
+{
+	TaskArgs *args = (TaskArgs *) argsBlock;
+	nanos6_register_region_reduction_depinfo1(
+		RED_TYPE_LONG + RED_OP_ADDITION, 0,
+		handler, 0, "data", args->_data,
+		args->_elements * sizeof(long), 0, args->_elements * sizeof(long));
+}
+
+static void registerNested(void *argsBlock, void *, void *handler)
+{
+	TaskArgs *args = (TaskArgs *) argsBlock;
+	if (args->_elements == 1) {
+		REGISTER_ACCESS(nanos6_register_region_readwrite_depinfo1, handler, args);
+	} else {
+		REGISTER_ACCESS(nanos6_register_region_weak_readwrite_depinfo1, handler, args);
+	}
+}
+
+static void reductionInitializer(void *privateStorage, void *, size_t size)
+{
+	memset(privateStorage, 0, size);
+}
+
+static void reductionCombiner(void *output, void *input, size_t size)
+{
+	for (size_t i = 0; i < size / sizeof(long); ++i) {
+		((long *) output)[i] += ((long *) input)[i];
+	}
+}
+
+static void (*reductionInitializers[])(void *, void *, size_t) = { reductionInitializer };
+static void (*reductionCombiners[])(void *, void *, size_t) = { reductionCombiner };
+
+
+static void initializeTaskType(
+	TaskType &type, char const *label,
+	void (*run)(void *, void *, nanos6_address_translation_entry_t *),
+	void (*registerDepinfo)(void *, void *, void *)
+) {
+	type._implementation.device_type_id = nanos6_host_device;
+	type._implementation.run = run;
+	type._implementation.task_label = label;
+	type._implementation.declaration_source = "dependencies-bench.cpp";
+
+	type._info.num_symbols = 1;
+	type._info.register_depinfo = registerDepinfo;
+	type._info.implementation_count = 1;
+	type._info.implementations = &type._implementation;
+
+	nanos6_register_task_info(&type._info);
+}
+
+//! The task types must be registered before the runtime starts, as the
+//! compilers do
+__attribute__((constructor))
+static void registerTaskTypes()
+{
+	initializeTaskType(updateTask, "update", updateBody, registerUpdate);
+	initializeTaskType(readTask, "read", emptyBody, registerRead);
+	initializeTaskType(concurrentTask, "concurrent", concurrentBody, registerConcurrent);
+	initializeTaskType(commutativeTask, "commutative", updateBody, registerCommutative);
+	initializeTaskType(taskwaitOnTask, "taskwait_on", emptyBody, registerUpdate);
+	initializeTaskType(nestedTask, "nested", nestedBody, registerNested);
+
+	reductionTask._info.reduction_initializers = reductionInitializers;
+	reductionTask._info.reduction_combiners = reductionCombiners;
+	initializeTaskType(reductionTask, "reduction", reductionBody, registerReduction);
+}
+
+
+//
+// Sections of the benchmark
+//
+
+static long creation(double &creationTime)
+{
+	Timer timer;
+	for (long t = 0; t < NUM_TASKS; ++t) {
+		createTask(updateTask, &array[t], 1);
+	}
+	timer.stop();
+	creationTime = (double) timer;
+
+	nanos6_taskwait("dependencies-bench.cpp:creation");
+
+	return NUM_TASKS;
+}
+
+static long sameElement(TaskType &type, long numTasks = NUM_TASKS)
+{
+	for (long t = 0; t < numTasks; ++t) {
+		createTask(type, &element, 1);
+	}
+	nanos6_taskwait("dependencies-bench.cpp:same_element");
+
+	return numTasks;
+}
+
+static long fanoutFanin()
+{
+	long tasks = 0;
+	while (tasks + FANOUT_WIDTH + 1 <= NUM_TASKS) {
+		createTask(updateTask, &element, 1);
+		for (long r = 0; r < FANOUT_WIDTH; ++r) {
+			createTask(readTask, &element, 1);
+		}
+		tasks += FANOUT_WIDTH + 1;
+	}
+	nanos6_taskwait("dependencies-bench.cpp:fanout_fanin");
+
+	return tasks;
+}
+
+static long taskwaitOn()
+{
+	for (long t = 0; t < NUM_TASKWAITS; ++t) {
+		createTask(updateTask, &element, 1);
+
+		// A taskwait on an element is an if0 task with the same access
+		createTask(taskwaitOnTask, &element, 1, nanos6_if_0_task);
+	}
+	nanos6_taskwait("dependencies-bench.cpp:taskwait_on");
+
+	return NUM_TASKWAITS;
+}
+
+static long nesting()
+{
+	const long leaves = 1L << NESTING_DEPTH;
+
+	createTask(nestedTask, array, leaves);
+	nanos6_taskwait("dependencies-bench.cpp:nesting");
+
+	return 2 * leaves - 1;
+}
+
+static void report(BenchmarkReport &report, char const *section, long tasks, double elapsed)
+{
+	report.addEntry(section, {
+		{"tasks", tasks},
+		{"time_us", elapsed},
+		{"tasks_per_second", tasks / (elapsed / 1e6)},
+		{"ns_per_task", (elapsed * 1e3) / tasks}
+	});
+}
+
+#define RUN_SECTION(benchmarkReport, section, call) \
+	for (int r = 0; r < REPETITIONS; ++r) { \
+		Timer timer; \
+		long tasks = (call); \
+		timer.stop(); \
+		report(benchmarkReport, section, tasks, (double) timer); \
+	}
+
+
+int main(int argc, char **argv)
+{
+	const char *outputFile = (argc > 1) ? argv[1] : NULL;
+	const long arraySize = (NUM_TASKS > (1L << NESTING_DEPTH)) ? NUM_TASKS : (1L << NESTING_DEPTH);
+
+	array = (long *) calloc(arraySize, sizeof(long));
+	if (array == NULL) {
+		fprintf(stderr, "Could not allocate the array\n");
+		return 1;
+	}
+
+	BenchmarkReport benchmarkReport("dependencies");
+	benchmarkReport.addParameter("cpus", (long) nanos6_get_num_cpus());
+	benchmarkReport.addParameter("tasks", NUM_TASKS);
+	benchmarkReport.addParameter("commutative_tasks", NUM_COMMUTATIVE_TASKS);
+	benchmarkReport.addParameter("taskwaits", NUM_TASKWAITS);
+	benchmarkReport.addParameter("fanout_width", FANOUT_WIDTH);
+	benchmarkReport.addParameter("nesting_depth", NESTING_DEPTH);
+
+	const char *configOverride = getenv("NANOS6_CONFIG_OVERRIDE");
+	benchmarkReport.addParameter("config_override", (configOverride != NULL) ? configOverride : "");
+
+	// Warm up the runtime structures
+	double creationTime;
+	creation(creationTime);
+
+	for (int r = 0; r < REPETITIONS; ++r) {
+		Timer timer;
+		long tasks = creation(creationTime);
+		timer.stop();
+
+		double elapsed = (double) timer;
+		benchmarkReport.addEntry("creation", {
+			{"tasks", tasks},
+			{"time_us", elapsed},
+			{"creation_us", creationTime},
+			{"tasks_per_second", tasks / (elapsed / 1e6)},
+			{"ns_per_task", (elapsed * 1e3) / tasks},
+			{"creation_ns_per_task", (creationTime * 1e3) / tasks}
+		});
+	}
+
+	RUN_SECTION(benchmarkReport, "chain", sameElement(updateTask));
+	RUN_SECTION(benchmarkReport, "fanout_fanin", fanoutFanin());
+	RUN_SECTION(benchmarkReport, "concurrent", sameElement(concurrentTask));
+	RUN_SECTION(benchmarkReport, "commutative", sameElement(commutativeTask, NUM_COMMUTATIVE_TASKS));
+
+	element = 0;
+	RUN_SECTION(benchmarkReport, "reduction", sameElement(reductionTask));
+	if (element != REPETITIONS * NUM_TASKS) {
+		fprintf(stderr, "Wrong result of the reductions: %ld instead of %ld\n",
+			element, (long) REPETITIONS * NUM_TASKS);
+		return 1;
+	}
+
+	RUN_SECTION(benchmarkReport, "taskwait_on", taskwaitOn());
+	RUN_SECTION(benchmarkReport, "nesting", nesting());
+
+	free(array);
+
+	if (!benchmarkReport.write(outputFile)) {
+		fprintf(stderr, "Could not write the results to %s\n", outputFile);
+		return 1;
+	}
+
+	return 0;
+}
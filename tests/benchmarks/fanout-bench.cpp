@@ -0,0 +1,123 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+//! Fan-out microbenchmark of the bottom map of the dependencies
+//!
+//! Usage: fanout-bench [output.json]
+//!
+//! A single parent task creates many empty children whose accesses fall on a
+//! small set of addresses, so every child registration looks up and updates
+//! the bottom map of the parent. The creation time is dominated by that path,
+//! so running it against two builds of the runtime compares their bottom maps.
+//! The results are printed as JSON to the given file, or to the standard
+//! output:
+//!
+//!  - one_address: each child has an inout access to one of the addresses
+//!  - all_addresses: each child has an in access to all the addresses
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "BenchmarkReport.hpp"
+#include "Timer.hpp"
+
+#define NUM_CHILDREN (100000)
+#define NUM_ADDRESSES (16)
+#define REPETITIONS (5)
+
+
+struct Element {
+	long _value;
+	char _padding[64 - sizeof(long)];
+};
+
+static Element elements[NUM_ADDRESSES];
+
+static void oneAddress(double &creation, double &total)
+{
+	Timer totalTimer;
+	#pragma oss task shared(creation)
+	{
+		Timer creationTimer;
+		for (long c = 0; c < NUM_CHILDREN; ++c) {
+			#pragma oss task inout(elements[c % NUM_ADDRESSES])
+			elements[c % NUM_ADDRESSES]._value++;
+		}
+		creationTimer.stop();
+		creation = (double) creationTimer;
+
+		#pragma oss taskwait
+	}
+	#pragma oss taskwait
+	totalTimer.stop();
+
+	total = (double) totalTimer;
+}
+
+static void allAddresses(double &creation, double &total)
+{
+	Timer totalTimer;
+	#pragma oss task shared(creation)
+	{
+		Timer creationTimer;
+		for (long c = 0; c < NUM_CHILDREN; ++c) {
+			#pragma oss task in({elements[a], a=0;NUM_ADDRESSES})
+			{
+			}
+		}
+		creationTimer.stop();
+		creation = (double) creationTimer;
+
+		#pragma oss taskwait
+	}
+	#pragma oss taskwait
+	totalTimer.stop();
+
+	total = (double) totalTimer;
+}
+
+static void report(BenchmarkReport &report, char const *section, double creation, double total)
+{
+	report.addEntry(section, {
+		{"children", NUM_CHILDREN},
+		{"creation_us", creation},
+		{"total_us", total},
+		{"children_per_second", NUM_CHILDREN / (creation / 1e6)}
+	});
+}
+
+int main(int argc, char **argv)
+{
+	const char *outputFile = (argc > 1) ? argv[1] : NULL;
+	double creation, total;
+
+	BenchmarkReport benchmarkReport("fanout");
+	benchmarkReport.addParameter("children", NUM_CHILDREN);
+	benchmarkReport.addParameter("addresses", NUM_ADDRESSES);
+
+	const char *configOverride = getenv("NANOS6_CONFIG_OVERRIDE");
+	benchmarkReport.addParameter("config_override", (configOverride != NULL) ? configOverride : "");
+
+	// Warm up the runtime structures
+	oneAddress(creation, total);
+
+	for (int r = 0; r < REPETITIONS; ++r) {
+		oneAddress(creation, total);
+		report(benchmarkReport, "one_address", creation, total);
+	}
+
+	for (int r = 0; r < REPETITIONS; ++r) {
+		allAddresses(creation, total);
+		report(benchmarkReport, "all_addresses", creation, total);
+	}
+
+	if (!benchmarkReport.write(outputFile)) {
+		fprintf(stderr, "Could not write the results to %s\n", outputFile);
+		return 1;
+	}
+
+	return 0;
+}
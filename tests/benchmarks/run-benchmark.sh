@@ -0,0 +1,121 @@
+#!/bin/bash
+#
+#	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+#
+#	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+#
+# Run a microbenchmark with each of the runtime configurations that it
+# compares, and write one JSON report per configuration to the output
+# directory. The benchmarks that measure scalability are also run from 1 to
+# 128 CPUs, up to the number of available CPUs
+#
+#   access-layout  size and registration cost of the accesses of both
+#                  dependency implementations
+#   cholesky       L2 and L3 cache misses with the default and the
+#                  locality-aware immediate successor, read through PAPI
+#   commutative    throughput of commutative chains with the discrete
+#                  dependencies
+#   dependencies   throughput and overhead per task of both dependency
+#                  implementations
+#   fanout         registration of a large fan-out with both dependency
+#                  implementations
+#   scheduler      throughput of the delegation lock and the work-stealing
+#                  host schedulers
+#   siblings       throughput of siblings on disjoint subregions with the
+#                  regions dependencies
+#   taskfor        load balance of the static, guided and adaptive taskfor
+#                  chunk schedules
+#
+# Usage: run-benchmark.sh <benchmark> <benchmark binary> [output directory]
+
+usage() {
+	echo "Usage: $0 <benchmark> <benchmark binary> [output directory]"
+	echo "where <benchmark> is one of: access-layout cholesky commutative dependencies fanout scheduler siblings taskfor"
+}
+
+if [ $# -lt 2 ]; then
+	usage
+	exit 1
+fi
+
+name=$1
+benchmark=$2
+output=${3:-.}
+available=$(nproc)
+
+# Each configuration is a "<label>=<NANOS6_CONFIG_OVERRIDE>" pair. The label
+# names the report and may be empty when there is a single configuration
+cpu_sweep=false
+case "${name}" in
+	access-layout|dependencies|fanout)
+		configs="discrete=version.dependencies=discrete regions=version.dependencies=regions"
+		;;
+	cholesky)
+		configs="default=scheduler.locality_immediate_successor=false locality=scheduler.locality_immediate_successor=true"
+		;;
+	commutative)
+		configs="=version.dependencies=discrete"
+		cpu_sweep=true
+		;;
+	scheduler)
+		configs="delegation=scheduler.work_stealing=false work-stealing=scheduler.work_stealing=true"
+		cpu_sweep=true
+		;;
+	siblings)
+		configs="=version.dependencies=regions"
+		cpu_sweep=true
+		;;
+	taskfor)
+		configs="static=taskfor.schedule=static guided=taskfor.schedule=guided adaptive=taskfor.schedule=adaptive"
+		;;
+	*)
+		usage
+		exit 1
+		;;
+esac
+
+if [ "${cpu_sweep}" = "true" ]; then
+	cpu_counts="1 2 4 8 16 32 64 128"
+else
+	cpu_counts="all"
+fi
+
+mkdir -p "${output}"
+
+for cpus in ${cpu_counts}; do
+	if [ "${cpus}" != "all" ] && [ ${cpus} -gt ${available} ]; then
+		break
+	fi
+
+	for config in ${configs}; do
+		label=${config%%=*}
+		override=${config#*=}
+
+		report="${name}"
+		if [ -n "${label}" ]; then
+			report="${report}-${label}"
+		fi
+
+		launcher=""
+		if [ "${cpus}" != "all" ]; then
+			report="${report}-${cpus}"
+			launcher="taskset -c 0-$((cpus - 1))"
+		fi
+
+		if [ "${name}" = "cholesky" ]; then
+			# Lists cannot be overriden through NANOS6_CONFIG_OVERRIDE
+			export NANOS6_CONFIG="${output}/nanos6-${label}.toml"
+			cat > "${NANOS6_CONFIG}" <<-CONFIG
+			[hardware_counters]
+				verbose = true
+				verbose_file = "${output}/hwcounters-${label}.txt"
+				[hardware_counters.papi]
+					enabled = true
+					counters = [ "PAPI_L2_TCM", "PAPI_L3_TCM", "PAPI_TOT_CYC" ]
+			CONFIG
+		fi
+
+		NANOS6_CONFIG_OVERRIDE="${override}" \
+			${launcher} "${benchmark}" "${output}/${report}.json" || exit 1
+	done
+done
@@ -0,0 +1,108 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+//! Task throughput microbenchmark of the host scheduler
+//!
+//! Usage: scheduler-bench [output.json]
+//!
+//! The benchmark runs empty tasks, so it measures how fast the scheduler can
+//! add and serve ready tasks. The scheduler and the number of CPUs are taken
+//! from the runtime configuration, so that run-benchmark.sh can compare the
+//! delegation lock scheduler against the work-stealing one at different
+//! numbers of CPUs. The results are printed as JSON to the given file, or to
+//! the standard output:
+//!
+//!  - single_creator: a single task creates all the tasks, so every CPU has to
+//!    get its tasks from the queue of the creator
+//!  - parallel_creators: one creator task per CPU creates its share of the
+//!    tasks, so that the CPUs mostly run the tasks that they create
+
+#include <nanos6/debug.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "BenchmarkReport.hpp"
+#include "Timer.hpp"
+
+#define TASKS (200000)
+#define REPETITIONS (5)
+
+
+static void createTasks(long numTasks)
+{
+	for (long i = 0; i < numTasks; ++i) {
+		#pragma oss task
+		{
+		}
+	}
+}
+
+static double singleCreator()
+{
+	Timer timer;
+	createTasks(TASKS);
+	#pragma oss taskwait
+	timer.stop();
+
+	return (double) timer;
+}
+
+static double parallelCreators(long numCPUs)
+{
+	const long tasksPerCreator = TASKS / numCPUs;
+
+	Timer timer;
+	for (long c = 0; c < numCPUs; ++c) {
+		#pragma oss task
+		createTasks(tasksPerCreator);
+	}
+	#pragma oss taskwait
+	timer.stop();
+
+	return (double) timer;
+}
+
+static void report(BenchmarkReport &report, char const *section, long numCPUs, long numTasks, double elapsed)
+{
+	report.addEntry(section, {
+		{"cpus", numCPUs},
+		{"tasks", numTasks},
+		{"time_us", elapsed},
+		{"tasks_per_second", numTasks / (elapsed / 1e6)}
+	});
+}
+
+int main(int argc, char **argv)
+{
+	const char *outputFile = (argc > 1) ? argv[1] : NULL;
+	const long numCPUs = nanos6_get_num_cpus();
+
+	BenchmarkReport benchmarkReport("scheduler");
+	benchmarkReport.addParameter("cpus", numCPUs);
+
+	const char *configOverride = getenv("NANOS6_CONFIG_OVERRIDE");
+	benchmarkReport.addParameter("config_override", (configOverride != NULL) ? configOverride : "");
+
+	// Warm up the runtime structures
+	singleCreator();
+
+	for (int r = 0; r < REPETITIONS; ++r) {
+		report(benchmarkReport, "single_creator", numCPUs, TASKS, singleCreator());
+	}
+
+	for (int r = 0; r < REPETITIONS; ++r) {
+		const long numTasks = (TASKS / numCPUs) * numCPUs;
+		report(benchmarkReport, "parallel_creators", numCPUs, numTasks, parallelCreators(numCPUs));
+	}
+
+	if (!benchmarkReport.write(outputFile)) {
+		fprintf(stderr, "Could not write the results to %s\n", outputFile);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,135 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+//! Scalability microbenchmark of sibling tasks on disjoint subregions
+//!
+//! Usage: siblings-bench [output.json]
+//!
+//! A parent task creates many children whose accesses are disjoint blocks of
+//! the same array, so the children never depend on each other and their cost
+//! is dominated by the registration and unregistration of their accesses in
+//! the structures of the parent. The number of CPUs is taken from the process
+//! mask, so that run-benchmark.sh can run it with different numbers of CPUs.
+//! The results are printed as JSON to the given file, or to the standard
+//! output:
+//!
+//!  - no_parent_access: the parent has no access, so the children only
+//!    populate its bottom map
+//!  - weak_parent_access: the parent has a weak access to the whole array,
+//!    which is fragmented by every child
+
+#include <nanos6/debug.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "BenchmarkReport.hpp"
+#include "Timer.hpp"
+
+#define BLOCKS_PER_CPU (4096)
+#define BLOCK_SIZE (16)
+#define TASK_COST (200)
+#define REPETITIONS (5)
+
+
+static inline void work(double *block)
+{
+	for (long c = 0; c < TASK_COST; ++c) {
+		block[c % BLOCK_SIZE] = block[c % BLOCK_SIZE] * 1.0000001 + 0.0000001;
+	}
+}
+
+static void createChildren(double *array, long numBlocks)
+{
+	for (long b = 0; b < numBlocks; ++b) {
+		double *block = &array[b * BLOCK_SIZE];
+
+		#pragma oss task inout(block[0;BLOCK_SIZE])
+		work(block);
+	}
+}
+
+static double noParentAccess(double *array, long numBlocks)
+{
+	Timer timer;
+	#pragma oss task
+	{
+		createChildren(array, numBlocks);
+		#pragma oss taskwait
+	}
+	#pragma oss taskwait
+	timer.stop();
+
+	return (double) timer;
+}
+
+static double weakParentAccess(double *array, long numBlocks)
+{
+	Timer timer;
+	#pragma oss task weakinout(array[0;numBlocks * BLOCK_SIZE])
+	{
+		createChildren(array, numBlocks);
+		#pragma oss taskwait
+	}
+	#pragma oss taskwait
+	timer.stop();
+
+	return (double) timer;
+}
+
+static void report(BenchmarkReport &report, char const *section, long numBlocks, double elapsed)
+{
+	report.addEntry(section, {
+		{"tasks", numBlocks},
+		{"time_us", elapsed},
+		{"tasks_per_second", numBlocks / (elapsed / 1e6)}
+	});
+}
+
+int main(int argc, char **argv)
+{
+	const char *outputFile = (argc > 1) ? argv[1] : NULL;
+	const long numCPUs = nanos6_get_num_cpus();
+	const long numBlocks = BLOCKS_PER_CPU * numCPUs;
+
+	double *array = (double *) malloc(numBlocks * BLOCK_SIZE * sizeof(double));
+	if (array == NULL) {
+		fprintf(stderr, "Could not allocate the array\n");
+		return 1;
+	}
+	for (long i = 0; i < numBlocks * BLOCK_SIZE; ++i) {
+		array[i] = 1.0;
+	}
+
+	BenchmarkReport benchmarkReport("siblings");
+	benchmarkReport.addParameter("cpus", numCPUs);
+	benchmarkReport.addParameter("blocks", numBlocks);
+	benchmarkReport.addParameter("block_size", BLOCK_SIZE);
+	benchmarkReport.addParameter("task_cost", TASK_COST);
+
+	const char *configOverride = getenv("NANOS6_CONFIG_OVERRIDE");
+	benchmarkReport.addParameter("config_override", (configOverride != NULL) ? configOverride : "");
+
+	// Warm up the runtime structures
+	noParentAccess(array, numBlocks);
+
+	for (int r = 0; r < REPETITIONS; ++r) {
+		report(benchmarkReport, "no_parent_access", numBlocks, noParentAccess(array, numBlocks));
+	}
+
+	for (int r = 0; r < REPETITIONS; ++r) {
+		report(benchmarkReport, "weak_parent_access", numBlocks, weakParentAccess(array, numBlocks));
+	}
+
+	free(array);
+
+	if (!benchmarkReport.write(outputFile)) {
+		fprintf(stderr, "Could not write the results to %s\n", outputFile);
+		return 1;
+	}
+
+	return 0;
+}
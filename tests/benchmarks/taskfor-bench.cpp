@@ -0,0 +1,147 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+//! Load balance microbenchmark of the taskfor chunk schedules
+//!
+//! Usage: taskfor-bench [output.json]
+//!
+//! The benchmark runs taskfors whose iterations have skewed costs. The chunk
+//! schedule is taken from the runtime configuration, so that run-benchmark.sh
+//! can compare the static, guided and adaptive schedules. The results are
+//! printed as JSON to the given file, or to the standard output, together
+//! with the ideal time of each loop, which is its total work divided by the
+//! number of CPUs:
+//!
+//!  - ramp: the cost of each iteration grows linearly with its index, so the
+//!    last chunks are the most expensive
+//!  - spikes: one out of every SPIKE_PERIOD iterations is SPIKE_COST times
+//!    more expensive than the rest
+
+#include <nanos6/debug.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "BenchmarkReport.hpp"
+#include "Timer.hpp"
+
+#define ITERATIONS (100000)
+#define BASE_COST (200)
+#define SPIKE_PERIOD (100)
+#define SPIKE_COST (200)
+#define REPETITIONS (5)
+
+
+static double _sink;
+
+static inline long rampCost(long i)
+{
+	return 1 + (2 * BASE_COST * i) / ITERATIONS;
+}
+
+static inline long spikeCost(long i)
+{
+	return ((i % SPIKE_PERIOD) == 0) ? BASE_COST * SPIKE_COST : BASE_COST;
+}
+
+static inline void work(long cost)
+{
+	double value = 1.0;
+	for (long c = 0; c < cost; ++c) {
+		value = value * 1.0000001 + 0.0000001;
+	}
+	_sink = value;
+}
+
+static double ramp()
+{
+	Timer timer;
+	#pragma oss task for
+	for (long i = 0; i < ITERATIONS; ++i) {
+		work(rampCost(i));
+	}
+	#pragma oss taskwait
+	timer.stop();
+
+	return (double) timer;
+}
+
+static double spikes()
+{
+	Timer timer;
+	#pragma oss task for
+	for (long i = 0; i < ITERATIONS; ++i) {
+		work(spikeCost(i));
+	}
+	#pragma oss taskwait
+	timer.stop();
+
+	return (double) timer;
+}
+
+//! \brief Measure the time of a single unit of cost in microseconds
+static double unitTime()
+{
+	const long cost = 10000000;
+
+	Timer timer;
+	work(cost);
+	timer.stop();
+
+	return (double) timer / cost;
+}
+
+static void report(BenchmarkReport &report, char const *section, long numCPUs, long totalCost, double unit, double elapsed)
+{
+	const double ideal = (totalCost * unit) / numCPUs;
+
+	report.addEntry(section, {
+		{"cpus", numCPUs},
+		{"iterations", (long) ITERATIONS},
+		{"time_us", elapsed},
+		{"ideal_time_us", ideal},
+		{"efficiency", ideal / elapsed}
+	});
+}
+
+int main(int argc, char **argv)
+{
+	const char *outputFile = (argc > 1) ? argv[1] : NULL;
+	const long numCPUs = nanos6_get_num_cpus();
+
+	BenchmarkReport benchmarkReport("taskfor");
+	benchmarkReport.addParameter("cpus", numCPUs);
+
+	const char *configOverride = getenv("NANOS6_CONFIG_OVERRIDE");
+	benchmarkReport.addParameter("config_override", (configOverride != NULL) ? configOverride : "");
+
+	long rampTotal = 0;
+	long spikesTotal = 0;
+	for (long i = 0; i < ITERATIONS; ++i) {
+		rampTotal += rampCost(i);
+		spikesTotal += spikeCost(i);
+	}
+
+	const double unit = unitTime();
+
+	// Warm up the runtime structures
+	ramp();
+
+	for (int r = 0; r < REPETITIONS; ++r) {
+		report(benchmarkReport, "ramp", numCPUs, rampTotal, unit, ramp());
+	}
+
+	for (int r = 0; r < REPETITIONS; ++r) {
+		report(benchmarkReport, "spikes", numCPUs, spikesTotal, unit, spikes());
+	}
+
+	if (!benchmarkReport.write(outputFile)) {
+		fprintf(stderr, "Could not write the results to %s\n", outputFile);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,148 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+// Round trip of the codec used to compress large cluster data transfers. The
+// codec is built from the sources of the runtime, so this test does not need
+// several cluster nodes to check it
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "TestAnyProtocolProducer.hpp"
+
+#include "cluster/messenger/DataCompression.hpp"
+
+
+#define CHUNK_SIZE (64 * 1024)
+
+
+TestAnyProtocolProducer tap;
+
+
+enum pattern_t {
+	ZEROS = 0,
+	SMALL_INTEGERS,
+	RAMP_OF_DOUBLES,
+	RANDOM_BYTES,
+	LONG_RUNS,
+	NUM_PATTERNS
+};
+
+static char const *patternNames[NUM_PATTERNS] = {
+	"zeros",
+	"small integers",
+	"ramp of doubles",
+	"random bytes",
+	"long runs"
+};
+
+static void fill(pattern_t pattern, unsigned char *buffer, size_t size, unsigned int seed)
+{
+	switch (pattern) {
+		case ZEROS:
+			memset(buffer, 0, size);
+			break;
+		case SMALL_INTEGERS:
+			for (size_t i = 0; i + sizeof(int) <= size; i += sizeof(int)) {
+				int value = (int) ((i / sizeof(int)) % 100);
+				memcpy(buffer + i, &value, sizeof(int));
+			}
+			memset(buffer + size - size % sizeof(int), 7, size % sizeof(int));
+			break;
+		case RAMP_OF_DOUBLES:
+			for (size_t i = 0; i + sizeof(double) <= size; i += sizeof(double)) {
+				double value = 1.0 + (double) (i / sizeof(double)) * 1e-3;
+				memcpy(buffer + i, &value, sizeof(double));
+			}
+			memset(buffer + size - size % sizeof(double), 3, size % sizeof(double));
+			break;
+		case RANDOM_BYTES:
+			for (size_t i = 0; i < size; ++i) {
+				buffer[i] = (unsigned char) rand_r(&seed);
+			}
+			break;
+		case LONG_RUNS:
+			for (size_t i = 0; i < size; ++i) {
+				buffer[i] = (unsigned char) ((i / 1000) % 2 ? 0xff : 0x00);
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+//! \returns whether the chunk is restored, and whether it was compressed
+static bool roundTrip(pattern_t pattern, size_t size, size_t elementSize, bool &shrunk)
+{
+	std::vector<unsigned char> original(size);
+	std::vector<unsigned char> restored(size, 0xAB);
+	std::vector<unsigned char> scratch(size);
+	std::vector<unsigned char> compressed(DataCompression::getChunkBound(size));
+
+	fill(pattern, original.data(), size, (unsigned int) (size + elementSize));
+
+	const size_t compressedSize = DataCompression::compressChunk(
+		original.data(), size, elementSize, scratch.data(), compressed.data());
+	if (compressedSize > DataCompression::getChunkBound(size)) {
+		return false;
+	}
+	shrunk = (compressedSize < size);
+
+	DataCompression::decompressChunk(
+		compressed.data(), size, elementSize, scratch.data(), restored.data());
+
+	return (memcmp(original.data(), restored.data(), size) == 0);
+}
+
+
+int main()
+{
+	// Sizes that are not a multiple of the element size leave trailing bytes
+	// out of the shuffle
+	const size_t sizes[] = { 1, 3, 130, 1001, CHUNK_SIZE, CHUNK_SIZE + 5 };
+	const size_t elementSizes[] = { 1, 4, 8 };
+	const int numSizes = sizeof(sizes) / sizeof(sizes[0]);
+	const int numElementSizes = sizeof(elementSizes) / sizeof(elementSizes[0]);
+	const int numCases = NUM_PATTERNS * numSizes * numElementSizes;
+
+	bool restored[numCases];
+	bool shrunk[numCases];
+
+	tap.registerNewTests(numCases + 2);
+	tap.begin();
+
+	for (int c = 0; c < numCases; ++c) {
+		const pattern_t pattern = (pattern_t) (c / (numSizes * numElementSizes));
+		const size_t size = sizes[(c / numElementSizes) % numSizes];
+		const size_t elementSize = elementSizes[c % numElementSizes];
+
+		#pragma oss task out(restored[c], shrunk[c])
+		restored[c] = roundTrip(pattern, size, elementSize, shrunk[c]);
+	}
+	#pragma oss taskwait
+
+	for (int c = 0; c < numCases; ++c) {
+		const pattern_t pattern = (pattern_t) (c / (numSizes * numElementSizes));
+		tap.evaluate(restored[c], std::string("Check the round trip of ") + patternNames[pattern]
+			+ " of " + std::to_string(sizes[(c / numElementSizes) % numSizes]) + " bytes with elements of "
+			+ std::to_string(elementSizes[c % numElementSizes]) + " bytes");
+	}
+
+	// Compressible data of the size of a chunk must shrink, while random data
+	// must fall back to be sent verbatim
+	const int largeZeros = (ZEROS * numSizes + 4) * numElementSizes;
+	const int largeRandom = (RANDOM_BYTES * numSizes + 4) * numElementSizes;
+	tap.evaluate(shrunk[largeZeros] && shrunk[largeZeros + 1] && shrunk[largeZeros + 2],
+		"Check that a chunk of zeros is compressed");
+	tap.evaluate(!shrunk[largeRandom],
+		"Check that a chunk of random bytes is not compressed");
+
+	tap.end();
+
+	return 0;
+}
@@ -0,0 +1,182 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+// The compilers give each task type as many symbols as variables appear in its
+// dependency clauses, so the tasks of this test are created through the task
+// creation API to have more symbols than the ones stored inline in the set of
+// symbols of an access
+
+#include <nanos6.h>
+#include <nanos6/debug.h>
+
+#include <cassert>
+
+#include <Atomic.hpp>
+#include "TestAnyProtocolProducer.hpp"
+
+
+#define NUM_SYMBOLS 100
+#define FIRST_HIGH_SYMBOL 64
+#define NUM_TASKS 300
+
+
+TestAnyProtocolProducer tap;
+
+static Atomic<int> errors;
+static long data[NUM_SYMBOLS];
+
+
+struct TaskArgs {
+	long _expected[NUM_SYMBOLS];
+};
+
+struct TaskType {
+	nanos6_task_implementation_info_t _implementation;
+	nanos6_task_info_t _info;
+	int _firstElement;
+};
+
+static nanos6_task_invocation_info_t invocationInfo = { "dep-many-symbols.cpp" };
+
+//! Accesses every element through its own symbol
+static TaskType allSymbolsTask;
+
+//! Accesses only the elements whose symbols are not stored inline
+static TaskType highSymbolsTask;
+
+//! Accesses every element through its own symbol and through the symbol of
+//! the element at the other half, so that the symbols of the duplicated
+//! accesses are merged
+static TaskType aliasedSymbolsTask;
+
+
+static void body(TaskType &type, void *argsBlock)
+{
+	TaskArgs *args = (TaskArgs *) argsBlock;
+	for (int e = type._firstElement; e < NUM_SYMBOLS; ++e) {
+		if (data[e] != args->_expected[e]) {
+			++errors;
+		}
+		++data[e];
+	}
+}
+
+static void allSymbolsBody(void *argsBlock, void *, nanos6_address_translation_entry_t *)
+{
+	body(allSymbolsTask, argsBlock);
+}
+
+static void highSymbolsBody(void *argsBlock, void *, nanos6_address_translation_entry_t *)
+{
+	body(highSymbolsTask, argsBlock);
+}
+
+static void aliasedSymbolsBody(void *argsBlock, void *, nanos6_address_translation_entry_t *)
+{
+	body(aliasedSymbolsTask, argsBlock);
+}
+
+static void registerAccesses(void *handler, int firstSymbol)
+{
+	for (int s = firstSymbol; s < NUM_SYMBOLS; ++s) {
+		nanos6_register_region_readwrite_depinfo1(handler, s, "data", &data[s], sizeof(long), 0, sizeof(long));
+	}
+}
+
+static void registerAllSymbols(void *, void *, void *handler)
+{
+	registerAccesses(handler, 0);
+}
+
+static void registerHighSymbols(void *, void *, void *handler)
+{
+	registerAccesses(handler, FIRST_HIGH_SYMBOL);
+}
+
+static void registerAliasedSymbols(void *, void *, void *handler)
+{
+	registerAccesses(handler, 0);
+	for (int s = 0; s < NUM_SYMBOLS; ++s) {
+		const int element = (s + NUM_SYMBOLS / 2) % NUM_SYMBOLS;
+		nanos6_register_region_readwrite_depinfo1(handler, s, "data", &data[element], sizeof(long), 0, sizeof(long));
+	}
+}
+
+static void initializeTaskType(
+	TaskType &type, char const *label, int firstElement,
+	void (*run)(void *, void *, nanos6_address_translation_entry_t *),
+	void (*registerDepinfo)(void *, void *, void *)
+) {
+	type._firstElement = firstElement;
+
+	type._implementation.device_type_id = nanos6_host_device;
+	type._implementation.run = run;
+	type._implementation.task_label = label;
+	type._implementation.declaration_source = "dep-many-symbols.cpp";
+
+	type._info.num_symbols = NUM_SYMBOLS;
+	type._info.register_depinfo = registerDepinfo;
+	type._info.implementation_count = 1;
+	type._info.implementations = &type._implementation;
+
+	nanos6_register_task_info(&type._info);
+}
+
+//! The task types must be registered before the runtime starts, as the
+//! compilers do
+__attribute__((constructor))
+static void registerTaskTypes()
+{
+	initializeTaskType(allSymbolsTask, "all_symbols", 0, allSymbolsBody, registerAllSymbols);
+	initializeTaskType(highSymbolsTask, "high_symbols", FIRST_HIGH_SYMBOL, highSymbolsBody, registerHighSymbols);
+	initializeTaskType(aliasedSymbolsTask, "aliased_symbols", 0, aliasedSymbolsBody, registerAliasedSymbols);
+}
+
+//! Create a task that expects the current number of updates of its elements
+static void createTask(TaskType &type, long *updates)
+{
+	void *argsBlock = nullptr;
+	void *task = nullptr;
+
+	nanos6_create_task(&type._info, &invocationInfo, sizeof(TaskArgs), &argsBlock, &task, 0, 1);
+
+	TaskArgs *args = (TaskArgs *) argsBlock;
+	for (int e = type._firstElement; e < NUM_SYMBOLS; ++e) {
+		args->_expected[e] = updates[e]++;
+	}
+
+	nanos6_submit_task(task);
+}
+
+
+int main()
+{
+	long updates[NUM_SYMBOLS] = { 0 };
+	TaskType *types[] = { &allSymbolsTask, &highSymbolsTask, &aliasedSymbolsTask };
+
+	errors = 0;
+
+	tap.registerNewTests(2);
+	tap.begin();
+
+	for (int t = 0; t < NUM_TASKS; ++t) {
+		createTask(*types[t % 3], updates);
+	}
+	nanos6_taskwait("dep-many-symbols.cpp");
+
+	tap.evaluate(errors.load() == 0,
+		"Check that the tasks with more than 63 symbols are executed in order");
+
+	bool correct = true;
+	for (int e = 0; e < NUM_SYMBOLS; ++e) {
+		correct = correct && (data[e] == updates[e]);
+	}
+	tap.evaluate(correct, "Check that the final values are correct");
+
+	tap.end();
+
+	return 0;
+}
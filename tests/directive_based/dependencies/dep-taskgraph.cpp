@@ -0,0 +1,214 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+// Records a region of task creation in a task graph and replays it. The task
+// graphs are used through their API, so the tasks are created through the
+// task creation API too
+
+#include <nanos6.h>
+#include <nanos6/taskgraph.h>
+
+#include <string>
+
+#include <Atomic.hpp>
+#include "TestAnyProtocolProducer.hpp"
+#include "Timer.hpp"
+
+
+#define NUM_ELEMENTS 16
+#define CHAIN_LENGTH 8
+#define NUM_CHILDREN 3
+#define NUM_REPETITIONS 4
+
+
+TestAnyProtocolProducer tap;
+
+static Atomic<int> errors;
+static long data[NUM_ELEMENTS];
+
+
+struct TaskArgs {
+	long _element;
+	long _expected;
+	bool _nested;
+};
+
+static nanos6_task_implementation_info_t updateImplementation;
+static nanos6_task_info_t updateInfo;
+static nanos6_task_implementation_info_t childImplementation;
+static nanos6_task_info_t childInfo;
+static nanos6_task_invocation_info_t invocationInfo = { "dep-taskgraph.cpp" };
+
+
+static void createTask(nanos6_task_info_t *info, long element, long expected, bool nested)
+{
+	void *argsBlock = nullptr;
+	void *task = nullptr;
+
+	nanos6_create_task(info, &invocationInfo, sizeof(TaskArgs), &argsBlock, &task, 0, 1);
+
+	TaskArgs *args = (TaskArgs *) argsBlock;
+	args->_element = element;
+	args->_expected = expected;
+	args->_nested = nested;
+
+	nanos6_submit_task(task);
+}
+
+static void checkAndIncrement(TaskArgs *args)
+{
+	if (data[args->_element] != args->_expected) {
+		++errors;
+	}
+	++data[args->_element];
+}
+
+static void updateBody(void *argsBlock, void *, nanos6_address_translation_entry_t *)
+{
+	TaskArgs *args = (TaskArgs *) argsBlock;
+	checkAndIncrement(args);
+
+	// The children update the element after their parent finishes, so the
+	// successor of the parent must wait for them too
+	if (args->_nested) {
+		for (long c = 0; c < NUM_CHILDREN; ++c) {
+			createTask(&childInfo, args->_element, args->_expected + 1 + c, false);
+		}
+	}
+}
+
+static void childBody(void *argsBlock, void *, nanos6_address_translation_entry_t *)
+{
+	// Give the successors of the parent the chance to run too early
+	Timer timer;
+	while (timer.lap() < 200) {
+	}
+
+	checkAndIncrement((TaskArgs *) argsBlock);
+}
+
+static void registerDepinfo(void *argsBlock, void *, void *handler)
+{
+	TaskArgs *args = (TaskArgs *) argsBlock;
+	nanos6_register_region_readwrite_depinfo1(handler, 0, "data",
+		&data[args->_element], sizeof(long), 0, sizeof(long));
+}
+
+static void initializeTaskType(
+	nanos6_task_implementation_info_t &implementation, nanos6_task_info_t &info, char const *label,
+	void (*run)(void *, void *, nanos6_address_translation_entry_t *)
+) {
+	implementation.device_type_id = nanos6_host_device;
+	implementation.run = run;
+	implementation.task_label = label;
+	implementation.declaration_source = "dep-taskgraph.cpp";
+
+	info.num_symbols = 1;
+	info.register_depinfo = registerDepinfo;
+	info.implementation_count = 1;
+	info.implementations = &implementation;
+
+	nanos6_register_task_info(&info);
+}
+
+//! The task types must be registered before the runtime starts, as the
+//! compilers do
+__attribute__((constructor))
+static void registerTaskTypes()
+{
+	initializeTaskType(updateImplementation, updateInfo, "update", updateBody);
+	initializeTaskType(childImplementation, childInfo, "child", childBody);
+}
+
+//! \brief Create the tasks of the region, which update each element along a
+//! chain of tasks. The order of the elements is rotated by the offset
+static void createRegion(long *updates, bool nested, long offset)
+{
+	for (long t = 0; t < CHAIN_LENGTH; ++t) {
+		for (long e = 0; e < NUM_ELEMENTS; ++e) {
+			const long element = (e + offset) % NUM_ELEMENTS;
+			createTask(&updateInfo, element, updates[element], nested);
+			updates[element] += nested ? 1 + NUM_CHILDREN : 1;
+		}
+	}
+}
+
+static bool checkValues(long *updates)
+{
+	for (long e = 0; e < NUM_ELEMENTS; ++e) {
+		if (data[e] != updates[e]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//! \brief Run the region several times with the same graph
+static void runRegions(bool nested)
+{
+	const std::string kind = nested ? " with nested tasks" : "";
+	nanos6_taskgraph_t graph = nanos6_taskgraph_create();
+	long updates[NUM_ELEMENTS] = { 0 };
+
+	int replayed[NUM_REPETITIONS];
+	for (int r = 0; r < NUM_REPETITIONS; ++r) {
+		replayed[r] = nanos6_taskgraph_begin(graph);
+		createRegion(updates, nested, 0);
+		nanos6_taskgraph_end(graph);
+	}
+
+	tap.evaluate(errors.load() == 0 && checkValues(updates),
+		"Check that the recorded and replayed tasks" + kind + " run in order");
+
+	bool replayedAfterRecording = !replayed[0];
+	for (int r = 1; r < NUM_REPETITIONS; ++r) {
+		replayedAfterRecording = replayedAfterRecording && replayed[r];
+	}
+	tap.evaluate(replayedAfterRecording,
+		"Check that the region" + kind + " is recorded once and then replayed");
+
+	// A region whose tasks do not match the recorded ones stops replaying
+	// at the first different task and is recorded again
+	replayed[0] = nanos6_taskgraph_begin(graph);
+	createRegion(updates, nested, 1);
+	nanos6_taskgraph_end(graph);
+
+	replayed[1] = nanos6_taskgraph_begin(graph);
+	createRegion(updates, nested, 1);
+	nanos6_taskgraph_end(graph);
+
+	replayed[2] = nanos6_taskgraph_begin(graph);
+	createRegion(updates, nested, 1);
+	nanos6_taskgraph_end(graph);
+
+	tap.evaluate(errors.load() == 0 && checkValues(updates),
+		"Check that the tasks" + kind + " after a mismatch run in order");
+	tap.evaluate(replayed[0] && !replayed[1] && replayed[2],
+		"Check that the region" + kind + " is recorded again after a mismatch");
+
+	nanos6_taskgraph_destroy(graph);
+}
+
+
+int main()
+{
+	errors = 0;
+
+	tap.registerNewTests(8);
+	tap.begin();
+
+	runRegions(false);
+
+	for (long e = 0; e < NUM_ELEMENTS; ++e) {
+		data[e] = 0;
+	}
+
+	runRegions(true);
+
+	tap.end();
+
+	return 0;
+}
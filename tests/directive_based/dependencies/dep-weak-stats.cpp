@@ -0,0 +1,117 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+// Tasks with weak accesses and no children release them without going through
+// the mailbox of the dependency system, and the stats instrumentation counts
+// those releases. The statistics are only written when the runtime shuts
+// down, so the test runs itself again with the stats instrumentation and
+// reads the report of that execution
+
+#include <nanos6/debug.h>
+
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+#include "TestAnyProtocolProducer.hpp"
+
+
+#define NUM_TASKS 100
+#define FAST_RELEASES_ENTRY "Weak accesses released without propagation"
+
+
+TestAnyProtocolProducer tap;
+
+
+//! \brief Run the tasks whose weak accesses are released without children
+static int runWeakTasks()
+{
+	int data = 0;
+
+	for (int t = 0; t < NUM_TASKS; ++t) {
+		#pragma oss task weakinout(data)
+		{
+		}
+
+		#pragma oss task inout(data)
+		++data;
+	}
+	#pragma oss taskwait
+
+	return (data == NUM_TASKS) ? 0 : 1;
+}
+
+//! \brief Get the number of fast weak releases from a stats report
+//!
+//! \returns the number of releases, or -1 if the report has no such entry
+static long readFastReleases(const std::string &reportFile)
+{
+	std::ifstream report(reportFile.c_str());
+	std::string line;
+
+	while (std::getline(report, line)) {
+		if (line.find(FAST_RELEASES_ENTRY) != std::string::npos) {
+			std::istringstream value(line.substr(line.find_last_of('\t') + 1));
+			long releases = -1;
+			value >> releases;
+			return releases;
+		}
+	}
+	return -1;
+}
+
+
+int main(int argc, char **argv)
+{
+	if (argc > 1 && strcmp(argv[1], "weak-tasks") == 0) {
+		return runWeakTasks();
+	}
+
+	tap.registerNewTests(2);
+	tap.begin();
+
+	char reportFile[] = "/tmp/nanos6-dep-weak-stats-XXXXXX";
+	int fd = mkstemp(reportFile);
+	if (fd == -1) {
+		tap.bailOut("Cannot create the file of the stats report");
+		return 1;
+	}
+	close(fd);
+
+	char executable[PATH_MAX];
+	ssize_t length = readlink("/proc/self/exe", executable, sizeof(executable) - 1);
+	if (length == -1) {
+		tap.bailOut("Cannot find the executable of the test");
+		return 1;
+	}
+	executable[length] = '\0';
+
+	// The execution keeps the dependency implementation and the variant of
+	// this one, and adds the stats instrumentation
+	const char *override = getenv("NANOS6_CONFIG_OVERRIDE");
+	std::string statsOverride = (override != nullptr) ? std::string(override) : std::string();
+	statsOverride += ",version.instrument=stats,instrument.stats.output_file=";
+	statsOverride += reportFile;
+	setenv("NANOS6_CONFIG_OVERRIDE", statsOverride.c_str(), 1);
+
+	std::string command = std::string(executable) + " weak-tasks";
+	int status = system(command.c_str());
+	tap.evaluate(status == 0, "Check that the tasks with weak accesses run with the stats instrumentation");
+
+	long releases = readFastReleases(reportFile);
+	tap.emitDiagnostic("Weak accesses released without propagation: ", releases);
+	tap.evaluate(releases > 0, "Check that the weak accesses without children are released without propagation");
+
+	unlink(reportFile);
+
+	tap.end();
+
+	return 0;
+}
@@ -0,0 +1,99 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <cassert>
+
+#include <Atomic.hpp>
+#include "TestAnyProtocolProducer.hpp"
+
+
+// The bottom map of a parent keeps its first addresses inline and grows its
+// table as more different addresses are accessed by its children
+#define NUM_ADDRESSES 4096
+#define NUM_ROUNDS 8
+#define NUM_PARENTS 4
+
+
+TestAnyProtocolProducer tap;
+
+static Atomic<int> errors;
+
+
+static void checkAndIncrement(int *element, int expected)
+{
+	if (*element != expected) {
+		++errors;
+	}
+	*element = expected + 1;
+}
+
+//! Each round updates every address once, and the odd rounds also read the
+//! neighbour of each address, so every child depends on the previous round
+//! through the bottom map of its parent
+static void createRounds(int *data, int numAddresses)
+{
+	for (int round = 0; round < NUM_ROUNDS; ++round) {
+		for (int i = 0; i < numAddresses; ++i) {
+			int *element = &data[i];
+			if (round % 2 == 0) {
+				#pragma oss task inout(*element)
+				checkAndIncrement(element, round);
+			} else {
+				int *neighbour = &data[(i + 1) % numAddresses];
+				#pragma oss task inout(*element) in(*neighbour)
+				checkAndIncrement(element, round);
+			}
+		}
+	}
+}
+
+static bool checkFinalValues(int *data, int numAddresses)
+{
+	for (int i = 0; i < numAddresses; ++i) {
+		if (data[i] != NUM_ROUNDS) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+int main()
+{
+	int *data = new int[NUM_ADDRESSES * NUM_PARENTS]();
+	errors = 0;
+
+	tap.registerNewTests(4);
+	tap.begin();
+
+	// The main task is the parent of all the accesses
+	createRounds(data, NUM_ADDRESSES);
+	#pragma oss taskwait
+
+	tap.evaluate(errors.load() == 0, "Check that the children of the main task are ordered on many addresses");
+	tap.evaluate(checkFinalValues(data, NUM_ADDRESSES), "Check that the final values of the main task children are correct");
+
+	for (int i = 0; i < NUM_ADDRESSES; ++i) {
+		data[i] = 0;
+	}
+
+	// Several parents with weak accesses grow their own bottom maps concurrently
+	for (int p = 0; p < NUM_PARENTS; ++p) {
+		int *parentData = &data[p * NUM_ADDRESSES];
+		#pragma oss task weakinout(parentData[0;NUM_ADDRESSES])
+		createRounds(parentData, NUM_ADDRESSES);
+	}
+	#pragma oss taskwait
+
+	tap.evaluate(errors.load() == 0, "Check that the children of concurrent parents are ordered on many addresses");
+	tap.evaluate(checkFinalValues(data, NUM_ADDRESSES * NUM_PARENTS), "Check that the final values of the nested children are correct");
+
+	delete [] data;
+
+	tap.end();
+
+	return 0;
+}
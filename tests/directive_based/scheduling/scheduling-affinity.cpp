@@ -0,0 +1,221 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+// The affinity hints are attached between the creation and the submission of
+// a task, so the tasks of this test are created through the task creation API
+
+#include <nanos6.h>
+#include <nanos6/affinity.h>
+#include <nanos6/debug.h>
+
+#include <map>
+#include <vector>
+
+#include "TestAnyProtocolProducer.hpp"
+#include "Timer.hpp"
+
+
+#define TASKS_PER_TARGET 20
+
+
+TestAnyProtocolProducer tap;
+
+
+struct TaskArgs {
+	long *_executionCPU;
+};
+
+static nanos6_task_implementation_info_t implementation;
+static nanos6_task_info_t info;
+static nanos6_task_invocation_info_t invocationInfo = { "scheduling-affinity.cpp" };
+
+
+static void body(void *argsBlock, void *, nanos6_address_translation_entry_t *)
+{
+	TaskArgs *args = (TaskArgs *) argsBlock;
+
+	// Keep the CPU busy for a while, so that the tasks are spread among the
+	// CPUs if their hints are ignored
+	Timer timer;
+	timer.start();
+	while (timer.lap() < 100) {
+	}
+
+	*args->_executionCPU = nanos6_get_current_system_cpu();
+}
+
+//! The task type must be registered before the runtime starts, as the
+//! compilers do
+__attribute__((constructor))
+static void registerTaskType()
+{
+	implementation.device_type_id = nanos6_host_device;
+	implementation.run = body;
+	implementation.task_label = "affinity";
+	implementation.declaration_source = "scheduling-affinity.cpp";
+
+	info.implementation_count = 1;
+	info.implementations = &implementation;
+
+	nanos6_register_task_info(&info);
+}
+
+//! \returns whether the hint has been applied
+static bool createTask(nanos6_affinity_t const &affinity, long *executionCPU)
+{
+	void *argsBlock = nullptr;
+	void *task = nullptr;
+
+	nanos6_create_task(&info, &invocationInfo, sizeof(TaskArgs), &argsBlock, &task, 0, 0);
+
+	TaskArgs *args = (TaskArgs *) argsBlock;
+	args->_executionCPU = executionCPU;
+	*executionCPU = -1;
+
+	const bool applied = nanos6_set_task_affinity(task, &affinity);
+
+	nanos6_submit_task(task);
+
+	return applied;
+}
+
+static nanos6_affinity_t getAffinity(nanos6_affinity_target_t target, nanos6_affinity_mode_t mode, size_t index)
+{
+	nanos6_affinity_t affinity;
+	affinity.target = target;
+	affinity.mode = mode;
+	affinity.index = index;
+	affinity.address = nullptr;
+	return affinity;
+}
+
+static void waitForStatus(long cpu, nanos6_cpu_status_t status)
+{
+	while (nanos6_get_cpu_status(cpu) != status) {
+		nanos6_wait_for(100);
+	}
+}
+
+
+int main()
+{
+	// System CPU identifiers and NUMA node of each CPU
+	std::vector<long> cpus;
+	std::map<long, long> numaOfCPU;
+	std::map<long, bool> numaNodes;
+
+	for (void *it = nanos6_cpus_begin(); it != nanos6_cpus_end(); it = nanos6_cpus_advance(it)) {
+		cpus.push_back(nanos6_cpus_get(it));
+		numaOfCPU[nanos6_cpus_get(it)] = nanos6_cpus_get_numa(it);
+		numaNodes[nanos6_cpus_get_numa(it)] = true;
+	}
+
+	const size_t numCPUs = cpus.size();
+	const size_t numNUMANodes = numaNodes.size();
+	const bool canDisable = (numCPUs > 1 && !nanos6_is_dlb_enabled());
+
+	tap.registerNewTests(4 + (canDisable ? 1 : 0));
+	tap.begin();
+
+	// Strict tasks to each CPU. The other CPUs are idle when the tasks are
+	// submitted, so the target CPUs must be resumed for them
+	std::vector<long> executionCPUs(numCPUs * TASKS_PER_TARGET);
+	bool applied = true;
+	for (size_t t = 0; t < executionCPUs.size(); ++t) {
+		const nanos6_affinity_t affinity = getAffinity(nanos6_affinity_cpu, nanos6_affinity_strict, cpus[t % numCPUs]);
+		applied = createTask(affinity, &executionCPUs[t]) && applied;
+	}
+	nanos6_taskwait("scheduling-affinity.cpp");
+
+	bool correct = applied;
+	for (size_t t = 0; t < executionCPUs.size(); ++t) {
+		if (executionCPUs[t] != cpus[t % numCPUs]) {
+			tap.emitDiagnostic("Task with strict affinity to CPU ", cpus[t % numCPUs], " ran in CPU ", executionCPUs[t]);
+			correct = false;
+		}
+	}
+	tap.evaluate(correct, "Check that the strict tasks run in their CPU");
+
+	// Strict tasks to each NUMA node
+	std::vector<long> nodes;
+	for (std::map<long, bool>::const_iterator it = numaNodes.begin(); it != numaNodes.end(); ++it) {
+		nodes.push_back(it->first);
+	}
+
+	executionCPUs.assign(numNUMANodes * TASKS_PER_TARGET, -1);
+	applied = true;
+	for (size_t t = 0; t < executionCPUs.size(); ++t) {
+		const nanos6_affinity_t affinity = getAffinity(nanos6_affinity_numa_node, nanos6_affinity_strict, nodes[t % numNUMANodes]);
+		applied = createTask(affinity, &executionCPUs[t]) && applied;
+	}
+	nanos6_taskwait("scheduling-affinity.cpp");
+
+	correct = applied;
+	for (size_t t = 0; t < executionCPUs.size(); ++t) {
+		if (numaOfCPU[executionCPUs[t]] != nodes[t % numNUMANodes]) {
+			tap.emitDiagnostic("Task with strict affinity to NUMA node ", nodes[t % numNUMANodes], " ran in CPU ", executionCPUs[t]);
+			correct = false;
+		}
+	}
+	tap.evaluate(correct, "Check that the strict tasks run in a CPU of their NUMA node");
+
+	// Preferred tasks to each CPU, which may be spilled to other CPUs
+	executionCPUs.assign(numCPUs * TASKS_PER_TARGET, -1);
+	size_t inTarget = 0;
+	for (size_t t = 0; t < executionCPUs.size(); ++t) {
+		const nanos6_affinity_t affinity = getAffinity(nanos6_affinity_cpu, nanos6_affinity_preferred, cpus[t % numCPUs]);
+		createTask(affinity, &executionCPUs[t]);
+	}
+	nanos6_taskwait("scheduling-affinity.cpp");
+
+	correct = true;
+	for (size_t t = 0; t < executionCPUs.size(); ++t) {
+		correct = correct && (executionCPUs[t] >= 0);
+		inTarget += (executionCPUs[t] == cpus[t % numCPUs]) ? 1 : 0;
+	}
+	tap.emitDiagnostic("Preferred tasks run in their CPU: ", inTarget, " of ", executionCPUs.size());
+	tap.evaluate(correct, "Check that the preferred tasks are executed");
+
+	// Targets that are not available to the runtime are ignored
+	long unknownCPU = 0;
+	while (numaOfCPU.find(unknownCPU) != numaOfCPU.end()) {
+		++unknownCPU;
+	}
+	void *argsBlock = nullptr;
+	void *task = nullptr;
+	long executionCPU = -1;
+	nanos6_create_task(&info, &invocationInfo, sizeof(TaskArgs), &argsBlock, &task, 0, 0);
+	((TaskArgs *) argsBlock)->_executionCPU = &executionCPU;
+	const nanos6_affinity_t unknown = getAffinity(nanos6_affinity_cpu, nanos6_affinity_strict, unknownCPU);
+	tap.evaluate(nanos6_set_task_affinity(task, &unknown) == 0, "Check that the hints to unknown CPUs are ignored");
+	nanos6_submit_task(task);
+	nanos6_taskwait("scheduling-affinity.cpp");
+
+	// A strict task whose CPU is disabled when it becomes ready goes to the
+	// shared ready queue instead of waiting for its CPU forever
+	if (canDisable) {
+		const long currentCPU = nanos6_get_current_system_cpu();
+		const long disabledCPU = (cpus[0] != currentCPU) ? cpus[0] : cpus[1];
+
+		nanos6_disable_cpu(disabledCPU);
+		waitForStatus(disabledCPU, nanos6_disabled_cpu);
+
+		const nanos6_affinity_t affinity = getAffinity(nanos6_affinity_cpu, nanos6_affinity_strict, disabledCPU);
+		executionCPU = -1;
+		createTask(affinity, &executionCPU);
+		nanos6_taskwait("scheduling-affinity.cpp");
+
+		tap.evaluate(executionCPU >= 0 && executionCPU != disabledCPU,
+			"Check that a strict task to a disabled CPU runs in another CPU");
+
+		nanos6_enable_cpu(disabledCPU);
+		waitForStatus(disabledCPU, nanos6_enabled_cpu);
+	}
+
+	tap.end();
+
+	return 0;
+}
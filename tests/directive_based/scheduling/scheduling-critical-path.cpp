@@ -0,0 +1,104 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+// A long chain of tasks competes with many short chains, and the tasks of the
+// long chain get a higher look-ahead rank than the tails of the short chains,
+// so it should finish first. This test runs with the critical path priority
+// and without the immediate successor, which would bypass the priorities
+
+#include <nanos6/debug.h>
+
+#include <vector>
+
+#include <Atomic.hpp>
+#include "TestAnyProtocolProducer.hpp"
+#include "Timer.hpp"
+
+
+#define LONG_CHAIN_LENGTH 8
+#define SHORT_CHAINS_PER_CPU (4 * LONG_CHAIN_LENGTH)
+
+
+TestAnyProtocolProducer tap;
+
+static Atomic<bool> created;
+static Atomic<long> ticket;
+
+
+static void run(long &executionTicket, long &chain)
+{
+	executionTicket = ticket++;
+	++chain;
+
+	Timer timer;
+	while (timer.lap() < 200) {
+	}
+}
+
+
+int main()
+{
+	const long numCPUs = nanos6_get_num_cpus();
+	const long numShortChains = SHORT_CHAINS_PER_CPU * numCPUs;
+
+	long longChain = 0;
+	std::vector<long> shortChains(numShortChains, 0);
+	std::vector<long> longTickets(LONG_CHAIN_LENGTH, -1);
+	std::vector<long> headTickets(numShortChains, -1);
+	std::vector<long> tailTickets(numShortChains, -1);
+	long *shortChain = shortChains.data();
+	long *headTicket = headTickets.data();
+	long *tailTicket = tailTickets.data();
+	int gate = 0;
+
+	created = false;
+	ticket = 0;
+
+	tap.registerNewTests(2);
+	tap.begin();
+
+	// The heads of the chains wait for this task, so they become ready once
+	// all the tasks are created and their ranks know their successors
+	#pragma oss task out(gate)
+	while (!created.load()) {
+	}
+
+	for (long t = 0; t < LONG_CHAIN_LENGTH; ++t) {
+		long *longTicket = &longTickets[t];
+		#pragma oss task in(gate) inout(longChain)
+		run(*longTicket, longChain);
+	}
+
+	for (long c = 0; c < numShortChains; ++c) {
+		#pragma oss task in(gate) inout(shortChain[c])
+		run(headTicket[c], shortChain[c]);
+
+		#pragma oss task inout(shortChain[c])
+		run(tailTicket[c], shortChain[c]);
+	}
+
+	created = true;
+	#pragma oss taskwait
+
+	bool executed = (longChain == LONG_CHAIN_LENGTH);
+	long lastTail = -1;
+	for (long c = 0; c < numShortChains; ++c) {
+		executed = executed && (shortChain[c] == 2);
+		lastTail = (tailTicket[c] > lastTail) ? tailTicket[c] : lastTail;
+	}
+	tap.evaluate(executed, "Check that all the chains are executed");
+
+	// The last task of the long chain has no successor, so it has the same
+	// rank as the tails of the short chains. The task before it must run
+	// before the tails are exhausted
+	tap.emitDiagnostic("Long chain ticket: ", longTickets[LONG_CHAIN_LENGTH - 2], ", last short chain tail ticket: ", lastTail);
+	tap.evaluate(longTickets[LONG_CHAIN_LENGTH - 2] < lastTail,
+		"Check that the long chain runs ahead of the tails of the short chains");
+
+	tap.end();
+
+	return 0;
+}
@@ -0,0 +1,85 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <nanos6/debug.h>
+#include <nanos6/runtime-info.h>
+
+#include <cassert>
+
+#include <Atomic.hpp>
+#include "TestAnyProtocolProducer.hpp"
+
+
+#define NUM_TASKS 10000
+#define CHAIN_LENGTH 1000
+
+
+TestAnyProtocolProducer tap;
+
+static Atomic<int> executed;
+static int chainElement;
+
+
+int main()
+{
+	nanos6_scheduler_stats_t before, after;
+
+	tap.registerNewTests(6);
+	tap.begin();
+
+	nanos6_get_scheduler_stats(&before);
+
+	// Independent tasks created faster than they are run, so that they pile up
+	// in the ready queue
+	for (int t = 0; t < NUM_TASKS; ++t) {
+		#pragma oss task
+		++executed;
+	}
+
+	// A chain of tasks, where each one releases the next one as its immediate
+	// successor
+	for (int t = 0; t < CHAIN_LENGTH; ++t) {
+		#pragma oss task inout(chainElement)
+		++chainElement;
+	}
+	#pragma oss taskwait
+
+	nanos6_get_scheduler_stats(&after);
+
+	tap.evaluate(executed.load() == NUM_TASKS && chainElement == CHAIN_LENGTH,
+		"Check that all the tasks are executed");
+
+	const unsigned long scheduled = after.scheduled_tasks - before.scheduled_tasks;
+	const unsigned long hits = after.immediate_successor_hits - before.immediate_successor_hits;
+	tap.emitDiagnostic("Scheduled tasks: ", scheduled, ", immediate successor hits: ", hits);
+
+	tap.evaluate(scheduled >= NUM_TASKS + CHAIN_LENGTH,
+		"Check that every task is counted as scheduled");
+
+	// The counters are added up while other CPUs may be updating them, so only
+	// the relations that hold at any time are checked
+	tap.evaluate(after.lock_requests >= before.lock_requests
+		&& after.server_turns >= before.server_turns
+		&& after.lock_wait_time >= before.lock_wait_time
+		&& after.lock_hold_time >= before.lock_hold_time
+		&& after.ready_queue_samples >= before.ready_queue_samples,
+		"Check that the counters never decrease");
+
+	tap.evaluate(after.immediate_successor_hits <= after.scheduled_tasks,
+		"Check that the immediate successor hits are a subset of the scheduled tasks");
+
+	tap.evaluate(after.ready_queue_depth_max == 0
+		|| after.ready_queue_depth_sum >= after.ready_queue_depth_max,
+		"Check that the maximum ready queue depth is one of the samples");
+
+	tap.evaluateWeak(hits > 0,
+		"Check that the chain of tasks is run through immediate successors",
+		"The immediate successor can be disabled or stolen by another CPU");
+
+	tap.end();
+
+	return 0;
+}
@@ -0,0 +1,121 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+#include <nanos6/debug.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+
+#include <Atomic.hpp>
+#include "TestAnyProtocolProducer.hpp"
+
+
+// The deques of the work-stealing scheduler start with 1024 slots, so a
+// single creator makes them grow several times
+#define NUM_TASKS 20000
+#define NUM_CREATOR_TASKS 2000
+#define NESTED_CHILDREN 4
+
+
+TestAnyProtocolProducer tap;
+
+static Atomic<int> *executions;
+
+
+static bool checkExecutions(int numTasks)
+{
+	bool correct = true;
+	for (int t = 0; t < numTasks; ++t) {
+		if (executions[t].load() != 1) {
+			tap.emitDiagnostic("Task ", t, " was executed ", executions[t].load(), " times");
+			correct = false;
+			break;
+		}
+	}
+
+	for (int t = 0; t < numTasks; ++t) {
+		executions[t] = 0;
+	}
+	return correct;
+}
+
+
+int main()
+{
+	const int numCPUs = nanos6_get_num_cpus();
+	const int numCreators = std::max(numCPUs, 2);
+	const int numNestedTasks = numCreators * NUM_CREATOR_TASKS * NESTED_CHILDREN;
+	const int maxTasks = std::max(NUM_TASKS, numNestedTasks);
+
+	executions = new Atomic<int>[maxTasks];
+	for (int t = 0; t < maxTasks; ++t) {
+		executions[t] = 0;
+	}
+
+	tap.registerNewTests(3);
+	tap.begin();
+
+	// Phase 1: a single creator pushes all the tasks to its own deque, and the
+	// rest of CPUs can only run them by stealing
+	#pragma oss task
+	{
+		for (int t = 0; t < NUM_TASKS; ++t) {
+			#pragma oss task
+			++executions[t];
+		}
+		#pragma oss taskwait
+	}
+	#pragma oss taskwait
+
+	tap.evaluate(checkExecutions(NUM_TASKS),
+		"Check that every task of a single creator is executed exactly once");
+
+	// Phase 2: many creators push and pop their own deques while the idle CPUs
+	// steal from all of them
+	for (int c = 0; c < numCreators; ++c) {
+		#pragma oss task
+		{
+			const int first = c * NUM_CREATOR_TASKS;
+			for (int t = first; t < first + NUM_CREATOR_TASKS; ++t) {
+				#pragma oss task
+				++executions[t];
+			}
+		}
+	}
+	#pragma oss taskwait
+
+	tap.evaluate(checkExecutions(numCreators * NUM_CREATOR_TASKS),
+		"Check that every task of many concurrent creators is executed exactly once");
+
+	// Phase 3: the stolen tasks push their children to the deques of the CPUs
+	// that stole them
+	for (int c = 0; c < numCreators; ++c) {
+		#pragma oss task
+		{
+			const int first = c * NUM_CREATOR_TASKS;
+			for (int t = first; t < first + NUM_CREATOR_TASKS; ++t) {
+				#pragma oss task
+				{
+					for (int n = 0; n < NESTED_CHILDREN; ++n) {
+						#pragma oss task
+						++executions[t * NESTED_CHILDREN + n];
+					}
+				}
+			}
+		}
+	}
+	#pragma oss taskwait
+
+	tap.evaluate(checkExecutions(numNestedTasks),
+		"Check that every nested task created by a stolen task is executed exactly once");
+
+	delete [] executions;
+
+	tap.end();
+
+	return 0;
+}
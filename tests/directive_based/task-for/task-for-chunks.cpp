@@ -0,0 +1,167 @@
+/*
+	This file is part of Nanos6 and is licensed under the terms contained in the COPYING file.
+
+	Copyright (C) 2020 Barcelona Supercomputing Center (BSC)
+*/
+
+// The same loop is run with the static, guided and adaptive chunk schedules,
+// which are chosen through the taskfor.schedule option by the name of the
+// test, with all the CPUs in a single taskfor group. The static and guided
+// chunks only depend on the iterations and the CPUs, so they are checked
+// against the schedule. The adaptive schedule splits the loop in many more
+// chunks than the 448 that the taskfors used to support
+
+#include <nanos6/debug.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <Atomic.hpp>
+#include "TestAnyProtocolProducer.hpp"
+
+
+#define NUM_ITERATIONS (200 * 1024)
+#define MAX_CHUNKS_BEFORE (448)
+#define NUM_REPETITIONS (4)
+
+
+TestAnyProtocolProducer tap;
+
+static Atomic<int> executions[NUM_ITERATIONS];
+
+// Virtual CPU that ran each iteration, and the number of iterations that the
+// CPU had run before it
+static long executionCPU[NUM_ITERATIONS];
+static long executionOrder[NUM_ITERATIONS];
+
+
+static void work(long iteration)
+{
+	// Make the iterations take some time, so that the adaptive chunks are
+	// much smaller than the loop
+	volatile long value = 0;
+	for (long i = 0; i < 200; ++i) {
+		value += i * iteration;
+	}
+}
+
+//! \brief Check whether an iteration starts a chunk that was run
+//!
+//! The consecutive chunks run in a row by the same CPU cannot be told apart,
+//! so only some of the chunks are found
+static bool startsObservedChunk(long iteration)
+{
+	return iteration == 0
+		|| executionCPU[iteration] != executionCPU[iteration - 1]
+		|| executionOrder[iteration] != executionOrder[iteration - 1] + 1;
+}
+
+//! \returns a lower bound of the number of chunks
+static long countChunks()
+{
+	long chunks = 0;
+	for (long i = 0; i < NUM_ITERATIONS; ++i) {
+		if (startsObservedChunk(i)) {
+			++chunks;
+		}
+	}
+	return chunks;
+}
+
+#ifndef EXPECT_MANY_CHUNKS
+//! \brief Mark the first iteration of each chunk of the schedule
+static void markChunkStarts(long numCPUs, std::vector<bool> &chunkStarts)
+{
+#ifdef EXPECT_GUIDED_CHUNKS
+	// Each chunk is the remaining iterations split between twice the CPUs,
+	// so the chunks shrink as the loop advances
+	long start = 0;
+	while (start < NUM_ITERATIONS) {
+		chunkStarts[start] = true;
+		const long remaining = NUM_ITERATIONS - start;
+		start += (remaining + 2 * numCPUs - 1) / (2 * numCPUs);
+	}
+#else
+	// The loop is split in chunks of the same size, one per CPU, which are
+	// multiples of the chunksize of the loop
+	const long chunksize = std::max(NUM_ITERATIONS / numCPUs, 1L);
+	for (long start = 0; start < NUM_ITERATIONS; start += chunksize) {
+		chunkStarts[start] = true;
+	}
+#endif
+}
+#endif
+
+
+int main()
+{
+	const long numCPUs = nanos6_get_total_num_cpus();
+	std::vector<Atomic<long> > iterationsPerCPU(numCPUs);
+
+#ifdef EXPECT_MANY_CHUNKS
+	tap.registerNewTests(NUM_REPETITIONS + 1);
+#else
+	std::vector<bool> chunkStarts(NUM_ITERATIONS, false);
+	markChunkStarts(numCPUs, chunkStarts);
+
+	tap.registerNewTests(2 * NUM_REPETITIONS);
+#endif
+	tap.begin();
+
+	long maxChunks = 0;
+	for (int repetition = 0; repetition < NUM_REPETITIONS; ++repetition) {
+		for (long i = 0; i < NUM_ITERATIONS; ++i) {
+			executions[i] = 0;
+		}
+		for (long c = 0; c < numCPUs; ++c) {
+			iterationsPerCPU[c] = 0;
+		}
+
+		#pragma oss task for chunksize(1)
+		for (long i = 0; i < NUM_ITERATIONS; ++i) {
+			const long cpu = nanos6_get_current_virtual_cpu();
+			executionCPU[i] = cpu;
+			executionOrder[i] = iterationsPerCPU[cpu]++;
+
+			work(i);
+			++executions[i];
+		}
+		#pragma oss taskwait
+
+		bool correct = true;
+		for (long i = 0; i < NUM_ITERATIONS; ++i) {
+			if (executions[i].load() != 1) {
+				tap.emitDiagnostic("Iteration ", i, " was run ", executions[i].load(), " times");
+				correct = false;
+				break;
+			}
+		}
+		tap.evaluate(correct, "Check that every iteration of the taskfor runs exactly once");
+
+		const long chunks = countChunks();
+		tap.emitDiagnostic("At least ", chunks, " chunks in repetition ", repetition);
+		maxChunks = (chunks > maxChunks) ? chunks : maxChunks;
+
+#ifndef EXPECT_MANY_CHUNKS
+		bool followsSchedule = true;
+		for (long i = 0; i < NUM_ITERATIONS; ++i) {
+			if (startsObservedChunk(i) && !chunkStarts[i]) {
+				tap.emitDiagnostic("A chunk starts at iteration ", i, ", which the schedule does not");
+				followsSchedule = false;
+				break;
+			}
+		}
+		tap.evaluate(followsSchedule, "Check that the chunks follow the schedule");
+#endif
+	}
+
+#ifdef EXPECT_MANY_CHUNKS
+	tap.evaluateWeak(maxChunks > MAX_CHUNKS_BEFORE,
+		"Check that the loop is split in more than 448 chunks",
+		"Only a lower bound of the chunks is known, and the chunk sizes depend on the speed of the CPUs");
+#endif
+
+	tap.end();
+
+	return 0;
+}
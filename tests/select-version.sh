@@ -21,6 +21,28 @@ if [[ "${*}" == *"fibonacci"* ]] || [[ "${*}" == *"task-for-nqueens"* ]] || [[ "
 	export NANOS6_CONFIG_OVERRIDE="${NANOS6_CONFIG_OVERRIDE},scheduler.policy=lifo"
 fi
 
+# Use the work-stealing host scheduler for its specific tests
+if [[ "${*}" == *"work-stealing"* ]]; then
+	export NANOS6_CONFIG_OVERRIDE="${NANOS6_CONFIG_OVERRIDE},scheduler.work_stealing=true"
+fi
+
+# Use the look-ahead rank as priority for its specific tests, without the
+# immediate successor, which bypasses the priorities
+if [[ "${*}" == *"critical-path"* ]]; then
+	export NANOS6_CONFIG_OVERRIDE="${NANOS6_CONFIG_OVERRIDE},scheduler.critical_path_priority=true,scheduler.immediate_successor=false"
+fi
+
+# Use the guided and adaptive taskfor chunk schedules for their specific tests,
+# with all the CPUs in one taskfor group so that the chunks are predictable
+if [[ "${*}" == *"task-for-"*"chunks"* ]]; then
+	export NANOS6_CONFIG_OVERRIDE="${NANOS6_CONFIG_OVERRIDE},taskfor.groups=1"
+fi
+if [[ "${*}" == *"task-for-guided"* ]]; then
+	export NANOS6_CONFIG_OVERRIDE="${NANOS6_CONFIG_OVERRIDE},taskfor.schedule=guided"
+elif [[ "${*}" == *"task-for-adaptive"* ]]; then
+	export NANOS6_CONFIG_OVERRIDE="${NANOS6_CONFIG_OVERRIDE},taskfor.schedule=adaptive"
+fi
+
 # Enable DLB for dlb-specific tests
 if [[ "${*}" == *"dlb-"* ]]; then
 	export NANOS6_CONFIG_OVERRIDE="${NANOS6_CONFIG_OVERRIDE},dlb.enabled=true"